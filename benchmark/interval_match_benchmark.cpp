@@ -0,0 +1,144 @@
+// Benchmark of the match set generation of XCSR
+//   Compares the linear scan (Condition::matches for every classifier), IntervalMatcher, and
+//   SpatialMatchIndex over the population size N, the number of dimensions L, and the expected
+//   fraction of the classifiers matching a situation (the generality of the conditions).
+//   IntervalMatcher is measured with the bounds in double, float, and 16-bit levels (the latter two
+//   including the check of the candidates by Condition::matches as in Population::match).
+//   Usage: xcspp_interval_match_benchmark [QUERIES]
+#include <xcspp/xcspp.hpp>
+#include <chrono>
+#include <cmath> // std::pow
+#include <iostream>
+#include <iomanip>
+#include <algorithm> // std::remove_if
+#include <random>
+#include <string>
+#include <vector>
+#include <cstddef> // std::size_t
+
+using namespace xcspp;
+
+namespace
+{
+    // Returns a condition (CSR) which matches about the given fraction of the situations
+    xcsr::Condition RandomCondition(std::size_t length, double matchedFraction, std::mt19937 & engine)
+    {
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        const double width = std::pow(matchedFraction, 1.0 / length);
+        std::vector<xcsr::Symbol> symbols;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            const double lower = dist(engine) * (1.0 - width);
+            symbols.emplace_back(lower + width / 2, width / 2);
+        }
+        return xcsr::Condition(symbols);
+    }
+
+    std::vector<double> RandomSituation(std::size_t length, std::mt19937 & engine)
+    {
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        std::vector<double> situation;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            situation.push_back(dist(engine));
+        }
+        return situation;
+    }
+
+    // Returns the average time per query in microseconds
+    template <typename Func>
+    double MeasureMicroseconds(const std::vector<std::vector<double>> & situations, Func func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto & situation : situations)
+        {
+            func(situation);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / situations.size();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t queryCount = (argc > 1) ? std::stoul(argv[1]) : 2000;
+
+    std::cout << "N,L,fraction,matched,linear[us],interval[us],interval-float[us],interval-uint16[us],spatial-index[us]\n";
+    std::cout << std::fixed;
+
+    std::mt19937 engine(1);
+    for (const std::size_t n : { 1000, 4000, 16000 })
+    {
+        for (const std::size_t length : { 1, 2, 3, 4, 6, 8, 12, 30, 60, 100 })
+        {
+            for (const double matchedFraction : { 0.01, 0.05, 0.2 })
+            {
+                const auto repr = xcsr::XCSRRepr::kCSR;
+                std::vector<xcsr::Condition> conditions;
+                xcsr::IntervalMatcher matcher;
+                xcsr::IntervalMatcher floatMatcher(xcsr::XCSRPrecision::kFloat);
+                xcsr::IntervalMatcher levelMatcher(xcsr::XCSRPrecision::kUInt16);
+                xcsr::SpatialMatchIndex index;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    conditions.push_back(RandomCondition(length, matchedFraction, engine));
+                    matcher.insert(i, conditions.back(), repr);
+                    floatMatcher.insert(i, conditions.back(), repr);
+                    levelMatcher.insert(i, conditions.back(), repr);
+                    index.insert(i, conditions.back(), repr);
+                }
+
+                std::vector<std::vector<double>> situations;
+                for (std::size_t i = 0; i < queryCount; ++i)
+                {
+                    situations.push_back(RandomSituation(length, engine));
+                }
+
+                std::vector<std::size_t> matchedColumns;
+                std::size_t matchedCount = 0;
+                for (const auto & situation : situations)
+                {
+                    matcher.match(situation, matchedColumns);
+                    matchedCount += matchedColumns.size();
+                }
+
+                const double linearTime = MeasureMicroseconds(situations, [&](const std::vector<double> & situation) {
+                    matchedColumns.clear();
+                    for (std::size_t i = 0; i < conditions.size(); ++i)
+                    {
+                        if (conditions[i].matches(situation, repr))
+                        {
+                            matchedColumns.push_back(i);
+                        }
+                    }
+                });
+                const double intervalTime = MeasureMicroseconds(situations, [&](const std::vector<double> & situation) {
+                    matcher.match(situation, matchedColumns);
+                });
+                const auto reducedMatch = [&](const xcsr::IntervalMatcher & reducedMatcher, const std::vector<double> & situation) {
+                    reducedMatcher.match(situation, matchedColumns);
+                    matchedColumns.erase(
+                        std::remove_if(matchedColumns.begin(), matchedColumns.end(), [&](std::size_t i) {
+                            return !conditions[i].matches(situation, repr);
+                        }),
+                        matchedColumns.end());
+                };
+                const double floatTime = MeasureMicroseconds(situations, [&](const std::vector<double> & situation) {
+                    reducedMatch(floatMatcher, situation);
+                });
+                const double levelTime = MeasureMicroseconds(situations, [&](const std::vector<double> & situation) {
+                    reducedMatch(levelMatcher, situation);
+                });
+                const double spatialIndexTime = MeasureMicroseconds(situations, [&](const std::vector<double> & situation) {
+                    index.match(situation, matchedColumns);
+                });
+
+                std::cout << n << ',' << length << ',' << std::setprecision(2) << matchedFraction << ','
+                    << std::setprecision(1) << static_cast<double>(matchedCount) / queryCount << ','
+                    << std::setprecision(3) << linearTime << ',' << intervalTime << ',' << floatTime << ',' << levelTime << ',' << spatialIndexTime << std::endl;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+// Benchmark of the match set generation engines
+//   Compares the linear scan (Condition::matches for every classifier), BitSlicedMatcher, and
+//   InvertedMatchIndex over the population size N, the condition length L, and the probability
+//   of "#" in the conditions (average generality).
+//   Usage: xcspp_match_benchmark [QUERIES]
+#include <xcspp/xcspp.hpp>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstddef> // std::size_t
+
+using namespace xcspp;
+
+namespace
+{
+    xcs::Condition RandomCondition(std::size_t length, double dontCareProbability, std::mt19937 & engine)
+    {
+        std::bernoulli_distribution dontCareDist(dontCareProbability);
+        std::uniform_int_distribution<int> valueDist(0, 1);
+        std::vector<xcs::Symbol> symbols;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            symbols.push_back(dontCareDist(engine) ? xcs::Symbol() : xcs::Symbol(valueDist(engine)));
+        }
+        return xcs::Condition(symbols);
+    }
+
+    std::vector<int> RandomSituation(std::size_t length, std::mt19937 & engine)
+    {
+        std::uniform_int_distribution<int> dist(0, 1);
+        std::vector<int> situation;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            situation.push_back(dist(engine));
+        }
+        return situation;
+    }
+
+    // Returns the average time per query in microseconds
+    template <typename Func>
+    double MeasureMicroseconds(const std::vector<xcs::PackedSituation> & situations, Func func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto & situation : situations)
+        {
+            func(situation);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / situations.size();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t queryCount = (argc > 1) ? std::stoul(argv[1]) : 2000;
+
+    std::cout << "N,L,P#,matched,candidates,linear[us],bit-sliced[us],inverted-index[us]\n";
+    std::cout << std::fixed << std::setprecision(3);
+
+    std::mt19937 engine(1);
+    for (const std::size_t n : { 1000, 4000, 16000 })
+    {
+        for (const std::size_t length : { 11, 20, 37, 70, 135 })
+        {
+            for (const double dontCareProbability : { 0.1, 0.33, 0.5, 0.67, 0.9 })
+            {
+                std::vector<xcs::Condition> conditions;
+                xcs::BitSlicedMatcher matcher;
+                xcs::InvertedMatchIndex index;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    conditions.push_back(RandomCondition(length, dontCareProbability, engine));
+                    matcher.insert(i, conditions.back());
+                    index.insert(i, conditions.back());
+                }
+
+                std::vector<xcs::PackedSituation> situations;
+                for (std::size_t i = 0; i < queryCount; ++i)
+                {
+                    situations.emplace_back(RandomSituation(length, engine));
+                }
+
+                std::vector<std::size_t> matchedColumns;
+                std::size_t matchedCount = 0;
+                std::size_t candidateCount = 0;
+                for (const auto & situation : situations)
+                {
+                    index.match(situation, matchedColumns);
+                    matchedCount += matchedColumns.size();
+                    candidateCount += index.candidateCount(situation);
+                }
+
+                const double linearTime = MeasureMicroseconds(situations, [&](const xcs::PackedSituation & situation) {
+                    matchedColumns.clear();
+                    for (std::size_t i = 0; i < conditions.size(); ++i)
+                    {
+                        if (conditions[i].matches(situation))
+                        {
+                            matchedColumns.push_back(i);
+                        }
+                    }
+                });
+                const double bitSlicedTime = MeasureMicroseconds(situations, [&](const xcs::PackedSituation & situation) {
+                    matcher.match(situation, matchedColumns);
+                });
+                const double invertedIndexTime = MeasureMicroseconds(situations, [&](const xcs::PackedSituation & situation) {
+                    index.match(situation, matchedColumns);
+                });
+
+                std::cout << n << ',' << length << ',' << std::setprecision(2) << dontCareProbability << ','
+                    << std::setprecision(1) << static_cast<double>(matchedCount) / queryCount << ','
+                    << static_cast<double>(candidateCount) / queryCount << ','
+                    << std::setprecision(3) << linearTime << ',' << bitSlicedTime << ',' << invertedIndexTime << std::endl;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,196 @@
+// Benchmark of the representation dispatch of XCSR
+//   Compares the subsumption test (IS MORE GENERAL) and the matching of XCSR conditions with the
+//   bounds calculated by the runtime representation for each symbol (GetLowerBound(s, repr)) and
+//   with the loops specialized for each representation (Condition::isMoreGeneral/matches).
+//   The subsumption test is also measured with the containment kernel on normalized bounds
+//   (a batch of rows against one condition as in the GA subsumption, and normalized bounds
+//   against the symbols of each condition as in the action set subsumption).
+//   Usage: xcspp_repr_dispatch_benchmark [REPEATS]
+#include <xcspp/xcspp.hpp>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <numeric> // std::iota
+#include <random>
+#include <string>
+#include <vector>
+#include <cstddef> // std::size_t
+
+using namespace xcspp;
+
+namespace
+{
+    xcsr::Condition RandomCondition(std::size_t length, xcsr::XCSRRepr repr, std::mt19937 & engine)
+    {
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        std::vector<xcsr::Symbol> symbols;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            // Wide intervals, so that the loops do not stop early too often
+            const double lower = dist(engine) * 0.05;
+            const double upper = 1.0 - dist(engine) * 0.05;
+            switch (repr)
+            {
+            case xcsr::XCSRRepr::kCSR:
+                symbols.emplace_back((lower + upper) / 2, (upper - lower) / 2);
+                break;
+
+            case xcsr::XCSRRepr::kOBR:
+                symbols.emplace_back(lower, upper);
+                break;
+
+            case xcsr::XCSRRepr::kUBR:
+                symbols.emplace_back(upper, lower);
+                break;
+            }
+        }
+        return xcsr::Condition(symbols);
+    }
+
+    // IS MORE GENERAL with the branch on the representation for each symbol
+    bool IsMoreGeneralByRuntimeRepr(const xcsr::Condition & self, const xcsr::Condition & cond, xcsr::XCSRRepr repr)
+    {
+        std::size_t equalCount = 0;
+        for (std::size_t i = 0; i < self.size(); ++i)
+        {
+            const double otherL = xcsr::GetLowerBound(cond[i], repr);
+            const double otherU = xcsr::GetUpperBound(cond[i], repr);
+            const double selfL = xcsr::GetLowerBound(self[i], repr);
+            const double selfU = xcsr::GetUpperBound(self[i], repr);
+            if (otherL < selfL || selfU < otherU)
+            {
+                return false;
+            }
+            if (otherL == selfL && selfU == otherU)
+            {
+                ++equalCount;
+            }
+        }
+        return equalCount != self.size();
+    }
+
+    // DOES MATCH with the branch on the representation for each symbol
+    bool MatchesByRuntimeRepr(const xcsr::Condition & self, const std::vector<double> & situation, xcsr::XCSRRepr repr)
+    {
+        for (std::size_t i = 0; i < self.size(); ++i)
+        {
+            if (!self[i].matches(situation[i], repr))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Returns the average time per call in nanoseconds
+    template <typename Func>
+    double MeasureNanoseconds(std::size_t callCount, Func func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / callCount;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t repeatCount = (argc > 1) ? std::stoul(argv[1]) : 200;
+    constexpr std::size_t kConditionCount = 1000;
+
+    std::cout << "L,repr,more-general-runtime[ns],more-general-specialized[ns],more-general-rows[ns],more-general-symbols[ns],matches-runtime[ns],matches-specialized[ns]\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::mt19937 engine(1);
+    std::size_t count = 0;
+    for (const std::size_t length : { 6, 30, 60, 100 })
+    {
+        for (const auto repr : { xcsr::XCSRRepr::kCSR, xcsr::XCSRRepr::kOBR, xcsr::XCSRRepr::kUBR })
+        {
+            std::vector<xcsr::Condition> conditions;
+            for (std::size_t i = 0; i < kConditionCount; ++i)
+            {
+                conditions.push_back(RandomCondition(length, repr, engine));
+            }
+            const std::vector<double> situation(length, 0.5);
+
+            std::vector<double> lowerBounds(kConditionCount * length), upperBounds(kConditionCount * length);
+            for (std::size_t i = 0; i < kConditionCount; ++i)
+            {
+                xcsr::GetConditionBounds(conditions[i], repr, lowerBounds.data() + i * length, upperBounds.data() + i * length);
+            }
+            std::vector<std::size_t> rows(kConditionCount);
+
+            // The results are accumulated so that the calls are not removed by the optimizer
+            const std::size_t callCount = repeatCount * kConditionCount;
+            const double moreGeneralRuntimeTime = MeasureNanoseconds(callCount, [&] {
+                for (std::size_t r = 0; r < repeatCount; ++r)
+                {
+                    for (const auto & condition : conditions)
+                    {
+                        count += IsMoreGeneralByRuntimeRepr(conditions[r % kConditionCount], condition, repr);
+                    }
+                }
+            });
+            const double moreGeneralSpecializedTime = MeasureNanoseconds(callCount, [&] {
+                for (std::size_t r = 0; r < repeatCount; ++r)
+                {
+                    for (const auto & condition : conditions)
+                    {
+                        count += conditions[r % kConditionCount].isMoreGeneral(condition, repr);
+                    }
+                }
+            });
+            const double moreGeneralRowsTime = MeasureNanoseconds(callCount, [&] {
+                for (std::size_t r = 0; r < repeatCount; ++r)
+                {
+                    // (Which of the conditions are more general than the condition r)
+                    const std::size_t other = r % kConditionCount;
+                    rows.resize(kConditionCount);
+                    std::iota(rows.begin(), rows.end(), 0);
+                    xcsr::KeepMoreGeneralRows(lowerBounds.data(), upperBounds.data(), lowerBounds.data() + other * length, upperBounds.data() + other * length, length, rows);
+                    count += rows.size();
+                }
+            });
+            const double moreGeneralSymbolsTime = MeasureNanoseconds(callCount, [&] {
+                xcsr::VisitXCSRRepr(repr, [&](auto reprConstant) {
+                    for (std::size_t r = 0; r < repeatCount; ++r)
+                    {
+                        const std::size_t self = r % kConditionCount;
+                        for (const auto & condition : conditions)
+                        {
+                            count += xcsr::IsMoreGeneral<decltype(reprConstant)::value>(lowerBounds.data() + self * length, upperBounds.data() + self * length, condition);
+                        }
+                    }
+                });
+            });
+            const double matchesRuntimeTime = MeasureNanoseconds(callCount, [&] {
+                for (std::size_t r = 0; r < repeatCount; ++r)
+                {
+                    for (const auto & condition : conditions)
+                    {
+                        count += MatchesByRuntimeRepr(condition, situation, repr);
+                    }
+                }
+            });
+            const double matchesSpecializedTime = MeasureNanoseconds(callCount, [&] {
+                for (std::size_t r = 0; r < repeatCount; ++r)
+                {
+                    for (const auto & condition : conditions)
+                    {
+                        count += condition.matches(situation, repr);
+                    }
+                }
+            });
+
+            const char *reprName = (repr == xcsr::XCSRRepr::kCSR) ? "csr" : (repr == xcsr::XCSRRepr::kOBR) ? "obr" : "ubr";
+            std::cout << length << ',' << reprName << ','
+                << moreGeneralRuntimeTime << ',' << moreGeneralSpecializedTime << ','
+                << moreGeneralRowsTime << ',' << moreGeneralSymbolsTime << ','
+                << matchesRuntimeTime << ',' << matchesSpecializedTime << std::endl;
+        }
+    }
+    std::cerr << "(checksum: " << count << ")" << std::endl;
+
+    return 0;
+}
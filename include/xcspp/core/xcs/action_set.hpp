@@ -1,9 +1,10 @@
 #pragma once
 #include <vector>
 #include <unordered_set>
+#include <cstddef> // std::size_t
 #include <cstdint>
 
-#include "classifier_ptr_set.hpp"
+#include "classifier_handle_set.hpp"
 #include "population.hpp"
 #include "match_set.hpp"
 #include "ga.hpp"
@@ -13,10 +14,63 @@
 namespace xcspp::xcs
 {
 
-    class ActionSet : public ClassifierPtrSet
+    class ActionSet : public ClassifierHandleSet
     {
+    public:
+        // Aggregates over the classifiers in [A]
+        struct NicheStatistics
+        {
+            std::uint64_t numerositySum = 0;
+
+            // Sum of numerosity * timeStamp
+            std::uint64_t timeStampSum = 0;
+
+            double fitnessSum = 0.0;
+
+            // Sum of accuracy * numerosity
+            double accuracySum = 0.0;
+        };
+
     private:
-        // UPDATE FITNESS
+        // Working buffers of doSubsumption() and runGA() (kept to avoid the allocations in every step)
+        std::vector<ClassifierHandle> m_removedClassifiers;
+        GA::Buffers m_gaBuffers;
+
+        // Members of the classifiers in [A] gathered from [P] for update()
+        //   The update is calculated over these contiguous arrays, and the results are written back to [P].
+        struct UpdateBuffers
+        {
+            std::vector<double> predictions;
+            std::vector<double> epsilons;
+            std::vector<double> actionSetSizes;
+            std::vector<double> experiences;
+            std::vector<double> numerosities;
+            std::vector<double> fitnesses;
+            std::vector<double> accuracies;
+            std::vector<double> powerBases;
+
+            void resize(std::size_t size);
+
+            void reserve(std::size_t capacity);
+        };
+        UpdateBuffers m_updateBuffers;
+
+        // Niche statistics made in the pass of update() that gathers [A]
+        //   They are kept up to date by the action set subsumption and reused by runGA(), and are
+        //   invalidated when the set is regenerated or the GA changes [P].
+        NicheStatistics m_nicheStatistics;
+        bool m_hasNicheStatistics;
+
+        // Calculate the niche statistics in one pass over [A]
+        void calculateNicheStatistics(const Population & population);
+
+        // UPDATE PREDICTION, PREDICTION ERROR AND ACTION SET SIZE ESTIMATE (over m_updateBuffers)
+        void updateParameters(double p, double numerositySum);
+
+        // Calculate the accuracies (over m_updateBuffers)
+        void updateAccuracies();
+
+        // UPDATE FITNESS (over m_updateBuffers; also sets the accuracy sum of the niche statistics)
         void updateFitness();
 
         // DO ACTION SET SUBSUMPTION
@@ -26,21 +80,36 @@ namespace xcspp::xcs
         // Constructor
         ActionSet(const XCSParams *pParams, const std::unordered_set<int> & availableActions);
 
-        ActionSet(const MatchSet & matchSet, int action, const XCSParams *pParams, const std::unordered_set<int> & availableActions);
+        ActionSet(const MatchSet & matchSet, int action, const Population & population, const XCSParams *pParams, const std::unordered_set<int> & availableActions);
 
         // Destructor
         virtual ~ActionSet() = default;
 
         // GENERATE ACTION SET
-        void generateSet(const MatchSet & matchSet, int action);
+        void generateSet(const MatchSet & matchSet, int action, const Population & population);
 
         void copyTo(ActionSet & dest);
 
+        // Allocate the memory for the given number of classifiers in advance
+        void reserve(std::size_t capacity);
+
         // RUN GA (refer to GA::Run() for the latter part)
         void runGA(const std::vector<int> & situation, Population & population, std::uint64_t timeStamp, Random & random);
 
         // UPDATE SET
+        //   (The members removed from [P] since the set was generated are dropped first.)
         void update(double p, Population & population);
+
+        // Niche statistics after the last update() (valid until the set is regenerated or the GA is run)
+        const NicheStatistics & nicheStatistics() const noexcept
+        {
+            return m_nicheStatistics;
+        }
+
+        bool hasNicheStatistics() const noexcept
+        {
+            return m_hasNicheStatistics;
+        }
     };
 
 }
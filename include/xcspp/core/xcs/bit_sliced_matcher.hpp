@@ -0,0 +1,90 @@
+#pragma once
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+
+#include "condition.hpp"
+
+namespace xcspp::xcs
+{
+
+    // Matching engine which keeps the conditions of [P] transposed by bit position
+    //   For each input position, a bit-vector over all classifiers tells which of them reject the
+    //   input value 0 or 1 at the position. The match set is obtained by OR-ing the bit-vectors
+    //   selected by the situation, so that 512 classifiers are tested at once (AVX-512, AVX2, or
+    //   portable 64-bit operations depending on the build).
+    //   Each classifier is identified by a column index given by the caller (the slot index in [P]).
+    class BitSlicedMatcher
+    {
+    public:
+        // The number of classifiers (columns) processed together
+        static constexpr std::size_t kBlockBits = 512;
+        static constexpr std::size_t kBlockWords = kBlockBits / 64;
+
+    private:
+        // Condition length L (all conditions must have the same length)
+        std::size_t m_conditionLength;
+
+        // Reject masks
+        //   m_rejectWords[((block * L + position) * 2 + v) * kBlockWords + w] has 1 in the bit of
+        //   the column whose condition rejects the input value v (0 or 1) at the position
+        std::vector<std::uint64_t> m_rejectWords;
+
+        // Bit-sliced columns in use (m_liveWords[block * kBlockWords + w])
+        std::vector<std::uint64_t> m_liveWords;
+
+        // Columns in use whose conditions cannot be bit-sliced (i.e., non-binary conditions)
+        std::vector<std::size_t> m_unslicedColumns;
+
+        // The number of columns in use
+        std::size_t m_size;
+
+        // Word offsets of the reject masks selected by the current situation (scratch buffer)
+        mutable std::vector<std::uint32_t> m_selectedOffsets;
+
+        void reset(std::size_t conditionLength);
+
+    public:
+        // Constructor
+        BitSlicedMatcher();
+
+        // Destructor
+        ~BitSlicedMatcher() = default;
+
+        // Add a condition to the unused column
+        void insert(std::size_t column, const Condition & condition);
+
+        // Remove the condition of the column
+        void erase(std::size_t column);
+
+        void clear();
+
+        // Allocate the memory for the columns [0, columnCount) of conditions of the given length in advance
+        void reserve(std::size_t columnCount, std::size_t conditionLength);
+
+        // Collect the columns of the bit-sliced conditions that match the situation in ascending order
+        // (The conditions listed in unslicedColumns() are not tested here.)
+        void match(const PackedSituation & situation, std::vector<std::size_t> & matchedColumns) const;
+
+        const std::vector<std::size_t> & unslicedColumns() const noexcept
+        {
+            return m_unslicedColumns;
+        }
+
+        std::size_t conditionLength() const noexcept
+        {
+            return m_conditionLength;
+        }
+
+        auto empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        auto size() const noexcept
+        {
+            return m_size;
+        }
+    };
+
+}
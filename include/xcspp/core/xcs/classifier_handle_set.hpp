@@ -0,0 +1,121 @@
+#pragma once
+#include <vector>
+#include <unordered_set>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+
+#include "population.hpp"
+#include "xcs_params.hpp"
+
+namespace xcspp::xcs
+{
+
+    // Set of classifiers in [P] (used for [M], [A] and [A]_-1)
+    //   The members are held as handles in insertion order, and the membership of each slot is kept
+    //   in a dense array indexed by slot, so that count() takes constant time and copying the set
+    //   costs only the members. A member removed from [P] while the set is alive becomes stale, and
+    //   removeStaleHandles() drops it.
+    class ClassifierHandleSet
+    {
+    private:
+        // Generation of the member in the slot plus one (zero if the slot is not in the set)
+        std::vector<std::uint32_t> m_memberTags;
+
+    protected:
+        // Members (modify only through pushBack(), assign(), erase() and clear() to keep m_memberTags)
+        std::vector<ClassifierHandle> m_set;
+        const XCSParams * const m_pParams;
+        const std::unordered_set<int> m_availableActions;
+
+        // Add the handle to the end (an older member in the same slot, which is stale, is replaced)
+        void pushBack(const ClassifierHandle & handle);
+
+        // Replace the members with the handles in the range
+        template <typename InputIterator>
+        void assign(InputIterator first, InputIterator last)
+        {
+            clear();
+            for (auto it = first; it != last; ++it)
+            {
+                pushBack(*it);
+            }
+        }
+
+    public:
+        // Constructor
+        ClassifierHandleSet(const XCSParams *pParams, const std::unordered_set<int> & availableActions);
+
+        // Destructor
+        virtual ~ClassifierHandleSet() = default;
+
+        // Remove the members that are no longer in [P]
+        void removeStaleHandles(const Population & population);
+
+        const std::unordered_set<int> & availableActions() const noexcept
+        {
+            return m_availableActions;
+        }
+
+        // --- The functions below are just the wrapper for std::vector<ClassifierHandle> ---
+
+        auto empty() const noexcept
+        {
+            return m_set.empty();
+        }
+
+        auto size() const noexcept
+        {
+            return m_set.size();
+        }
+
+        auto begin() const noexcept
+        {
+            return m_set.begin();
+        }
+
+        auto end() const noexcept
+        {
+            return m_set.end();
+        }
+
+        auto cbegin() const noexcept
+        {
+            return m_set.cbegin();
+        }
+
+        auto cend() const noexcept
+        {
+            return m_set.cend();
+        }
+
+        // Add the handle if it is not a member yet
+        void insert(const ClassifierHandle & handle)
+        {
+            if (count(handle) == 0)
+            {
+                pushBack(handle);
+            }
+        }
+
+        void erase(const ClassifierHandle & handle);
+
+        void clear() noexcept
+        {
+            for (const auto & handle : m_set)
+            {
+                m_memberTags[handle.index] = 0;
+            }
+            m_set.clear();
+        }
+
+        // Allocate the memory for the given number of classifiers in advance
+        // (The membership array is also made for the slots of [P] up to the same number.)
+        void reserve(std::size_t capacity);
+
+        std::size_t count(const ClassifierHandle & handle) const noexcept
+        {
+            return (handle.index < m_memberTags.size() && m_memberTags[handle.index] == handle.generation + 1) ? 1 : 0;
+        }
+    };
+
+}
@@ -1,22 +1,144 @@
 #pragma once
 #include <ostream> // operator<<
+#include <iterator> // std::bidirectional_iterator_tag, std::reverse_iterator
 #include <string>
 #include <vector>
-#include <cstddef> // std::size_t
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <cstdint> // std::uint64_t
 
 #include "symbol.hpp"
 
 namespace xcspp::xcs
 {
 
+    // Situation converted into bit-packed words for word-parallel matching
+    //   (Prepare this once per situation and pass it to Condition::matches().)
+    class PackedSituation
+    {
+    private:
+        std::vector<int> m_values;
+
+        // Interleaved words of the situation
+        //   [2w]:   1 if the value is 1
+        //   [2w+1]: 1 if the value is neither 0 nor 1
+        std::vector<std::uint64_t> m_words;
+
+    public:
+        // Constructor
+        PackedSituation() = default;
+
+        explicit PackedSituation(const std::vector<int> & situation);
+
+        // Destructor
+        ~PackedSituation() = default;
+
+        // Replace the situation (reuses the allocated buffers)
+        void assign(const std::vector<int> & situation);
+
+        const std::vector<int> & values() const noexcept
+        {
+            return m_values;
+        }
+
+        const std::vector<std::uint64_t> & words() const noexcept
+        {
+            return m_words;
+        }
+
+        auto size() const noexcept
+        {
+            return m_values.size();
+        }
+    };
+
     class Condition
     {
+    public:
+        static constexpr std::size_t kBitsPerWord = 64;
+
+        // Iterator which yields symbols by value
+        class ConstIterator
+        {
+        private:
+            const Condition *m_pCondition;
+            std::size_t m_idx;
+
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = Symbol;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = Symbol;
+
+            ConstIterator(const Condition *pCondition, std::size_t idx) : m_pCondition(pCondition), m_idx(idx) {}
+
+            Symbol operator* () const
+            {
+                return (*m_pCondition)[m_idx];
+            }
+
+            ConstIterator & operator++ ()
+            {
+                ++m_idx;
+                return *this;
+            }
+
+            ConstIterator operator++ (int)
+            {
+                const ConstIterator ret = *this;
+                ++m_idx;
+                return ret;
+            }
+
+            ConstIterator & operator-- ()
+            {
+                --m_idx;
+                return *this;
+            }
+
+            ConstIterator operator-- (int)
+            {
+                const ConstIterator ret = *this;
+                --m_idx;
+                return ret;
+            }
+
+            friend bool operator== (const ConstIterator & lhs, const ConstIterator & rhs)
+            {
+                return lhs.m_pCondition == rhs.m_pCondition && lhs.m_idx == rhs.m_idx;
+            }
+
+            friend bool operator!= (const ConstIterator & lhs, const ConstIterator & rhs)
+            {
+                return !(lhs == rhs);
+            }
+        };
+
     private:
+        std::size_t m_size;
+
+        // Bit-packed ternary representation (used while all specified values are 0 or 1)
+        //   [2w]:   care-mask (1 if the symbol is specified, 0 if "#")
+        //   [2w+1]: value-mask (1 if the specified value is 1, always 0 for "#")
+        std::vector<std::uint64_t> m_bits;
+
+        // Symbol-wise representation for non-binary alphabets
+        // (empty while the condition is bit-packed)
         std::vector<Symbol> m_symbols;
 
+        bool m_isPacked;
+
+        // Hash of the symbols (XOR of the hashes of the specified symbols at each position)
+        //   It is updated incrementally by the functions that modify the symbols.
+        std::uint64_t m_hash;
+
+        void pushBack(const Symbol & symbol);
+
+        void unpack();
+
     public:
         // Constructor
-        Condition() = default;
+        Condition();
 
         Condition(const std::vector<Symbol> & symbols);
 
@@ -24,122 +146,125 @@ namespace xcspp::xcs
 
         explicit Condition(const std::string & symbols);
 
+        Condition(const Condition &) = default;
+
+        Condition(Condition &&) noexcept = default;
+
         // Destructor
         ~Condition() = default;
 
+        Condition & operator=(const Condition &) = default;
+
+        Condition & operator=(Condition &&) noexcept = default;
+
+        // Replace the symbols (reuses the allocated buffers)
+        void assign(const std::vector<int> & symbols);
+
         std::string toString() const;
 
         // DOES MATCH
         bool matches(const std::vector<int> & situation) const;
 
+        bool matches(const PackedSituation & situation) const;
+
         // IS MORE GENERAL
         bool isMoreGeneral(const Condition & cl) const;
 
         std::size_t dontCareCount() const;
 
-        friend std::ostream & operator<< (std::ostream & os, const Condition & obj);
-
-        // --- The functions below are just the wrapper for std::vector<Symbol> ---
-
-        auto empty() const noexcept
+        // Returns the hash of the symbols (equal conditions have the same hash)
+        std::uint64_t hash() const noexcept
         {
-            return m_symbols.empty();
+            return m_hash;
         }
 
-        auto size() const noexcept
+        // Returns whether the condition uses the bit-packed representation
+        // (false if it contains a value other than 0, 1, or "#")
+        bool isPacked() const noexcept
         {
-            return m_symbols.size();
+            return m_isPacked;
         }
 
-        auto begin() noexcept
-        {
-            return m_symbols.begin();
-        }
+        bool isDontCare(std::size_t idx) const;
 
-        auto begin() const noexcept
-        {
-            return m_symbols.begin();
-        }
+        void setValue(std::size_t idx, int value);
+
+        void setToDontCare(std::size_t idx);
+
+        void setSymbol(std::size_t idx, const Symbol & symbol);
+
+        // Swap the symbol at idx with that of the other condition
+        void swapSymbol(Condition & other, std::size_t idx);
 
-        auto end() noexcept
+        // Swap the symbols in the range [first, last) with those of the other condition
+        void swapSymbols(Condition & other, std::size_t first, std::size_t last);
+
+        // Swap the symbol at offset + i with that of the other condition for each bit i set in the mask
+        // (A whole word of the bit-packed representations is swapped at once if offset is a multiple of
+        // kBitsPerWord. The bits beyond the end are ignored.)
+        void swapMaskedSymbols(Condition & other, std::size_t offset, std::uint64_t mask);
+
+        friend std::ostream & operator<< (std::ostream & os, const Condition & obj);
+
+        friend bool operator== (const Condition & lhs, const Condition & rhs);
+
+        friend bool operator!= (const Condition & lhs, const Condition & rhs);
+
+        // --- The functions below provide read-only access to the symbols ---
+
+        auto empty() const noexcept
         {
-            return m_symbols.end();
+            return m_size == 0;
         }
 
-        auto end() const noexcept
+        auto size() const noexcept
         {
-            return m_symbols.end();
+            return m_size;
         }
 
-        auto rbegin() noexcept
+        auto begin() const noexcept
         {
-            return m_symbols.rbegin();
+            return ConstIterator(this, 0);
         }
 
-        auto rbegin() const noexcept
+        auto end() const noexcept
         {
-            return m_symbols.rbegin();
+            return ConstIterator(this, m_size);
         }
 
-        auto rend() noexcept
+        auto rbegin() const noexcept
         {
-            return m_symbols.rend();
+            return std::reverse_iterator<ConstIterator>(end());
         }
 
         auto rend() const noexcept
         {
-            return m_symbols.rend();
+            return std::reverse_iterator<ConstIterator>(begin());
         }
 
         auto cbegin() const noexcept
         {
-            return m_symbols.cbegin();
+            return begin();
         }
 
         auto cend() const noexcept
         {
-            return m_symbols.cend();
+            return end();
         }
 
         auto crbegin() const noexcept
         {
-            return m_symbols.crbegin();
+            return rbegin();
         }
 
         auto crend() const noexcept
         {
-            return m_symbols.crend();
-        }
-
-        Symbol & operator[] (std::size_t idx)
-        {
-            return m_symbols[idx];
-        }
-
-        const Symbol & operator[] (std::size_t idx) const
-        {
-            return m_symbols[idx];
+            return rend();
         }
 
-        Symbol & at(std::size_t idx)
-        {
-            return m_symbols.at(idx);
-        }
-
-        const Symbol & at(std::size_t idx) const
-        {
-            return m_symbols.at(idx);
-        }
+        Symbol operator[] (std::size_t idx) const;
 
-        friend bool operator== (const Condition & lhs, const Condition & rhs)
-        {
-            return lhs.m_symbols == rhs.m_symbols;
-        }
-
-        friend bool operator!= (const Condition & lhs, const Condition & rhs)
-        {
-            return lhs.m_symbols != rhs.m_symbols;
-        }
+        Symbol at(std::size_t idx) const;
     };
 
 }
@@ -1,12 +1,12 @@
 #pragma once
-#include <memory> // std::shared_ptr, std::make_shared
 #include <vector>
 #include <unordered_set>
+#include <utility> // std::pair
 #include <cstdint> // std::uint64_t
 #include <cstddef> // std::size_t
 
 #include "xcspp/util/random.hpp"
-#include "classifier_ptr_set.hpp"
+#include "classifier_handle_set.hpp"
 #include "population.hpp"
 
 namespace xcspp::xcs
@@ -14,14 +14,35 @@ namespace xcspp::xcs
 
     namespace GA
     {
+        // Working buffers of Run() (kept by the caller to avoid the allocations in every GA invocation)
+        struct Buffers
+        {
+            std::vector<std::size_t> targets;
+            std::vector<std::pair<double, std::uint64_t>> tournamentFitnesses;
+            RouletteWheel<double> rouletteWheel;
+            std::vector<std::size_t> subsumers;
+            Classifier child1{ Condition(), 0, 0.0, 0.0, 0.0, 0 };
+            Classifier child2{ Condition(), 0, 0.0, 0.0, 0.0, 0 };
+
+            // Allocate the memory for the action sets of up to the given number of classifiers in advance
+            void reserve(std::size_t capacity)
+            {
+                targets.reserve(capacity);
+                tournamentFitnesses.reserve(capacity);
+                rouletteWheel.reserve(capacity);
+                subsumers.reserve(capacity);
+            }
+        };
+
         // RUN GA (refer to ActionSet::runGA() for the former part)
         void Run(
-            ClassifierPtrSet & actionSet,
+            const ClassifierHandleSet & actionSet,
             const std::vector<int> & situation,
             Population & population,
             const std::unordered_set<int> & availableActions,
             const XCSParams *pParams,
-            Random & random);
+            Random & random,
+            Buffers & buffers);
     };
 
 }
@@ -0,0 +1,113 @@
+#pragma once
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t, std::uint32_t, std::uint64_t
+
+#include "condition.hpp"
+
+namespace xcspp::xcs
+{
+
+    // Matching engine which keeps posting lists of the conditions of [P] by input position
+    //   The positions are divided into groups of kGroupWidth consecutive positions, and for each
+    //   group the columns are listed by their symbols (0, 1, or "#" at each position) in the group.
+    //   A classifier that matches the situation must be in one of the 2^kGroupWidth lists whose
+    //   symbols agree with the situation in every group, so only the lists of the most selective
+    //   group are visited, and their columns are verified with the word-parallel test of all
+    //   positions. (A group of one position is the plain (position, value) and "#" posting list;
+    //   wider groups prune more since a specified symbol excludes only a half of binary inputs.)
+    //   This is faster than scanning all classifiers when most conditions are specific, since the
+    //   cost grows with the number of candidates instead of the number of classifiers.
+    //   Each classifier is identified by a column index given by the caller (the slot index in [P]).
+    class InvertedMatchIndex
+    {
+    public:
+        // The number of consecutive positions whose symbols form the key of a posting list
+        static constexpr std::size_t kGroupWidth = 6;
+
+    private:
+        // Condition length L (all conditions must have the same length)
+        std::size_t m_conditionLength;
+
+        // The number of position groups (ceil(L / kGroupWidth))
+        std::size_t m_groupCount;
+
+        // The number of interleaved words per column (same layout as the packed Condition)
+        std::size_t m_wordCount;
+
+        // Posting lists (m_postings[group * 3^kGroupWidth + key])
+        //   The key of a column is the sum of d * 3^i over the positions in the group, where d is
+        //   the specified value or 2 for "#", and i is the position in the group.
+        std::vector<std::vector<std::uint32_t>> m_postings;
+
+        // Offsets of each column in its posting lists (m_postingOffsets[column * m_groupCount + group])
+        std::vector<std::uint32_t> m_postingOffsets;
+
+        // Care-masks and value-masks of the columns (m_columnWords[column * m_wordCount + w])
+        std::vector<std::uint64_t> m_columnWords;
+
+        // Whether the column is in the posting lists
+        std::vector<std::uint8_t> m_isIndexed;
+
+        // Columns in use whose conditions cannot be indexed (i.e., non-binary conditions)
+        std::vector<std::size_t> m_unindexedColumns;
+
+        // The number of columns in use
+        std::size_t m_size;
+
+        void reset(std::size_t conditionLength);
+
+        // Returns the key of the column in the posting lists of the group
+        std::size_t postingKey(std::size_t column, std::size_t group) const;
+
+        // Calls func(key) for the keys of the posting lists of the group that agree with the situation
+        template <typename Func>
+        void forEachAgreeingKey(const PackedSituation & situation, std::size_t group, Func func) const;
+
+        // Returns the group whose posting lists for the situation are the shortest
+        std::size_t mostSelectiveGroup(const PackedSituation & situation, std::size_t & candidateCount) const;
+
+    public:
+        // Constructor
+        InvertedMatchIndex();
+
+        // Destructor
+        ~InvertedMatchIndex() = default;
+
+        // Add a condition to the unused column
+        void insert(std::size_t column, const Condition & condition);
+
+        // Remove the condition of the column
+        void erase(std::size_t column);
+
+        void clear();
+
+        // Collect the columns of the indexed conditions that match the situation in ascending order
+        // (The conditions listed in unindexedColumns() are not tested here.)
+        void match(const PackedSituation & situation, std::vector<std::size_t> & matchedColumns) const;
+
+        // The number of candidates visited by match() for the situation
+        std::size_t candidateCount(const PackedSituation & situation) const;
+
+        const std::vector<std::size_t> & unindexedColumns() const noexcept
+        {
+            return m_unindexedColumns;
+        }
+
+        std::size_t conditionLength() const noexcept
+        {
+            return m_conditionLength;
+        }
+
+        auto empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        auto size() const noexcept
+        {
+            return m_size;
+        }
+    };
+
+}
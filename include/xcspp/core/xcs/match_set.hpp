@@ -1,34 +1,88 @@
 ﻿#pragma once
-#include <cstdint> // std::uint64_t
+#include <vector>
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <cstdint> // std::uint8_t, std::uint64_t
 
-#include "classifier_ptr_set.hpp"
+#include "classifier_handle_set.hpp"
+#include "match_set_cache.hpp"
 #include "population.hpp"
 #include "xcs_params.hpp"
+#include "xcspp/util/action_ordinals.hpp"
 #include "xcspp/util/random.hpp"
 
 namespace xcspp::xcs
 {
 
-    class MatchSet : public ClassifierPtrSet
+    class MatchSet : public ClassifierHandleSet
     {
     protected:
         bool m_isCoveringPerformed;
 
+        // Dense ordinals of the available actions
+        const ActionOrdinals m_actionOrdinals;
+
+        // Working buffers of generateSet() (kept to avoid the allocations in every step)
+        PackedSituation m_packedSituation;
+        std::vector<std::size_t> m_matchedIndices;
+        std::vector<std::uint8_t> m_isActionInSet; // indexed by action ordinal
+        std::vector<int> m_unselectedActions;
+        Classifier m_coveringClassifier;
+
+        // Partitions of [M] by action (used if XCSParams::partitionByAction is true)
+        //   m_set[m_partitionBegins[i]], ..., m_set[m_partitionBegins[i + 1] - 1] are the classifiers with the
+        //   action of ordinal i, and the last partition holds the ones whose actions are not available.
+        bool m_isPartitioned;
+        std::vector<std::size_t> m_partitionBegins;
+        std::vector<std::size_t> m_partitionBuffer;
+
+        // Set the classifiers in [P] matching the situation to m_set (grouped by action if m_isPartitioned is true)
+        void collectMatchingClassifiers(const Population & population, const std::vector<int> & situation, MatchSetCache *pCache);
+
     public:
         // Constructor
-        using ClassifierPtrSet::ClassifierPtrSet; // inherits all constructors from ClassifierPtrSet
+        MatchSet(const XCSParams *pParams, const std::unordered_set<int> & availableActions);
 
-        MatchSet(Population & population, const std::vector<int> & situation, std::uint64_t timeStamp, const XCSParams *pParams, const std::unordered_set<int> & availableActions, Random & random);
+        // (Pass pCache to look up the matching classifiers in the cache.)
+        MatchSet(Population & population, const std::vector<int> & situation, std::uint64_t timeStamp, const XCSParams *pParams, const std::unordered_set<int> & availableActions, Random & random, MatchSetCache *pCache = nullptr);
 
         // Destructor
         virtual ~MatchSet() = default;
 
         // GENERATE MATCH SET
-        void generateSet(Population & population, const std::vector<int> & situation, std::uint64_t timeStamp, Random & random);
+        void generateSet(Population & population, const std::vector<int> & situation, std::uint64_t timeStamp, Random & random, MatchSetCache *pCache = nullptr);
+
+        // GENERATE MATCH SET without covering (used in exploitation without update)
+        void generateSetWithoutCovering(const Population & population, const std::vector<int> & situation, MatchSetCache *pCache = nullptr);
+
+        // Allocate the memory for the given number of classifiers in advance
+        void reserve(std::size_t capacity);
 
         // Get if covering is performed in the previous match set generation
         // (Call this function after constructor or generateSet())
         bool isCoveringPerformed() const;
+
+        const ActionOrdinals & actionOrdinals() const noexcept
+        {
+            return m_actionOrdinals;
+        }
+
+        // Whether the classifiers are grouped by action in the previous match set generation
+        // (The partitions are no longer valid once the set is modified by other functions.)
+        bool isPartitioned() const noexcept
+        {
+            return m_isPartitioned;
+        }
+
+        // Range of the classifiers with the action of the ordinal (valid only if isPartitioned() is true)
+        auto partitionBegin(std::size_t ordinal) const noexcept
+        {
+            return m_set.begin() + static_cast<std::ptrdiff_t>(m_partitionBegins[ordinal]);
+        }
+
+        auto partitionEnd(std::size_t ordinal) const noexcept
+        {
+            return m_set.begin() + static_cast<std::ptrdiff_t>(m_partitionBegins[ordinal + 1]);
+        }
     };
 
 }
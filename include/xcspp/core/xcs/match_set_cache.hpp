@@ -0,0 +1,104 @@
+#pragma once
+#include <list>
+#include <vector>
+#include <unordered_map>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+
+#include "condition.hpp"
+#include "population.hpp"
+#include "xcs_params.hpp"
+
+namespace xcspp::xcs
+{
+
+    // Cache of the classifiers in [P] matching each situation
+    //   Each entry remembers the epoch of [P] at which it was valid. If [P] has been modified since
+    //   then, only the slots inserted or removed after the epoch are tested again, so that the entry
+    //   is repaired instead of being regenerated. The least recently used entries are evicted when
+    //   the memory usage exceeds the limit.
+    class MatchSetCache
+    {
+    private:
+        struct SituationHash
+        {
+            std::size_t operator() (const std::vector<int> & situation) const noexcept;
+        };
+
+        struct Entry
+        {
+            // Matched slot indices in ascending order
+            std::vector<std::uint32_t> matchedIndices;
+
+            // Epoch of [P] at which matchedIndices is valid
+            std::uint64_t epoch;
+
+            // Position in m_recentlyUsedSituations
+            std::list<const std::vector<int> *>::iterator recentlyUsedIterator;
+
+            // Estimated memory usage in bytes
+            std::size_t memoryUsage;
+        };
+
+        const XCSParams * const m_pParams;
+
+        std::unordered_map<std::vector<int>, Entry, SituationHash> m_entries;
+
+        // Situations of the entries (front: most recently used)
+        std::list<const std::vector<int> *> m_recentlyUsedSituations;
+
+        std::size_t m_memoryUsage;
+
+        std::uint64_t m_hitCount;
+        std::uint64_t m_missCount;
+
+        static std::size_t EstimateMemoryUsage(const std::vector<int> & situation, const Entry & entry);
+
+        void evictLeastRecentlyUsed();
+
+    public:
+        // Constructor
+        explicit MatchSetCache(const XCSParams *pParams);
+
+        // Destructor
+        ~MatchSetCache() = default;
+
+        // Collect the slot indices of the classifiers that match the situation in ascending order
+        // (The result is the same as Population::match(). Use the cache only for a single [P].)
+        void match(const Population & population, const std::vector<int> & situation, const PackedSituation & packedSituation, std::vector<std::size_t> & matchedIndices);
+
+        void clear();
+
+        // Whether the cache is used (false if XCSParams::matchSetCacheSize is 0)
+        bool isEnabled() const noexcept
+        {
+            return m_pParams->matchSetCacheSize > 0;
+        }
+
+        std::uint64_t hitCount() const noexcept
+        {
+            return m_hitCount;
+        }
+
+        std::uint64_t missCount() const noexcept
+        {
+            return m_missCount;
+        }
+
+        std::size_t memoryUsage() const noexcept
+        {
+            return m_memoryUsage;
+        }
+
+        auto empty() const noexcept
+        {
+            return m_entries.empty();
+        }
+
+        auto size() const noexcept
+        {
+            return m_entries.size();
+        }
+    };
+
+}
@@ -1,24 +1,441 @@
 #pragma once
-#include "classifier_ptr_set.hpp"
+#include <iosfwd> // std::istream, std::ostream
+#include <iterator> // std::forward_iterator_tag
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <cstddef> // std::size_t, std::ptrdiff_t
+#include <cstdint> // std::uint8_t, std::uint32_t, std::uint64_t
+
+#include "classifier.hpp"
+#include "deletion_wheel.hpp"
+#include "subsumption_index.hpp"
+#include "bit_sliced_matcher.hpp"
+#include "inverted_match_index.hpp"
+#include "xcs_params.hpp"
+#include "xcspp/util/action_ordinals.hpp"
+#include "xcspp/util/page_allocator.hpp"
 #include "xcspp/util/random.hpp"
 
 namespace xcspp::xcs
 {
 
-    class Population : public ClassifierPtrSet
+    // Handle of a classifier in [P]
+    //   The index (slot) does not change while the classifier is in [P]. The generation tells
+    //   whether the slot has been reused by another classifier since the handle was taken.
+    struct ClassifierHandle
+    {
+        std::uint32_t index;
+        std::uint32_t generation;
+
+        friend bool operator== (const ClassifierHandle & lhs, const ClassifierHandle & rhs)
+        {
+            return lhs.index == rhs.index && lhs.generation == rhs.generation;
+        }
+
+        friend bool operator!= (const ClassifierHandle & lhs, const ClassifierHandle & rhs)
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+    // [P] stored as a structure of arrays
+    //   The members of the classifiers are kept in parallel arrays indexed by slot. Released slots
+    //   are zero-filled and reused through a free list, so the index of a classifier is stable and
+    //   the iteration order (ascending slot index) is deterministic.
+    class Population
     {
+    public:
+        // Iterator which yields the classifiers in the occupied slots
+        class ConstIterator
+        {
+        private:
+            const Population *m_pPopulation;
+            std::size_t m_idx;
+
+            void skipEmptySlots()
+            {
+                while (m_idx < m_pPopulation->slotCount() && !m_pPopulation->isOccupied(m_idx))
+                {
+                    ++m_idx;
+                }
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = ConstClassifierRef;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = ConstClassifierRef;
+
+            ConstIterator(const Population *pPopulation, std::size_t idx) : m_pPopulation(pPopulation), m_idx(idx)
+            {
+                skipEmptySlots();
+            }
+
+            ConstClassifierRef operator* () const
+            {
+                return (*m_pPopulation)[m_idx];
+            }
+
+            // Slot index of the current classifier
+            std::size_t index() const noexcept
+            {
+                return m_idx;
+            }
+
+            ConstIterator & operator++ ()
+            {
+                ++m_idx;
+                skipEmptySlots();
+                return *this;
+            }
+
+            ConstIterator operator++ (int)
+            {
+                const ConstIterator ret = *this;
+                ++(*this);
+                return ret;
+            }
+
+            friend bool operator== (const ConstIterator & lhs, const ConstIterator & rhs)
+            {
+                return lhs.m_pPopulation == rhs.m_pPopulation && lhs.m_idx == rhs.m_idx;
+            }
+
+            friend bool operator!= (const ConstIterator & lhs, const ConstIterator & rhs)
+            {
+                return !(lhs == rhs);
+            }
+        };
+
+    private:
+        // Array of the values of all slots (optionally backed by huge pages)
+        template <typename T>
+        using SlotArray = std::vector<T, PageAllocator<T>>;
+
+        const XCSParams * const m_pParams;
+        const std::unordered_set<int> m_availableActions;
+
+        // Dense ordinals of the available actions
+        const ActionOrdinals m_actionOrdinals;
+
+        // Members of the classifiers (indexed by slot)
+        SlotArray<Condition> m_conditions;
+        SlotArray<int> m_actions;
+        SlotArray<double> m_predictions;
+        SlotArray<double> m_epsilons;
+        SlotArray<double> m_fitnesses;
+        SlotArray<std::uint64_t> m_experiences;
+        SlotArray<std::uint64_t> m_timeStamps;
+        SlotArray<double> m_actionSetSizes;
+        SlotArray<std::uint64_t> m_numerosities;
+
+        // Accuracies of the classifiers and the epsilons with which they are calculated (indexed by slot)
+        //   An accuracy is recalculated only when epsilon of the classifier (or epsilonZero, alpha or nu)
+        //   changes. The epsilon of a slot without a valid accuracy is NaN.
+        mutable SlotArray<double> m_accuracies;
+        mutable SlotArray<double> m_accuracyEpsilons;
+        mutable double m_accuracyEpsilonZero;
+        mutable double m_accuracyAlpha;
+        mutable double m_accuracyNu;
+
+        // Invalidate all accuracies if epsilonZero, alpha or nu has been changed since they were calculated
+        void validateAccuracyCache() const;
+
+        // Action ordinals of the classifiers (indexed by slot; m_actionOrdinals.size() for the actions that are not available)
+        SlotArray<std::uint32_t> m_slotActionOrdinals;
+
+        // Slot states
+        SlotArray<std::uint8_t> m_isOccupied;
+        SlotArray<std::uint32_t> m_generations;
+        std::vector<std::uint32_t> m_freeSlots;
+
+        // The number of classifiers (macro-classifiers) in [P]
+        std::size_t m_size;
+
+        // Hash table of the pairs of condition and action (used to find the classifier with the same
+        // condition and action)
+        //   The occupied slots are chained by bucket: m_bucketHeads[hash % bucket count] is the first slot
+        //   of the bucket and m_nextSlotsInBucket[idx] is the next one. The links are kept in the slot
+        //   arrays, so that inserting and erasing a classifier do not allocate memory.
+        SlotArray<std::uint64_t> m_hashes;
+        SlotArray<std::uint32_t> m_nextSlotsInBucket;
+        std::vector<std::uint32_t> m_bucketHeads;
+
+        void linkToBucket(std::size_t idx);
+
+        void unlinkFromBucket(std::size_t idx);
+
+        // Make the number of buckets a power of two not less than the slot count and relink the slots
+        void rehash(std::size_t slotCount);
+
+        // Modification history for the match set cache
+        //   m_epoch is incremented on every insertion and removal, and m_changedSlots[i] is the slot
+        //   modified when the epoch changed from (m_changeLogFirstEpoch + i).
+        std::uint64_t m_epoch;
+        std::uint64_t m_changeLogFirstEpoch;
+        std::vector<std::uint32_t> m_changedSlots;
+
+        void recordChange(std::size_t idx);
+
+        // Reserve the slots for a new classifier by XCSParams::populationChunkSize
+        void reserveSlot();
+
+        // Make free slots up to preallocatedSlotCount() and allocate the memory of the indices for them,
+        // giving the conditions the buffers of the same size as the given one
+        // (used if XCSParams::preallocate is true)
+        void preallocateSlots(const Condition & condition);
+
+        // (If cl is an rvalue, its condition is moved into [P]. A reused slot swaps its condition with that
+        // of cl, so that both keep the buffers.)
+        template <typename ClassifierType>
+        std::size_t insert(ClassifierType && cl, std::uint64_t hash);
+
+        std::size_t find(const ConditionActionPair & cl, std::uint64_t hash) const;
+
+        // Deletion votes of the classifiers for deleteExtraClassifiers()
+        DeletionWheel m_deletionWheel;
+
+        // Classifiers that could subsume others for GA subsumption
+        SubsumptionIndex m_subsumptionIndex;
+
+        // Slots that may have been modified through operator[] since the deletion wheel and the subsumption
+        // index were updated
+        SlotArray<std::uint8_t> m_isModified;
+        std::vector<std::uint32_t> m_modifiedSlots;
+
+        void markModified(std::size_t idx)
+        {
+            if (!m_isModified[idx])
+            {
+                m_isModified[idx] = 1;
+                m_modifiedSlots.push_back(static_cast<std::uint32_t>(idx));
+            }
+        }
+
+        // Push the modified slots into the deletion wheel and the subsumption index
+        void applyModifications();
+
+        // Bit-sliced conditions for match set generation (columns are slot indices)
+        // (used if XCSParams::matchingMethod is kBitSliced)
+        BitSlicedMatcher m_matcher;
+
+        // Posting lists of the conditions for match set generation (columns are slot indices)
+        // (used if XCSParams::matchingMethod is kInvertedIndex)
+        InvertedMatchIndex m_invertedIndex;
+
+        bool usesInvertedIndex() const noexcept
+        {
+            return m_pParams->matchingMethod == XCSParams::MatchingMethod::kInvertedIndex;
+        }
+
     public:
         // Constructor
-        using ClassifierPtrSet::ClassifierPtrSet;
+        Population(const XCSParams *pParams, const std::unordered_set<int> & availableActions);
+
+        Population(const std::vector<Classifier> & initialClassifiers, const XCSParams *pParams, const std::unordered_set<int> & availableActions);
 
         // Destructor
-        virtual ~Population() = default;
+        ~Population() = default;
+
+        void setClassifiers(const std::vector<Classifier> & classifiers);
+
+        void inputCSV(std::istream & is, bool initClassifierVariables = false);
+
+        void outputCSV(std::ostream & os) const;
+
+        bool loadCSVFile(const std::string & filename, bool initClassifierVariables = false);
+
+        bool saveCSVFile(const std::string & filename) const;
+
+        // Add the classifier to a free slot and returns the slot index
+        std::size_t insert(const Classifier & cl);
+
+        // Add the classifier to a free slot by moving its condition and returns the slot index
+        // (The condition of cl is left unspecified, but may keep a buffer to be reused.)
+        std::size_t insert(Classifier && cl);
+
+        // Remove the classifier in the slot
+        void erase(std::size_t idx);
+
+        void clear();
+
+        // Returns the slot index of the classifier with the same condition and action
+        // (slotCount() if there is no such classifier)
+        std::size_t find(const ConditionActionPair & cl) const;
 
         // INSERT IN POPULATION
-        void insertOrIncrementNumerosity(const ClassifierPtr & cl);
+        void insertOrIncrementNumerosity(const Classifier & cl);
+
+        // (The condition of cl is moved into [P] only if cl is added as a new classifier.)
+        void insertOrIncrementNumerosity(Classifier && cl);
 
         // DELETE FROM POPULATION
         bool deleteExtraClassifiers(Random & random);
+
+        // Collect the slot indices of the classifiers that match the situation in ascending order
+        void match(const PackedSituation & situation, std::vector<std::size_t> & matchedIndices) const;
+
+        // Reorder the slot indices so that the classifiers with the same action are contiguous
+        //   The partitions are in ascending order of action ordinal, followed by the partition of the actions
+        //   that are not available, and the order of the slots within each partition is kept. After this,
+        //   partitionBegins[i] and partitionBegins[i + 1] are the range of the partition i in the slot indices.
+        //   (buffer is used as working memory.)
+        void partitionByAction(std::vector<std::size_t> & indices, std::vector<std::size_t> & partitionBegins, std::vector<std::size_t> & buffer) const;
+
+        // COULD SUBSUME
+        bool isSubsumer(std::size_t idx) const;
+
+        // DOES SUBSUME
+        bool subsumes(std::size_t idx, const ConditionActionPair & cl) const;
+
+        // Collect the slot indices of the classifiers that subsume the classifier in ascending order
+        void collectSubsumers(const ConditionActionPair & cl, std::vector<std::size_t> & subsumerIndices);
+
+        // Returns false if the subsumer in the slot idx is not more general than the subsumer in the slot otherIdx
+        // (Both must be subsumers, i.e., isSubsumer() must be true.)
+        bool mayBeMoreGeneral(std::size_t idx, std::size_t otherIdx);
+
+        // Returns the accuracy of the classifier in the slot (cached until its epsilon changes)
+        double accuracy(std::size_t idx) const;
+
+        // Store the accuracy calculated by the caller for the current epsilon of the classifier in the slot
+        // (The value must be the same as accuracy() would calculate, i.e., alpha * FastPow(epsilonZero / epsilon, nu)
+        //  or one if epsilon is less than epsilonZero.)
+        void cacheAccuracy(std::size_t idx, double accuracy);
+
+        // The number of insertions and removals so far (the condition in a slot does not change
+        // while the epoch is the same)
+        std::uint64_t epoch() const noexcept
+        {
+            return m_epoch;
+        }
+
+        // Call func(idx) for the slots modified since the epoch (the same slot may appear more than once)
+        // Returns false without calling func if the history has been discarded.
+        template <typename Func>
+        bool forEachChangedSlotSince(std::uint64_t epoch, Func func) const
+        {
+            if (epoch < m_changeLogFirstEpoch)
+            {
+                return false;
+            }
+            for (std::size_t i = static_cast<std::size_t>(epoch - m_changeLogFirstEpoch); i < m_changedSlots.size(); ++i)
+            {
+                func(static_cast<std::size_t>(m_changedSlots[i]));
+            }
+            return true;
+        }
+
+        const ActionOrdinals & actionOrdinals() const noexcept
+        {
+            return m_actionOrdinals;
+        }
+
+        ClassifierHandle handle(std::size_t idx) const noexcept
+        {
+            return { static_cast<std::uint32_t>(idx), m_generations[idx] };
+        }
+
+        // Returns whether the handle still refers to a classifier in [P]
+        bool contains(const ClassifierHandle & handle) const noexcept
+        {
+            return handle.index < m_isOccupied.size() && m_isOccupied[handle.index] && m_generations[handle.index] == handle.generation;
+        }
+
+        bool isOccupied(std::size_t idx) const noexcept
+        {
+            return m_isOccupied[idx] != 0;
+        }
+
+        // The number of slots (all slot indices are less than this)
+        std::size_t slotCount() const noexcept
+        {
+            return m_isOccupied.size();
+        }
+
+        // The number of slots allocated
+        std::size_t slotCapacity() const noexcept
+        {
+            return m_isOccupied.capacity();
+        }
+
+        ClassifierRef operator[] (std::size_t idx)
+        {
+            markModified(idx);
+            return {
+                m_conditions[idx],
+                m_actions[idx],
+                m_predictions[idx],
+                m_epsilons[idx],
+                m_fitnesses[idx],
+                m_experiences[idx],
+                m_timeStamps[idx],
+                m_actionSetSizes[idx],
+                m_numerosities[idx]
+            };
+        }
+
+        ConstClassifierRef operator[] (std::size_t idx) const
+        {
+            return {
+                m_conditions[idx],
+                m_actions[idx],
+                m_predictions[idx],
+                m_epsilons[idx],
+                m_fitnesses[idx],
+                m_experiences[idx],
+                m_timeStamps[idx],
+                m_actionSetSizes[idx],
+                m_numerosities[idx]
+            };
+        }
+
+        ClassifierRef operator[] (const ClassifierHandle & handle)
+        {
+            return (*this)[handle.index];
+        }
+
+        ConstClassifierRef operator[] (const ClassifierHandle & handle) const
+        {
+            return (*this)[handle.index];
+        }
+
+        auto empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        auto size() const noexcept
+        {
+            return m_size;
+        }
+
+        // The number of slots made in advance if XCSParams::preallocate is true: N + max(2, the number of actions)
+        //   (the most [P] holds during a step, since covering inserts a classifier for each missing action
+        //    before the deletions, and the GA inserts two children before them)
+        std::size_t preallocatedSlotCount() const noexcept;
+
+        auto begin() const noexcept
+        {
+            return ConstIterator(this, 0);
+        }
+
+        auto end() const noexcept
+        {
+            return ConstIterator(this, slotCount());
+        }
+
+        auto cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        auto cend() const noexcept
+        {
+            return end();
+        }
     };
 
 }
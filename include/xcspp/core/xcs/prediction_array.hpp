@@ -1,9 +1,12 @@
 #pragma once
+#include <unordered_set>
 #include <vector>
-#include <unordered_map>
+#include <cstdint> // std::uint8_t
 
 #include "match_set.hpp"
+#include "population.hpp"
 #include "xcs_params.hpp"
+#include "xcspp/util/action_ordinals.hpp"
 
 namespace xcspp::xcs
 {
@@ -13,10 +16,18 @@ namespace xcspp::xcs
     private:
         const XCSParams * const m_pParams;
 
-        // PA (Prediction Array)
-        std::unordered_map<int, double> m_pa;
+        // Dense ordinals of the available actions (the arrays below are indexed by them)
+        const ActionOrdinals m_actionOrdinals;
 
-        // Array of PA keys (for random action selection)
+        // PA (Prediction Array) and FSA (Fitness Sum Array)
+        //   (The PA of the actions not in [M] is zero.)
+        std::vector<double> m_pa;
+        std::vector<double> m_fsa;
+
+        // Whether the action is in [M]
+        std::vector<std::uint8_t> m_isInMatchSet;
+
+        // Actions in [M] in ascending order (for random action selection)
         std::vector<int> m_paActions;
 
         // The maximum value of PA
@@ -26,16 +37,35 @@ namespace xcspp::xcs
         std::vector<int> m_maxPAActions;
 
     public:
+        // Constructor
+        //   (Call generate() before using the other functions.)
+        PredictionArray(const std::unordered_set<int> & availableActions, const XCSParams *pParams);
+
         // GENERATE PREDICTION ARRAY
-        PredictionArray(const MatchSet & matchSet, const XCSParams *pParams);
+        PredictionArray(const MatchSet & matchSet, const Population & population, const XCSParams *pParams);
 
         // Destructor
         ~PredictionArray() = default;
 
+        // GENERATE PREDICTION ARRAY
+        //   (The arrays are sized to the available actions at construction, so this does not allocate memory.)
+        void generate(const MatchSet & matchSet, const Population & population);
+
         double max() const;
 
         double predictionFor(int action) const;
 
+        // PA indexed by action ordinal (zero for the actions not in [M])
+        const std::vector<double> & predictions() const noexcept
+        {
+            return m_pa;
+        }
+
+        const ActionOrdinals & actionOrdinals() const noexcept
+        {
+            return m_actionOrdinals;
+        }
+
         // SELECT ACTION
         // (You can use greedy selection by setting epsilon to zero.)
         int selectAction(double epsilon, Random & random) const;
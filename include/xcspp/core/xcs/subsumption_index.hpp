@@ -0,0 +1,74 @@
+#pragma once
+#include <set>
+#include <tuple>
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t, std::uint32_t, std::uint64_t
+
+#include "classifier.hpp"
+#include "xcs_params.hpp"
+#include "xcspp/util/set_node_pool.hpp"
+
+namespace xcspp::xcs
+{
+
+    // Index of the classifiers in [P] that can subsume others (experience > thetaSub and epsilon < epsilonZero)
+    //   The subsumers are partitioned by action and ordered by generality (the number of "#"). A classifier
+    //   more general than another has more "#" symbols, so the candidates that may subsume a classifier are
+    //   found without visiting the other classifiers in [P].
+    //   Each classifier is identified by its slot index in [P].
+    class SubsumptionIndex
+    {
+    private:
+        const XCSParams * const m_pParams;
+
+        // thetaSub and epsilonZero with which the index is made
+        std::uint64_t m_thetaSub;
+        double m_epsilonZero;
+
+        // Subsumers ordered by (action, generality, slot index)
+        std::set<std::tuple<int, std::size_t, std::uint32_t>> m_subsumers;
+        SetNodePool<std::set<std::tuple<int, std::size_t, std::uint32_t>>> m_nodePool;
+
+        // Whether the slot is in the index, and its action and generality (indexed by slot)
+        std::vector<std::uint8_t> m_isIndexed;
+        std::vector<int> m_actions;
+        std::vector<std::size_t> m_generalities;
+
+    public:
+        // Constructor
+        explicit SubsumptionIndex(const XCSParams *pParams);
+
+        // Destructor
+        ~SubsumptionIndex() = default;
+
+        // Add or remove the classifier in the slot depending on whether it could subsume others
+        // (The condition and action must not change while the classifier is in the index.)
+        void update(std::size_t idx, const Condition & condition, int action, std::uint64_t experience, double epsilon);
+
+        // Remove the classifier in the slot (nothing happens if it is not in the index)
+        void erase(std::size_t idx);
+
+        void clear();
+
+        // Allocate the memory for the given number of slots in advance
+        void reserve(std::size_t slotCount);
+
+        // Whether thetaSub or epsilonZero has been changed since the index was cleared
+        bool isOutdated() const noexcept;
+
+        // Collect the slot indices of the subsumers with the same action that are general enough to subsume
+        // the classifier (in no particular order)
+        void collectCandidates(const ConditionActionPair & cl, std::vector<std::size_t> & candidateIndices) const;
+
+        // Returns false if the subsumer in the slot idx is not more general than the subsumer in the slot otherIdx
+        // (Both must be in the index.)
+        bool mayBeMoreGeneral(std::size_t idx, std::size_t otherIdx) const;
+
+        bool contains(std::size_t idx) const noexcept
+        {
+            return idx < m_isIndexed.size() && m_isIndexed[idx];
+        }
+    };
+
+}
@@ -1,5 +1,7 @@
 #pragma once
 #include <memory>
+#include <optional>
+#include <cstddef> // std::size_t
 #include <cstdint> // std::uint64_t
 
 #include "xcspp/util/random.hpp"
@@ -138,6 +140,60 @@ namespace xcspp::xcs
         //   Whether to use the moyenne adaptive modifee (MAM) for updating the
         //   prediction and the prediction error of classifiers
         bool useMAM = true;
+
+        // matchingMethod
+        //   The data structure used to find the classifiers in [P] that match the situation
+        //   (kInvertedIndex visits only the classifiers specifying the input value or "#" at
+        //    the most selective position, and is faster when most conditions are specific)
+        enum class MatchingMethod
+        {
+            kBitSliced,
+            kInvertedIndex,
+        };
+        MatchingMethod matchingMethod = MatchingMethod::kBitSliced;
+
+        // matchSetCacheSize
+        //   The memory limit in bytes of the cache of the classifiers matching each
+        //   situation (set "0" to disable the cache)
+        //   Recommended: "0" unless the same situations appear repeatedly (e.g., the
+        //                rows of a dataset or the sensor inputs of a small maze)
+        std::size_t matchSetCacheSize = 0;
+
+        // populationChunkSize
+        //   The number of slots of [P] allocated at once when [P] grows (set "0" to
+        //   grow the capacity geometrically)
+        std::size_t populationChunkSize = 0;
+
+        // useHugePages
+        //   Whether to back the per-classifier arrays of [P] with transparent huge
+        //   pages (madvise(MADV_HUGEPAGE); ignored on other platforms than Linux)
+        //   Recommended: "true" for populations of tens of thousands of classifiers
+        bool useHugePages = false;
+
+        // preallocate
+        //   Whether to allocate [P] and the working buffers for N + max(2, the number of actions)
+        //   classifiers (the most [P] holds during a step) in advance, so that explore() and
+        //   reward() perform no heap allocation once the first classifier is generated (except
+        //   for the match set cache and the inverted match index)
+        bool preallocate = false;
+
+        // partitionByAction
+        //   Whether to group the classifiers in [M] by action, so that [A] and the
+        //   prediction array are taken from each group without testing the action of
+        //   every classifier in [M] (the results do not change)
+        //   Recommended: "true" for problems with many actions (e.g., multi-class
+        //                datasets)
+        bool partitionByAction = false;
+
+        // randomEngine
+        //   The pseudo-random number engine
+        //   (kXoshiro256PlusPlus and kPCG64 are faster than kMT19937)
+        RandomEngineType randomEngine = RandomEngineType::kMT19937;
+
+        // seed
+        //   The seed of the pseudo-random number engine (a nondeterministic seed is
+        //   used if it is not specified)
+        std::optional<std::uint64_t> seed;
     };
 
 }
@@ -1,10 +1,10 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <type_traits> // std::conditional_t
 #include <cstdint> // std::uint64_t
 
 #include "condition.hpp"
-#include "xcsr_params.hpp"
 
 namespace xcspp::xcsr
 {
@@ -25,12 +25,21 @@ namespace xcspp::xcsr
         // Constructor
         ConditionActionPair(const ConditionActionPair &) = default;
 
+        ConditionActionPair(ConditionActionPair &&) noexcept = default;
+
         ConditionActionPair(const Condition & condition, int action);
 
         ConditionActionPair(Condition && condition, int action);
 
         // Destructor
-        virtual ~ConditionActionPair() = default;
+        ~ConditionActionPair() = default;
+
+        ConditionActionPair & operator=(const ConditionActionPair &) = default;
+
+        ConditionActionPair & operator=(ConditionActionPair &&) noexcept = default;
+
+        // Returns the hash of the condition and the action (equal pairs have the same hash)
+        std::uint64_t hash() const;
 
         friend std::ostream & operator<< (std::ostream & os, const ConditionActionPair & obj);
     };
@@ -75,6 +84,8 @@ namespace xcspp::xcsr
         // Constructor
         Classifier(const Classifier &) = default;
 
+        Classifier(Classifier &&) noexcept = default;
+
         Classifier(const Condition & condition, int action, double prediction, double epsilon, double fitness, std::uint64_t timeStamp);
 
         Classifier(const ConditionActionPair & conditionActionPair, double prediction, double epsilon, double fitness, std::uint64_t timeStamp);
@@ -84,42 +95,70 @@ namespace xcspp::xcsr
         Classifier(const std::string & condition, int action, double prediction, double epsilon, double fitness, std::uint64_t timeStamp);
 
         // Destructor
-        virtual ~Classifier() = default;
+        ~Classifier() = default;
+
+        Classifier & operator=(const Classifier &) = default;
+
+        Classifier & operator=(Classifier &&) noexcept = default;
 
         double accuracy(double epsilonZero, double alpha, double nu) const;
     };
 
-    // Classifier in [P] (have a reference to XCSRParams)
-    struct StoredClassifier : Classifier
+    // Reference to the members of a classifier in [P]
+    //   Population keeps each member in a separate array, and this bundles the elements of one slot.
+    //   (Do not keep it across an insertion into [P], which may reallocate the arrays.)
+    template <bool IsConst>
+    struct BasicClassifierRef
     {
     private:
-        // XCSRParams
-        const XCSRParams * const m_pParams;
+        template <typename T>
+        using MemberRef = std::conditional_t<IsConst, const T &, T &>;
 
     public:
-        // Constructor
-        StoredClassifier(const StoredClassifier & obj) = default;
-
-        StoredClassifier(const Classifier & obj, const XCSRParams *pParams);
-
-        StoredClassifier(const Condition & condition, int action, std::uint64_t timeStamp, const XCSRParams *pParams);
-
-        StoredClassifier(const ConditionActionPair & conditionActionPair, std::uint64_t timeStamp, const XCSRParams *pParams);
-
-        StoredClassifier(ConditionActionPair && conditionActionPair, std::uint64_t timeStamp, const XCSRParams *pParams);
-
-        StoredClassifier(const std::string & condition, int action, std::uint64_t timeStamp, const XCSRParams *pParams);
-
-        // Destructor
-        virtual ~StoredClassifier() = default;
-
-        // COULD SUBSUME
-        bool isSubsumer() const;
+        // The condition and action are immutable while the classifier is in [P]
+        const Condition & condition;
+        const int & action;
+
+        MemberRef<double> prediction;
+        MemberRef<double> epsilon;
+        MemberRef<double> fitness;
+        MemberRef<std::uint64_t> experience;
+        MemberRef<std::uint64_t> timeStamp;
+        MemberRef<double> actionSetSize;
+        MemberRef<std::uint64_t> numerosity;
+
+        operator BasicClassifierRef<true>() const
+        {
+            return { condition, action, prediction, epsilon, fitness, experience, timeStamp, actionSetSize, numerosity };
+        }
+
+        // Make a copy of the classifier
+        Classifier toClassifier() const
+        {
+            Classifier cl(condition, action, prediction, epsilon, fitness, timeStamp);
+            cl.experience = experience;
+            cl.actionSetSize = actionSetSize;
+            cl.numerosity = numerosity;
+            return cl;
+        }
+
+        // Overwrite the given classifier with a copy of this one (the buffer of its condition is reused)
+        void copyTo(Classifier & cl) const
+        {
+            cl.condition = condition;
+            cl.action = action;
+            cl.prediction = prediction;
+            cl.epsilon = epsilon;
+            cl.fitness = fitness;
+            cl.experience = experience;
+            cl.timeStamp = timeStamp;
+            cl.actionSetSize = actionSetSize;
+            cl.numerosity = numerosity;
+        }
+    };
 
-        // DOES SUBSUME
-        bool subsumes(const Classifier & cl) const;
+    using ClassifierRef = BasicClassifierRef<false>;
 
-        double accuracy() const;
-    };
+    using ConstClassifierRef = BasicClassifierRef<true>;
 
 }
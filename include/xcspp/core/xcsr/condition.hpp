@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
 
 #include "symbol.hpp"
 
@@ -22,9 +23,17 @@ namespace xcspp::xcsr
 
         explicit Condition(const std::string & symbols);
 
+        Condition(const Condition &) = default;
+
+        Condition(Condition &&) noexcept = default;
+
         // Destructor
         ~Condition() = default;
 
+        Condition & operator=(const Condition &) = default;
+
+        Condition & operator=(Condition &&) noexcept = default;
+
         std::string toString() const;
 
         // DOES MATCH
@@ -33,6 +42,14 @@ namespace xcspp::xcsr
         // IS MORE GENERAL
         bool isMoreGeneral(const Condition & cl, XCSRRepr repr) const;
 
+        // Returns the sum of the widths of the intervals
+        // (If this condition is more general than another, its generality is not less than that of the other.)
+        double generality(XCSRRepr repr) const;
+
+        // Returns the hash of the symbols (equal conditions have the same hash)
+        // (The symbols are modifiable through references, so this is computed on every call.)
+        std::uint64_t hash() const;
+
         friend std::ostream & operator<< (std::ostream & os, const Condition & obj);
 
         // --- The functions below are just wrappers for std::vector<Symbol> ---
@@ -47,6 +64,11 @@ namespace xcspp::xcsr
             return m_symbols.size();
         }
 
+        void resize(std::size_t size)
+        {
+            m_symbols.resize(size);
+        }
+
         auto begin() noexcept
         {
             return m_symbols.begin();
@@ -0,0 +1,104 @@
+#pragma once
+#include <set>
+#include <utility> // std::pair
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+
+#include "xcsr_params.hpp"
+#include "xcspp/util/fenwick_tree.hpp"
+#include "xcspp/util/random.hpp"
+#include "xcspp/util/set_node_pool.hpp"
+
+namespace xcspp::xcsr
+{
+
+    // Roulette wheel of the deletion votes of the classifiers in [P]
+    //   The deletion vote of a classifier is as * n, multiplied by averageFitness / (F / n) if the
+    //   classifier is experienced (exp >= thetaDel) and F / n < delta * averageFitness. Since the
+    //   average fitness changes with every update, the classifiers are divided into two buckets:
+    //   the votes as * n of the unpenalized ones and the weights as * n * n / F of the penalized ones
+    //   are kept in separate Fenwick trees, and the vote of a penalized one is averageFitness times
+    //   its weight. The experienced classifiers are ordered by F / n, so that only the classifiers
+    //   between the previous and the current threshold (delta * averageFitness) move to the other
+    //   bucket when a classifier is selected.
+    //   Each classifier is identified by its slot index in [P].
+    class DeletionWheel
+    {
+    private:
+        const XCSRParams * const m_pParams;
+
+        // thetaDel and delta with which the buckets are made
+        std::uint64_t m_thetaDel;
+        double m_delta;
+
+        // Values of the classifiers when they were last updated (indexed by slot)
+        std::vector<double> m_actionSetSizes;
+        std::vector<std::uint64_t> m_numerosities;
+        std::vector<double> m_fitnesses;
+        std::vector<std::uint64_t> m_experiences;
+
+        // Sums of the numerosities and fitnesses of all classifiers
+        std::uint64_t m_numerositySum;
+        double m_fitnessSum;
+
+        // Votes of the unpenalized classifiers and weights of the penalized classifiers
+        FenwickTree<double> m_votes;
+        FenwickTree<double> m_penalizedWeights;
+
+        // Experienced classifiers ordered by (F / n, slot index)
+        std::set<std::pair<double, std::uint32_t>> m_experiencedClassifiers;
+        SetNodePool<std::set<std::pair<double, std::uint32_t>>> m_nodePool;
+
+        // Threshold of F / n with which the classifiers are divided into the buckets
+        double m_threshold;
+
+        // The number of changes since the sums were recomputed
+        std::size_t m_changeCount;
+
+        bool isExperienced(std::size_t idx) const;
+
+        double fitnessPerNumerosity(std::size_t idx) const;
+
+        // Move the classifier to the bucket given by the threshold
+        void updateBucket(std::size_t idx);
+
+        // Move the classifiers between the previous and the current threshold to the other bucket
+        void moveThreshold(double threshold);
+
+        // Recompute the sums to discard the rounding errors
+        void recomputeSums();
+
+        // Rebuild the buckets for the current thetaDel and delta
+        void rebuild();
+
+    public:
+        // Constructor
+        explicit DeletionWheel(const XCSRParams *pParams);
+
+        // Destructor
+        ~DeletionWheel() = default;
+
+        // Set the values of the classifier in the slot (all zero for an empty slot)
+        void update(std::size_t idx, double actionSetSize, std::uint64_t numerosity, double fitness, std::uint64_t experience);
+
+        void clear();
+
+        // Allocate the memory for the given number of slots in advance
+        void reserve(std::size_t slotCount);
+
+        // Select a slot with probability proportional to its deletion vote
+        std::size_t select(Random & random);
+
+        std::uint64_t numerositySum() const noexcept
+        {
+            return m_numerositySum;
+        }
+
+        double fitnessSum() const noexcept
+        {
+            return m_fitnessSum;
+        }
+    };
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+#include <cstddef> // std::size_t
+
+#include "condition.hpp"
+#include "xcsr_repr.hpp"
+
+namespace xcspp::xcsr
+{
+
+    // Containment tests of conditions on the bounds of their intervals
+    //   The intervals of a condition are normalized to arrays of lower and upper bounds once (so CSR, OBR and
+    //   UBR are handled in the same way), and two conditions are compared by kContainmentChunkSize dimensions
+    //   at once with "otherLower < lower || upper < otherUpper" (not contained) and "otherLower == lower &&
+    //   upper == otherUpper" (equal) in AVX-512, AVX2, or portable scalar operations depending on the build.
+    //   The test stops at the first chunk that is not contained, and gives the same results as
+    //   Condition::isMoreGeneral().
+
+    // The number of dimensions compared at once
+    constexpr std::size_t kContainmentChunkSize = 8;
+
+    // Write the bounds of the intervals of the condition to lowerBounds[0, L) and upperBounds[0, L)
+    void GetConditionBounds(const Condition & condition, XCSRRepr repr, double *lowerBounds, double *upperBounds);
+
+    // Returns whether the intervals [lowerBounds[i], upperBounds[i]) contain [otherLowerBounds[i], otherUpperBounds[i])
+    // in all dimensions and are not equal to them in at least one
+    bool IsMoreGeneral(const double *lowerBounds, const double *upperBounds, const double *otherLowerBounds, const double *otherUpperBounds, std::size_t length) noexcept;
+
+    // The same test against the condition whose bounds are not normalized
+    //   (The bounds of the condition are calculated for each chunk as it is compared.)
+    //   (Instantiated for all representations in interval_containment.cpp)
+    template <XCSRRepr Repr>
+    bool IsMoreGeneral(const double *lowerBounds, const double *upperBounds, const Condition & other) noexcept;
+
+    // Keep the rows whose intervals are more general than the other bounds (in the same order)
+    //   The bounds of the row r are lowerBounds[r * length + i] and upperBounds[r * length + i].
+    void KeepMoreGeneralRows(const double *lowerBounds, const double *upperBounds, const double *otherLowerBounds, const double *otherUpperBounds, std::size_t length, std::vector<std::size_t> & rows);
+
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t, std::uint16_t
+
+#include "condition.hpp"
+#include "xcsr_repr.hpp"
+#include "xcsr_precision.hpp"
+
+namespace xcspp::xcsr
+{
+
+    // Matching engine which keeps the intervals of the conditions of [P] as arrays of bounds
+    //   The lower and upper bounds of each condition are calculated once from the representation
+    //   when it is inserted, and stored by dimension for blocks of 8 classifiers. A situation is
+    //   tested against a whole block at once by "lower <= x < upper" (AVX-512, AVX2, or portable
+    //   scalar operations depending on the build), which gives the same results as Condition::matches().
+    //   (Without SIMD, only the first dimensions are tested for the whole block and the rest for each
+    //    classifier alone.)
+    //   With the precision kFloat or kUInt16, the bounds are kept as floats or 16-bit levels rounded
+    //   outward and tested by "lower <= x <= upper", so a block takes 1/2 or 1/4 of the memory and one
+    //   comparison per bound for 8 classifiers (AVX2). The result then contains all the matching columns
+    //   and possibly a few more whose conditions miss the situation by less than the rounding, which the
+    //   caller must check by Condition::matches().
+    //   Each classifier is identified by a column index given by the caller (the slot index in [P]).
+    class IntervalMatcher
+    {
+    public:
+        // The number of classifiers (columns) processed together
+        static constexpr std::size_t kBlockSize = 8;
+
+    private:
+        // Condition length L (all conditions must have the same length)
+        std::size_t m_conditionLength;
+
+        // Bounds of the intervals
+        //   m_lowerBounds[(block * L + dimension) * kBlockSize + lane] is the lower bound of the column
+        //   (block * kBlockSize + lane) in the dimension, and the same for m_upperBounds
+        //   (Only the arrays of the precision are used)
+        std::vector<double> m_lowerBounds;
+        std::vector<double> m_upperBounds;
+        std::vector<float> m_lowerFloatBounds;
+        std::vector<float> m_upperFloatBounds;
+        std::vector<std::uint16_t> m_lowerLevels;
+        std::vector<std::uint16_t> m_upperLevels;
+
+        SymbolQuantizer m_quantizer;
+
+        // Situation converted to the precision
+        mutable std::vector<float> m_floatSituation;
+        mutable std::vector<std::uint16_t> m_levelSituation;
+
+        // Columns in use (bit lane of m_liveMasks[block])
+        std::vector<std::uint8_t> m_liveMasks;
+
+        // The number of columns in use
+        std::size_t m_size;
+
+        void reset(std::size_t conditionLength);
+
+        template <typename Bound>
+        void matchBounds(const std::vector<Bound> & lowerBounds, const std::vector<Bound> & upperBounds, const Bound *situation, std::vector<std::size_t> & matchedColumns) const;
+
+    public:
+        // Constructor
+        //   (minValue and maxValue give the range of the 16-bit levels for kUInt16)
+        explicit IntervalMatcher(XCSRPrecision precision = XCSRPrecision::kDouble, double minValue = 0.0, double maxValue = 1.0);
+
+        // Destructor
+        ~IntervalMatcher() = default;
+
+        // Add a condition to the unused column
+        void insert(std::size_t column, const Condition & condition, XCSRRepr repr);
+
+        // Remove the condition of the column
+        void erase(std::size_t column);
+
+        void clear();
+
+        // Allocate the memory for the columns [0, columnCount) of conditions of the given length in advance
+        void reserve(std::size_t columnCount, std::size_t conditionLength);
+
+        // Collect the columns of the conditions that match the situation in ascending order
+        //   (Including the columns that need to be checked unless the precision is kDouble)
+        void match(const std::vector<double> & situation, std::vector<std::size_t> & matchedColumns) const;
+
+        XCSRPrecision precision() const noexcept
+        {
+            return m_quantizer.precision();
+        }
+
+        std::size_t conditionLength() const noexcept
+        {
+            return m_conditionLength;
+        }
+
+        auto empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        auto size() const noexcept
+        {
+            return m_size;
+        }
+    };
+
+}
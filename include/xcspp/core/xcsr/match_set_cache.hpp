@@ -0,0 +1,103 @@
+#pragma once
+#include <list>
+#include <vector>
+#include <unordered_map>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint64_t
+
+#include "population.hpp"
+#include "xcsr_params.hpp"
+
+namespace xcspp::xcsr
+{
+
+    // Cache of the classifiers in [P] matching each situation
+    //   Each entry remembers the epoch of [P] at which it was valid. If [P] has been modified since
+    //   then, only the slots inserted or removed after the epoch are tested again, so that the entry
+    //   is repaired instead of being regenerated. The least recently used entries are evicted when
+    //   the memory usage exceeds the limit.
+    class MatchSetCache
+    {
+    private:
+        struct SituationHash
+        {
+            std::size_t operator() (const std::vector<double> & situation) const noexcept;
+        };
+
+        struct Entry
+        {
+            // Matched slot indices in ascending order
+            std::vector<std::uint32_t> matchedIndices;
+
+            // Epoch of [P] at which matchedIndices is valid
+            std::uint64_t epoch;
+
+            // Position in m_recentlyUsedSituations
+            std::list<const std::vector<double> *>::iterator recentlyUsedIterator;
+
+            // Estimated memory usage in bytes
+            std::size_t memoryUsage;
+        };
+
+        const XCSRParams * const m_pParams;
+
+        std::unordered_map<std::vector<double>, Entry, SituationHash> m_entries;
+
+        // Situations of the entries (front: most recently used)
+        std::list<const std::vector<double> *> m_recentlyUsedSituations;
+
+        std::size_t m_memoryUsage;
+
+        std::uint64_t m_hitCount;
+        std::uint64_t m_missCount;
+
+        static std::size_t EstimateMemoryUsage(const std::vector<double> & situation, const Entry & entry);
+
+        void evictLeastRecentlyUsed();
+
+    public:
+        // Constructor
+        explicit MatchSetCache(const XCSRParams *pParams);
+
+        // Destructor
+        ~MatchSetCache() = default;
+
+        // Collect the slot indices of the classifiers that match the situation in ascending order
+        // (The result is the same as Population::match(). Use the cache only for a single [P].)
+        void match(const Population & population, const std::vector<double> & situation, std::vector<std::size_t> & matchedIndices);
+
+        void clear();
+
+        // Whether the cache is used (false if XCSRParams::matchSetCacheSize is 0)
+        bool isEnabled() const noexcept
+        {
+            return m_pParams->matchSetCacheSize > 0;
+        }
+
+        std::uint64_t hitCount() const noexcept
+        {
+            return m_hitCount;
+        }
+
+        std::uint64_t missCount() const noexcept
+        {
+            return m_missCount;
+        }
+
+        std::size_t memoryUsage() const noexcept
+        {
+            return m_memoryUsage;
+        }
+
+        auto empty() const noexcept
+        {
+            return m_entries.empty();
+        }
+
+        auto size() const noexcept
+        {
+            return m_entries.size();
+        }
+    };
+
+}
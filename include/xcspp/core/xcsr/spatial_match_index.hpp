@@ -0,0 +1,144 @@
+#pragma once
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t, std::uint32_t
+
+#include "condition.hpp"
+#include "xcsr_repr.hpp"
+
+namespace xcspp::xcsr
+{
+
+    // Matching engine which keeps the conditions of [P] in an R-tree of their hyper-rectangles
+    //   The conditions are stored as the bounds [lower, upper) calculated from the representation
+    //   when they are inserted, so CSR, OBR and UBR are handled in the same way. Each node holds
+    //   the bounding box of its entries, and the match set is obtained by a point-stabbing query
+    //   which descends only into the nodes whose boxes contain the situation.
+    //   Insertion follows the path of the least enlargement of the box margins (the sum of the
+    //   widths, which does not vanish in high dimensions as the volume does), and an overflowing
+    //   node is split in half along the dimension where the centers of its entries spread most.
+    //   A node left with fewer than kMinEntries entries by removal is dissolved and its columns
+    //   are inserted again, so the tree stays balanced under the changes by the GA, covering,
+    //   deletion and subsumption.
+    //   The pruning by boxes works only in low dimensions (the boxes of general conditions cover
+    //   most of the input space as the number of dimensions grows), so the scan of IntervalMatcher
+    //   is faster above the crossover given by IsPreferredOverScan().
+    //   Each classifier is identified by a column index given by the caller (the slot index in [P]).
+    class SpatialMatchIndex
+    {
+    public:
+        // The maximum number of entries (columns or child nodes) in a node
+        static constexpr std::size_t kMaxEntries = 16;
+
+        // The minimum number of entries in a node except the root
+        static constexpr std::size_t kMinEntries = 4;
+
+        // Returns whether this index is expected to be faster than the scan of IntervalMatcher for [P] of
+        // the given size
+        //   The crossover measured by xcspp_interval_match_benchmark is about
+        //     N >= 1000 and L <= 8 (portable build), or N >= 4000 and L <= 2 (AVX2/AVX-512 build),
+        //   for match sets of up to 5% of [P]. (The scan is faster for more general populations at any size.)
+        static bool IsPreferredOverScan(std::size_t columnCount, std::size_t conditionLength) noexcept;
+
+    private:
+        // The number of entry slots per node (one more than kMaxEntries to hold an entry until the node is split)
+        static constexpr std::size_t kNodeCapacity = kMaxEntries + 1;
+
+        // Condition length L (all conditions must have the same length)
+        std::size_t m_conditionLength;
+
+        // Bounds of the columns (m_columnLowerBounds[column * L + dimension], and the same for upper)
+        std::vector<double> m_columnLowerBounds;
+        std::vector<double> m_columnUpperBounds;
+
+        // Leaf node of each column (kNoNode if the column is not in use)
+        std::vector<std::uint32_t> m_columnLeaves;
+
+        // Bounding boxes of the nodes (m_nodeLowerBounds[node * L + dimension], and the same for upper)
+        std::vector<double> m_nodeLowerBounds;
+        std::vector<double> m_nodeUpperBounds;
+
+        // Entries of the nodes (m_nodeEntries[node * kNodeCapacity + i]; columns in leaves, child nodes otherwise)
+        std::vector<std::uint32_t> m_nodeEntries;
+        std::vector<std::uint32_t> m_nodeEntryCounts;
+        std::vector<std::uint32_t> m_nodeParents;
+        std::vector<std::uint8_t> m_nodeIsLeaf;
+        std::vector<std::uint32_t> m_freeNodes;
+
+        std::uint32_t m_root;
+
+        // The number of columns in use
+        std::size_t m_size;
+
+        // Scratch buffers
+        mutable std::vector<std::uint32_t> m_nodeStack;
+        std::vector<std::uint32_t> m_orphanColumns;
+        std::vector<std::uint32_t> m_splitEntries;
+
+        void reset(std::size_t conditionLength);
+
+        std::uint32_t allocateNode(bool isLeaf);
+
+        const double *entryLowerBounds(std::uint32_t node, std::uint32_t entry) const;
+
+        const double *entryUpperBounds(std::uint32_t node, std::uint32_t entry) const;
+
+        // Make the box of the node the union of the boxes of its entries
+        void recalculateBounds(std::uint32_t node);
+
+        // Returns the leaf whose box needs the least enlargement to contain the column
+        std::uint32_t chooseLeaf(std::uint32_t column) const;
+
+        // Add the entry to the node, splitting the node if it overflows
+        // (The boxes of the node and its ancestors must already contain the entry.)
+        void addEntry(std::uint32_t node, std::uint32_t entry);
+
+        void split(std::uint32_t node);
+
+        // Insert the column whose bounds are stored into the tree
+        void insertColumn(std::uint32_t column);
+
+        // Remove the node from the tree, collecting the columns under it into m_orphanColumns
+        void dissolve(std::uint32_t node);
+
+    public:
+        // Constructor
+        SpatialMatchIndex();
+
+        // Destructor
+        ~SpatialMatchIndex() = default;
+
+        // Add a condition to the unused column
+        void insert(std::size_t column, const Condition & condition, XCSRRepr repr);
+
+        // Remove the condition of the column
+        void erase(std::size_t column);
+
+        void clear();
+
+        // Allocate the memory for the columns [0, columnCount) of conditions of the given length in advance
+        void reserve(std::size_t columnCount, std::size_t conditionLength);
+
+        // Collect the columns of the conditions that match the situation in ascending order
+        void match(const std::vector<double> & situation, std::vector<std::size_t> & matchedColumns) const;
+
+        // The height of the tree (0 if empty)
+        std::size_t height() const;
+
+        std::size_t conditionLength() const noexcept
+        {
+            return m_conditionLength;
+        }
+
+        auto empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        auto size() const noexcept
+        {
+            return m_size;
+        }
+    };
+
+}
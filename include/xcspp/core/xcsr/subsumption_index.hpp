@@ -0,0 +1,107 @@
+#pragma once
+#include <set>
+#include <tuple>
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t, std::uint32_t, std::uint64_t
+
+#include "classifier.hpp"
+#include "xcsr_params.hpp"
+#include "xcspp/util/set_node_pool.hpp"
+
+namespace xcspp::xcsr
+{
+
+    // Index of the classifiers in [P] that can subsume others (experience > thetaSub and epsilon < epsilonZero)
+    //   The subsumers are partitioned by action and ordered by generality (the sum of the interval widths).
+    //   A classifier more general than another has intervals containing those of the other, so the candidates
+    //   that may subsume a classifier are found without visiting the other classifiers in [P].
+    //   The bounds of the intervals of the subsumers are kept as rows of arrays, so that the candidates are
+    //   tested by the containment kernel (interval_containment.hpp) without converting their representation.
+    //   Each classifier is identified by its slot index in [P].
+    class SubsumptionIndex
+    {
+    private:
+        const XCSRParams * const m_pParams;
+
+        // thetaSub and epsilonZero with which the index is made
+        std::uint64_t m_thetaSub;
+        double m_epsilonZero;
+
+        // Subsumers ordered by (action, generality, slot index)
+        std::set<std::tuple<int, double, std::uint32_t>> m_subsumers;
+        SetNodePool<std::set<std::tuple<int, double, std::uint32_t>>> m_nodePool;
+
+        // Whether the slot is in the index, and its action and generality (indexed by slot)
+        std::vector<std::uint8_t> m_isIndexed;
+        std::vector<int> m_actions;
+        std::vector<double> m_generalities;
+
+        // Bounds of the intervals of the subsumers (m_lowerBounds[idx * L + dimension], and the same for upper)
+        std::size_t m_conditionLength;
+        std::vector<double> m_lowerBounds;
+        std::vector<double> m_upperBounds;
+
+        // Bounds of the classifier given to collectSubsumers() (L values each)
+        mutable std::vector<double> m_otherLowerBounds;
+        mutable std::vector<double> m_otherUpperBounds;
+
+        // Make the rows of the bounds for the condition length (the index must be empty)
+        void setConditionLength(std::size_t conditionLength);
+
+    public:
+        // Constructor
+        explicit SubsumptionIndex(const XCSRParams *pParams);
+
+        // Destructor
+        ~SubsumptionIndex() = default;
+
+        // Add or remove the classifier in the slot depending on whether it could subsume others
+        // (The condition and action must not change while the classifier is in the index.)
+        void update(std::size_t idx, const Condition & condition, int action, std::uint64_t experience, double epsilon);
+
+        // Remove the classifier in the slot (nothing happens if it is not in the index)
+        void erase(std::size_t idx);
+
+        void clear();
+
+        // Allocate the memory for the given number of slots of conditions of the given length in advance
+        void reserve(std::size_t slotCount, std::size_t conditionLength);
+
+        // Whether thetaSub or epsilonZero has been changed since the index was cleared
+        bool isOutdated() const noexcept;
+
+        // Collect the slot indices of the subsumers with the same action that are general enough to subsume
+        // the classifier (in no particular order)
+        void collectCandidates(const ConditionActionPair & cl, std::vector<std::size_t> & candidateIndices) const;
+
+        // Collect the slot indices of the subsumers with the same action whose conditions are more general than
+        // that of the classifier (in no particular order)
+        void collectSubsumers(const ConditionActionPair & cl, std::vector<std::size_t> & subsumerIndices) const;
+
+        // Returns false if the subsumer in the slot idx is not more general than the subsumer in the slot otherIdx
+        // (Both must be in the index.)
+        bool mayBeMoreGeneral(std::size_t idx, std::size_t otherIdx) const;
+
+        // Returns whether the condition of the subsumer in the slot idx is more general than that of the subsumer
+        // in the slot otherIdx (Both must be in the index.)
+        bool isMoreGeneral(std::size_t idx, std::size_t otherIdx) const;
+
+        // Bounds of the intervals of the subsumer in the slot (L values each; the subsumer must be in the index)
+        const double *lowerBounds(std::size_t idx) const noexcept
+        {
+            return m_lowerBounds.data() + idx * m_conditionLength;
+        }
+
+        const double *upperBounds(std::size_t idx) const noexcept
+        {
+            return m_upperBounds.data() + idx * m_conditionLength;
+        }
+
+        bool contains(std::size_t idx) const noexcept
+        {
+            return idx < m_isIndexed.size() && m_isIndexed[idx];
+        }
+    };
+
+}
@@ -7,6 +7,7 @@
 #include "xcspp/core/iclassifier_system.hpp"
 #include "xcsr_params.hpp"
 #include "population.hpp"
+#include "match_set_cache.hpp"
 #include "action_set.hpp"
 #include "prediction_array.hpp"
 
@@ -36,6 +37,15 @@ namespace xcspp::xcsr
         //   execution cycle.
         ActionSet m_prevActionSet;
 
+        // [M] and PA of the current step
+        //   (kept to reuse their buffers in every step)
+        MatchSet m_matchSet;
+        PredictionArray m_predictionArray;
+
+        // Cache of the classifiers matching each situation
+        //   (used if matchSetCacheSize is not 0)
+        MatchSetCache m_matchSetCache;
+
         // Available action choices
         const std::unordered_set<int> m_availableActions;
 
@@ -49,7 +59,7 @@ namespace xcspp::xcsr
 
         // Prediction value of the previous action decision (just for logging)
         double m_prediction;
-        std::unordered_map<int, double> m_predictions;
+        std::vector<double> m_predictions; // indexed by action ordinal (empty before the first decision)
 
         // Covering occurrence of the previous action decision (just for logging)
         bool m_isCoveringPerformed;
@@ -92,6 +102,9 @@ namespace xcspp::xcsr
         // Get const reference to population
         const Population & population() const;
 
+        // Get const reference to the match set cache (e.g., to see the hit/miss counters)
+        const MatchSetCache & matchSetCache() const;
+
         void setPopulationClassifiers(const std::vector<Classifier> & classifiers, bool syncTimeStamp = true);
 
         [[deprecated("use XCS::outputPopulationCSV() instead")]]
@@ -1,8 +1,11 @@
 #pragma once
 #include <memory>
+#include <optional>
+#include <cstddef> // std::size_t
 #include <cstdint> // std::uint64_t
 
 #include "xcsr_repr.hpp"
+#include "xcsr_precision.hpp"
 #include "xcspp/util/random.hpp"
 
 namespace xcspp::xcsr
@@ -150,6 +153,14 @@ namespace xcspp::xcsr
         // XCSR representation
         XCSRRepr repr = XCSRRepr::kCSR;
 
+        // precision
+        //   The precision of the symbol values of the conditions
+        //   (The covering and the mutation round the values to the precision, and [P] keeps the
+        //    bounds for matching in float or 16-bit levels instead of double, which makes the
+        //    matching scan read 2x or 4x less memory per classifier. Matching is exact for the
+        //    conditions in any case.)
+        XCSRPrecision precision = XCSRPrecision::kDouble;
+
         // The maximum/minimum value of a classifier symbol value
         double minValue = 0.0;
         double maxValue = 1.0;
@@ -168,6 +179,63 @@ namespace xcspp::xcsr
         //   (max-value - min-value) / 2.
         //   Choose "true" to avoid the random bias in this situation.
         bool doCoveringRandomRangeTruncation = false;
+
+        // matchingMethod
+        //   The data structure used to find the classifiers in [P] that match the situation
+        //   (kSpatialIndex descends an R-tree of the conditions and visits only the classifiers
+        //    near the situation, which is faster in low dimensions when most conditions are
+        //    specific; kAuto uses it only while N and the dimension are within the crossover of
+        //    SpatialMatchIndex::IsPreferredOverScan(), and the scan above it)
+        enum class MatchingMethod
+        {
+            kScan,
+            kSpatialIndex,
+            kAuto,
+        };
+        MatchingMethod matchingMethod = MatchingMethod::kScan;
+
+        // matchSetCacheSize
+        //   The memory limit in bytes of the cache of the classifiers matching each
+        //   situation (set "0" to disable the cache)
+        //   Recommended: "0" unless the same situations appear repeatedly (e.g., the
+        //                rows of a dataset)
+        std::size_t matchSetCacheSize = 0;
+
+        // populationChunkSize
+        //   The number of slots of [P] allocated at once when [P] grows (set "0" to
+        //   grow the capacity geometrically)
+        std::size_t populationChunkSize = 0;
+
+        // useHugePages
+        //   Whether to back the per-classifier arrays of [P] with transparent huge
+        //   pages (madvise(MADV_HUGEPAGE); ignored on other platforms than Linux)
+        //   Recommended: "true" for populations of tens of thousands of classifiers
+        bool useHugePages = false;
+
+        // preallocate
+        //   Whether to allocate [P] and the working buffers for N + max(2, the number of actions)
+        //   classifiers (the most [P] holds during a step) in advance, so that explore() and
+        //   reward() perform no heap allocation once the first classifier is generated (except
+        //   for the match set cache)
+        bool preallocate = false;
+
+        // partitionByAction
+        //   Whether to group the classifiers in [M] by action, so that [A] and the
+        //   prediction array are taken from each group without testing the action of
+        //   every classifier in [M] (the results do not change)
+        //   Recommended: "true" for problems with many actions (e.g., multi-class
+        //                datasets)
+        bool partitionByAction = false;
+
+        // randomEngine
+        //   The pseudo-random number engine
+        //   (kXoshiro256PlusPlus and kPCG64 are faster than kMT19937)
+        RandomEngineType randomEngine = RandomEngineType::kMT19937;
+
+        // seed
+        //   The seed of the pseudo-random number engine (a nondeterministic seed is
+        //   used if it is not specified)
+        std::optional<std::uint64_t> seed;
     };
 
 }
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint> // std::uint16_t
+
+namespace xcspp::xcsr
+{
+
+    // Precision of the symbol values of XCSR conditions
+    enum class XCSRPrecision
+    {
+        kDouble, // 64-bit floating point (no rounding)
+        kFloat,  // 32-bit floating point
+        kUInt16, // 16-bit fixed point with 65536 levels over [min-value, max-value]
+    };
+
+    // Direction of the rounding of a symbol value
+    enum class SymbolRounding
+    {
+        kNearest,
+        kDown,
+        kUp,
+    };
+
+    // Rounding of symbol values to the precision of the conditions
+    //   With kUInt16, values are rounded to the grid minValue + k * step and CSR spreads to k * step,
+    //   where step = (maxValue - minValue) / 65535. The values are still held in double.
+    class SymbolQuantizer
+    {
+    public:
+        // The largest level of kUInt16
+        static constexpr double kMaxLevel = 65535.0;
+
+    private:
+        XCSRPrecision m_precision;
+        double m_minValue;
+        double m_step;
+
+        double roundOnGrid(double value, double origin, SymbolRounding rounding) const;
+
+    public:
+        // Constructor
+        SymbolQuantizer(XCSRPrecision precision, double minValue, double maxValue);
+
+        // Round a value on the scale of the input (centers and bounds)
+        double roundValue(double value, SymbolRounding rounding) const;
+
+        // Round a CSR spread
+        double roundSpread(double spread, SymbolRounding rounding) const;
+
+        // Returns the level of the value for the 16-bit matching, clamp(floor((value - minValue) / step), 0, 65535)
+        //   (Monotonic, so that "lower <= x" implies "level(lower) <= level(x)")
+        std::uint16_t levelOf(double value) const noexcept;
+
+        // Returns the largest float not greater than the value
+        static float FloatDown(double value) noexcept;
+
+        // Returns the smallest float not less than the value
+        static float FloatUp(double value) noexcept;
+
+        XCSRPrecision precision() const noexcept
+        {
+            return m_precision;
+        }
+    };
+
+}
@@ -1,5 +1,8 @@
 #pragma once
+#include <algorithm> // std::min, std::max, std::clamp
 #include <cmath>
+#include <stdexcept>
+#include <type_traits> // std::integral_constant
 #include "xcspp/util/random.hpp"
 
 namespace xcspp::xcsr
@@ -13,6 +16,35 @@ namespace xcspp::xcsr
         kUBR, // Unordered-Bound Representation [ min(p,q) , max(p,q) )
     };
 
+    // Type which carries the representation as a compile-time constant
+    template <XCSRRepr Repr>
+    using XCSRReprConstant = std::integral_constant<XCSRRepr, Repr>;
+
+    // Call func with XCSRReprConstant<repr>
+    //   The branch on the representation is taken once here, so that the loops in func are compiled for
+    //   each representation without a branch per symbol, e.g.:
+    //     VisitXCSRRepr(repr, [&](auto reprConstant) {
+    //         constexpr XCSRRepr kRepr = decltype(reprConstant)::value;
+    //         for (...) { ... GetLowerBound<kRepr>(symbol) ... }
+    //     });
+    template <typename Func>
+    decltype(auto) VisitXCSRRepr(XCSRRepr repr, Func && func)
+    {
+        switch (repr)
+        {
+        case XCSRRepr::kCSR:
+            return func(XCSRReprConstant<XCSRRepr::kCSR>{});
+
+        case XCSRRepr::kOBR:
+            return func(XCSRReprConstant<XCSRRepr::kOBR>{});
+
+        case XCSRRepr::kUBR:
+            return func(XCSRReprConstant<XCSRRepr::kUBR>{});
+        };
+
+        throw std::invalid_argument("VisitXCSRRepr() received an unknown representation.");
+    }
+
     // Forward declarations for function arguments
     class Symbol;
     struct XCSRParams;
@@ -29,4 +61,72 @@ namespace xcspp::xcsr
 
     Symbol MakeCoveringSymbol(double inputValue, const XCSRParams *pParams, Random & random);
 
+    // --- The same functions for the representation given at compile time ---
+
+    template <XCSRRepr Repr, typename SymbolType>
+    double GetLowerBound(const SymbolType & s) noexcept
+    {
+        if constexpr (Repr == XCSRRepr::kCSR)
+        {
+            return s.v1 - s.v2;
+        }
+        else if constexpr (Repr == XCSRRepr::kOBR)
+        {
+            return s.v1;
+        }
+        else
+        {
+            return std::min(s.v1, s.v2);
+        }
+    }
+
+    template <XCSRRepr Repr, typename SymbolType>
+    double GetUpperBound(const SymbolType & s) noexcept
+    {
+        if constexpr (Repr == XCSRRepr::kCSR)
+        {
+            return s.v1 + s.v2;
+        }
+        else if constexpr (Repr == XCSRRepr::kOBR)
+        {
+            return s.v2;
+        }
+        else
+        {
+            return std::max(s.v1, s.v2);
+        }
+    }
+
+    template <XCSRRepr Repr>
+    double ClampSymbolValue1(double v1, double minValue, double maxValue, bool doRangeRestriction)
+    {
+        if constexpr (Repr == XCSRRepr::kCSR)
+        {
+            return std::clamp(v1, minValue, maxValue);
+        }
+        else
+        {
+            // OBR and UBR
+            return doRangeRestriction ? std::clamp(v1, minValue, maxValue) : v1;
+        }
+    }
+
+    template <XCSRRepr Repr>
+    double ClampSymbolValue2(double v2, double minValue, double maxValue, bool doRangeRestriction)
+    {
+        if constexpr (Repr == XCSRRepr::kCSR)
+        {
+            return std::max(v2, 0.0);
+        }
+        else
+        {
+            // OBR and UBR
+            return doRangeRestriction ? std::clamp(v2, minValue, maxValue) : v2;
+        }
+    }
+
+    // (Instantiated for all representations in xcsr_repr.cpp)
+    template <XCSRRepr Repr>
+    Symbol MakeCoveringSymbol(double inputValue, const XCSRParams *pParams, Random & random);
+
 }
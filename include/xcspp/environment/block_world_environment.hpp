@@ -2,7 +2,9 @@
 #include <string>
 #include <vector>
 #include <unordered_set>
+#include <optional>
 #include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
 
 #include "ienvironment.hpp"
 #include "xcspp/util/random.hpp"
@@ -62,7 +64,8 @@ namespace xcspp
 
     public:
         // Constructor
-        BlockWorldEnvironment(const std::string & mapFilename, std::size_t maxStep, bool threeBitMode, bool allowsDiagonalAction);
+        // (A nondeterministic seed is used for the initial positions if the seed is not specified)
+        BlockWorldEnvironment(const std::string & mapFilename, std::size_t maxStep, bool threeBitMode, bool allowsDiagonalAction, std::optional<std::uint64_t> seed = std::nullopt);
 
         // Destructor
         virtual ~BlockWorldEnvironment() = default;
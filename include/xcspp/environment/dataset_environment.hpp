@@ -1,7 +1,9 @@
 #pragma once
 #include <vector>
 #include <unordered_set>
+#include <optional>
 #include <cstddef>
+#include <cstdint> // std::uint64_t
 
 #include "ienvironment.hpp"
 #include "xcspp/util/random.hpp"
@@ -26,7 +28,8 @@ namespace xcspp
         std::size_t loadNext();
 
     public:
-        BasicDatasetEnvironment(const BasicDataset<T> & dataset, bool chooseRandom = true);
+        // (A nondeterministic seed is used for choosing the samples if the seed is not specified)
+        BasicDatasetEnvironment(const BasicDataset<T> & dataset, bool chooseRandom = true, std::optional<std::uint64_t> seed = std::nullopt);
 
         virtual ~BasicDatasetEnvironment() = default;
 
@@ -83,12 +86,13 @@ namespace xcspp
     }
 
     template <typename T>
-    BasicDatasetEnvironment<T>::BasicDatasetEnvironment(const BasicDataset<T> & dataset, bool chooseRandom)
+    BasicDatasetEnvironment<T>::BasicDatasetEnvironment(const BasicDataset<T> & dataset, bool chooseRandom, std::optional<std::uint64_t> seed)
         : m_dataset(dataset)
         , m_availableActions(detail::GetAvailableActionsInDataset(dataset))
         , m_nextIdx(0)
         , m_chooseRandom(chooseRandom)
         , m_isEndOfProblem(false)
+        , m_random(seed)
     {
         if (m_dataset.situations.size() != m_dataset.actions.size())
         {
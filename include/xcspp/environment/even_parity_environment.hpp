@@ -1,6 +1,8 @@
 #pragma once
 #include <vector>
+#include <optional>
 #include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
 
 #include "ienvironment.hpp"
 #include "xcspp/util/random.hpp"
@@ -18,7 +20,8 @@ namespace xcspp
 
     public:
         // Constructor
-        explicit EvenParityEnvironment(std::size_t length);
+        // (A nondeterministic seed is used for the situations if the seed is not specified)
+        explicit EvenParityEnvironment(std::size_t length, std::optional<std::uint64_t> seed = std::nullopt);
 
         // Destructor
         virtual ~EvenParityEnvironment() = default;
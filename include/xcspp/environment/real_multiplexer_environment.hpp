@@ -1,6 +1,8 @@
 #pragma once
 #include <vector>
+#include <optional>
 #include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
 
 #include "ienvironment.hpp"
 #include "xcspp/util/random.hpp"
@@ -20,7 +22,8 @@ namespace xcspp
     public:
         // Constructor
         // (Set imbalanceLevel to higher than 0 for imbalanced multiplexer problems)
-        explicit RealMultiplexerEnvironment(std::size_t length, unsigned int imbalanceLevel = 0, double binaryThreshold = 0.5);
+        // (A nondeterministic seed is used for the situations if the seed is not specified)
+        explicit RealMultiplexerEnvironment(std::size_t length, unsigned int imbalanceLevel = 0, double binaryThreshold = 0.5, std::optional<std::uint64_t> seed = std::nullopt);
 
         // Destructor
         virtual ~RealMultiplexerEnvironment() = default;
@@ -0,0 +1,81 @@
+#pragma once
+#include <algorithm> // std::sort, std::lower_bound
+#include <unordered_set>
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int64_t, std::uint32_t
+
+namespace xcspp
+{
+
+    // Dense ordinals of the available actions
+    //   The actions are numbered from 0 in ascending order, so that the values of each action (e.g.,
+    //   the prediction array) are kept in a contiguous array instead of a hash map. If the actions lie
+    //   in a narrow range (e.g., class labels 0, ..., K - 1), the ordinal of an action is looked up in
+    //   a table indexed by the action, and otherwise by binary search.
+    class ActionOrdinals
+    {
+    private:
+        // The table is used if its size is at most kMaxTableSizeRatio * (the number of actions) + kMaxTableSizeMargin
+        static constexpr std::int64_t kMaxTableSizeRatio = 4;
+        static constexpr std::int64_t kMaxTableSizeMargin = 64;
+
+        // Available actions in ascending order (indexed by ordinal)
+        std::vector<int> m_actions;
+
+        // Ordinals of the values from the smallest action (size() for the values that are not available)
+        // (empty if the range of the actions is too wide)
+        std::vector<std::uint32_t> m_table;
+
+    public:
+        // Constructor
+        explicit ActionOrdinals(const std::unordered_set<int> & availableActions)
+            : m_actions(availableActions.begin(), availableActions.end())
+        {
+            std::sort(m_actions.begin(), m_actions.end());
+
+            if (!m_actions.empty())
+            {
+                const std::int64_t range = std::int64_t{ m_actions.back() } - m_actions.front() + 1;
+                if (range <= static_cast<std::int64_t>(m_actions.size()) * kMaxTableSizeRatio + kMaxTableSizeMargin)
+                {
+                    m_table.assign(static_cast<std::size_t>(range), static_cast<std::uint32_t>(m_actions.size()));
+                    for (std::size_t i = 0; i < m_actions.size(); ++i)
+                    {
+                        m_table[static_cast<std::size_t>(std::int64_t{ m_actions[i] } - m_actions.front())] = static_cast<std::uint32_t>(i);
+                    }
+                }
+            }
+        }
+
+        // Returns the ordinal of the action (size() if the action is not available)
+        std::size_t ordinalOf(int action) const noexcept
+        {
+            if (!m_table.empty())
+            {
+                const std::int64_t offset = std::int64_t{ action } - m_actions.front();
+                return (offset >= 0 && offset < static_cast<std::int64_t>(m_table.size())) ? m_table[static_cast<std::size_t>(offset)] : m_actions.size();
+            }
+
+            const auto it = std::lower_bound(m_actions.begin(), m_actions.end(), action);
+            return (it != m_actions.end() && *it == action) ? static_cast<std::size_t>(it - m_actions.begin()) : m_actions.size();
+        }
+
+        int action(std::size_t ordinal) const
+        {
+            return m_actions[ordinal];
+        }
+
+        // Available actions in ascending order
+        const std::vector<int> & actions() const noexcept
+        {
+            return m_actions;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_actions.size();
+        }
+    };
+
+}
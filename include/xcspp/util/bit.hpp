@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint> // std::uint64_t
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace xcspp
+{
+
+    // Bit manipulation utility for bit-packed representations
+    namespace Bit
+    {
+        // Returns the number of bits set to 1
+        inline int PopCount(std::uint64_t x)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcountll(x);
+#else
+            x = x - ((x >> 1) & 0x5555555555555555ULL);
+            x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+            x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+        }
+
+        // Returns the index of the lowest bit set to 1
+        // (make sure to confirm "x != 0" before calling this)
+        inline int CountTrailingZeros(std::uint64_t x)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            unsigned long idx;
+            _BitScanForward64(&idx, x);
+            return static_cast<int>(idx);
+#else
+            int count = 0;
+            while ((x & 1) == 0)
+            {
+                x >>= 1;
+                ++count;
+            }
+            return count;
+#endif
+        }
+
+        // Returns the mask whose bits in the range [first, last) are set to 1 (0 <= first <= last <= 64)
+        inline std::uint64_t RangeMask(unsigned int first, unsigned int last)
+        {
+            const std::uint64_t upper = (last >= 64) ? ~std::uint64_t{ 0 } : ((std::uint64_t{ 1 } << last) - 1);
+            const std::uint64_t lower = (first >= 64) ? ~std::uint64_t{ 0 } : ((std::uint64_t{ 1 } << first) - 1);
+            return upper & ~lower;
+        }
+    }
+
+}
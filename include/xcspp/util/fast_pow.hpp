@@ -0,0 +1,40 @@
+#pragma once
+#include <cmath> // std::pow, std::floor
+
+namespace xcspp
+{
+
+    // The largest exponent calculated by repeated squaring
+    constexpr double kMaxFastPowExponent = 64.0;
+
+    // Whether FastPow() calculates the power by multiplications for the exponent
+    inline bool IsFastPowExponent(double exponent) noexcept
+    {
+        return exponent >= 0.0 && exponent <= kMaxFastPowExponent && exponent == std::floor(exponent);
+    }
+
+    // Returns base^exponent
+    //   If the exponent is a small non-negative integer (e.g., nu = 5 in the accuracy of XCS), the power
+    //   is calculated by repeated squaring, which needs only a few multiplications instead of std::pow().
+    //   Code which calculates the powers of many bases at once must multiply in the same order to get
+    //   the same results.
+    inline double FastPow(double base, double exponent)
+    {
+        if (!IsFastPowExponent(exponent))
+        {
+            return std::pow(base, exponent);
+        }
+
+        double result = 1.0;
+        for (auto n = static_cast<unsigned int>(exponent); n > 0; n >>= 1)
+        {
+            if (n & 1)
+            {
+                result *= base;
+            }
+            base *= base;
+        }
+        return result;
+    }
+
+}
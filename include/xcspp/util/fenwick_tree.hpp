@@ -0,0 +1,126 @@
+#pragma once
+#include <vector>
+#include <cstddef> // std::size_t
+
+namespace xcspp
+{
+
+    // Fenwick tree (binary indexed tree) of non-negative weights
+    //   Each weight can be changed and a weight can be selected by a cumulative value in O(log n),
+    //   which makes a roulette wheel that does not need to be rebuilt for each spin.
+    template <typename T>
+    class FenwickTree
+    {
+    private:
+        // Weights (indexed by 0-based index)
+        std::vector<T> m_values;
+
+        // Partial sums (m_tree[i - 1] is the sum of the weights in [i - lowbit(i), i))
+        std::vector<T> m_tree;
+
+        static std::size_t LowBit(std::size_t i)
+        {
+            return i & (~i + 1);
+        }
+
+        // Returns the sum of the weights in [0, count)
+        T prefixSum(std::size_t count) const
+        {
+            T sum = 0;
+            for (std::size_t i = count; i > 0; i -= LowBit(i))
+            {
+                sum += m_tree[i - 1];
+            }
+            return sum;
+        }
+
+    public:
+        // Change the number of weights (new weights are zero)
+        void resize(std::size_t size)
+        {
+            const std::size_t oldSize = m_values.size();
+            m_values.resize(size, 0);
+            m_tree.resize(size, 0);
+
+            // New nodes may cover the old weights
+            for (std::size_t i = oldSize + 1; i <= size && oldSize > 0; ++i)
+            {
+                const std::size_t first = i - LowBit(i);
+                if (first < oldSize)
+                {
+                    m_tree[i - 1] = prefixSum(oldSize) - prefixSum(first);
+                }
+            }
+        }
+
+        void clear()
+        {
+            m_values.clear();
+            m_tree.clear();
+        }
+
+        // Set the weight at the index
+        void set(std::size_t idx, T value)
+        {
+            const T diff = value - m_values[idx];
+            m_values[idx] = value;
+            for (std::size_t i = idx + 1; i <= m_tree.size(); i += LowBit(i))
+            {
+                m_tree[i - 1] += diff;
+            }
+        }
+
+        // Recompute the partial sums from the weights in O(n)
+        // (use this to discard the rounding errors accumulated by set())
+        void rebuild()
+        {
+            m_tree = m_values;
+            for (std::size_t i = 1; i <= m_tree.size(); ++i)
+            {
+                const std::size_t parent = i + LowBit(i);
+                if (parent <= m_tree.size())
+                {
+                    m_tree[parent - 1] += m_tree[i - 1];
+                }
+            }
+        }
+
+        T value(std::size_t idx) const
+        {
+            return m_values[idx];
+        }
+
+        T sum() const
+        {
+            return prefixSum(m_tree.size());
+        }
+
+        // Returns the first index whose cumulative weight (the sum of the weights up to the index) is
+        // greater than the value, or size() if there is no such index
+        std::size_t find(T value) const
+        {
+            std::size_t step = 1;
+            while (step * 2 <= m_tree.size())
+            {
+                step *= 2;
+            }
+
+            std::size_t count = 0;
+            for (; step > 0; step /= 2)
+            {
+                if (count + step <= m_tree.size() && m_tree[count + step - 1] <= value)
+                {
+                    count += step;
+                    value -= m_tree[count - 1];
+                }
+            }
+            return count;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_values.size();
+        }
+    };
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstdint> // std::uint64_t
+
+namespace xcspp
+{
+
+    // Hash utility for the keys of classifiers
+    namespace Hash
+    {
+        // Returns the 64-bit value whose bits depend on all bits of x (the finalizer of SplitMix64)
+        // (Mix64(0) is 0, so add a constant to x if the zero input needs a non-zero hash.)
+        inline std::uint64_t Mix64(std::uint64_t x)
+        {
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            return x ^ (x >> 31);
+        }
+
+        // Returns the hash combining the seed with the value
+        inline std::uint64_t Combine(std::uint64_t seed, std::uint64_t value)
+        {
+            return Mix64(seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2)));
+        }
+    }
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef> // std::size_t
+#include <cstdlib> // std::aligned_alloc, std::free
+#include <new> // std::bad_alloc
+
+#if defined(__linux__)
+#include <sys/mman.h> // madvise
+#endif
+
+namespace xcspp
+{
+
+    // Allocator which optionally backs large arrays with transparent huge pages
+    //   If huge pages are requested, allocations of at least kHugePageSize bytes are aligned to the
+    //   huge page boundary and marked with madvise(MADV_HUGEPAGE), which reduces the TLB misses of
+    //   scans over large arrays. On other platforms than Linux, the request is ignored.
+    template <typename T>
+    class PageAllocator
+    {
+    private:
+        bool m_useHugePages;
+
+        template <typename U>
+        friend class PageAllocator;
+
+    public:
+        using value_type = T;
+
+        static constexpr std::size_t kHugePageSize = std::size_t{ 2 } * 1024 * 1024;
+
+        explicit PageAllocator(bool useHugePages = false) noexcept : m_useHugePages(useHugePages) {}
+
+        template <typename U>
+        PageAllocator(const PageAllocator<U> & other) noexcept : m_useHugePages(other.m_useHugePages) {}
+
+        bool usesHugePages() const noexcept
+        {
+            return m_useHugePages;
+        }
+
+        T *allocate(std::size_t n)
+        {
+            const std::size_t bytes = n * sizeof(T);
+#if defined(__linux__)
+            if (m_useHugePages && bytes >= kHugePageSize)
+            {
+                const std::size_t alignedBytes = (bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+                void *p = std::aligned_alloc(kHugePageSize, alignedBytes);
+                if (p == nullptr)
+                {
+                    throw std::bad_alloc();
+                }
+                madvise(p, alignedBytes, MADV_HUGEPAGE); // only a hint (fails silently without THP support)
+                return static_cast<T *>(p);
+            }
+#endif
+            return static_cast<T *>(::operator new(bytes));
+        }
+
+        void deallocate(T *p, std::size_t n) noexcept
+        {
+#if defined(__linux__)
+            if (m_useHugePages && n * sizeof(T) >= kHugePageSize)
+            {
+                std::free(p);
+                return;
+            }
+#else
+            static_cast<void>(n);
+#endif
+            ::operator delete(p);
+        }
+
+        template <typename U>
+        friend bool operator== (const PageAllocator & lhs, const PageAllocator<U> & rhs) noexcept
+        {
+            return lhs.m_useHugePages == rhs.m_useHugePages;
+        }
+
+        template <typename U>
+        friend bool operator!= (const PageAllocator & lhs, const PageAllocator<U> & rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+    };
+
+}
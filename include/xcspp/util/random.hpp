@@ -3,41 +3,188 @@
 #include <vector>
 #include <set>
 #include <unordered_set>
+#include <array>
+#include <variant>
+#include <iterator> // std::next
 #include <limits>
-#include <cstddef> // std::size_t
+#include <optional>
+#include <stdexcept>
+#include <type_traits> // std::make_unsigned_t, std::decay_t, std::is_same_v
+#include <cstddef> // std::size_t, std::ptrdiff_t
 #include <cstdint> // std::uint32_t, std::uint64_t
+#include <cmath> // std::expm1, std::log1p, std::log, std::floor
 #include <algorithm>
 
+#include "random_engine.hpp"
+
 namespace xcspp
 {
 
     // Random utility
+    //   The engine is chosen at construction. The random bits are generated in blocks of kBlockSize 64-bit
+    //   words, so that the engine is dispatched once per block and the other functions only convert the
+    //   words into the values of each distribution.
     class Random
     {
     private:
-        std::mt19937 m_engine;
+        static constexpr std::size_t kBlockSize = 64;
+
+        std::variant<std::mt19937, Xoshiro256PlusPlus, PCG64> m_engine;
+
+        std::array<std::uint64_t, kBlockSize> m_block;
+
+        // The position of the next unused word in m_block
+        std::size_t m_blockPos;
+
+        static std::variant<std::mt19937, Xoshiro256PlusPlus, PCG64> MakeEngine(RandomEngineType engineType, std::uint64_t seed)
+        {
+            switch (engineType)
+            {
+            case RandomEngineType::kMT19937:
+                if (seed <= std::numeric_limits<std::uint32_t>::max())
+                {
+                    return std::mt19937(static_cast<std::uint32_t>(seed));
+                }
+                else
+                {
+                    std::seed_seq seedSeq{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) };
+                    return std::mt19937(seedSeq);
+                }
+
+            case RandomEngineType::kXoshiro256PlusPlus:
+                return Xoshiro256PlusPlus(seed);
+
+            case RandomEngineType::kPCG64:
+                return PCG64(seed);
+            }
+            throw std::invalid_argument("Random::MakeEngine() received an unknown engine type.");
+        }
+
+        static std::uint64_t NondeterministicSeed()
+        {
+            std::random_device randomDevice;
+            return (std::uint64_t{ randomDevice() } << 32) | randomDevice();
+        }
+
+        void fillBlock()
+        {
+            std::visit([this](auto & engine) {
+                using Engine = std::decay_t<decltype(engine)>;
+                if constexpr (std::is_same_v<Engine, std::mt19937>)
+                {
+                    // Two 32-bit outputs for each word
+                    for (auto & word : m_block)
+                    {
+                        const std::uint64_t high = engine();
+                        word = (high << 32) | engine();
+                    }
+                }
+                else
+                {
+                    for (auto & word : m_block)
+                    {
+                        word = engine();
+                    }
+                }
+            }, m_engine);
+            m_blockPos = 0;
+        }
 
     public:
-        Random()
-            : m_engine(std::random_device{}())
+        // Constructor with a nondeterministic seed
+        explicit Random(RandomEngineType engineType = RandomEngineType::kMT19937)
+            : Random(NondeterministicSeed(), engineType)
         {
         }
 
-        explicit Random(std::uint32_t seed)
-            : m_engine(seed)
+        explicit Random(std::uint64_t seed, RandomEngineType engineType = RandomEngineType::kMT19937)
+            : m_engine(MakeEngine(engineType, seed))
+            , m_block{}
+            , m_blockPos(kBlockSize)
         {
         }
 
+        // Constructor with the seed if given, and with a nondeterministic seed otherwise
+        explicit Random(const std::optional<std::uint64_t> & seed, RandomEngineType engineType = RandomEngineType::kMT19937)
+            : Random(seed.has_value() ? Random(*seed, engineType) : Random(engineType))
+        {
+        }
+
+        // Returns 64 uniformly random bits
+        std::uint64_t nextBits()
+        {
+            if (m_blockPos == kBlockSize)
+            {
+                fillBlock();
+            }
+            return m_block[m_blockPos++];
+        }
+
+        // Returns a value in [min, max) (the upper 53 bits of a word are used)
         template <typename T = double>
         T nextDouble(T min = 0.0, T max = 1.0)
         {
-            return std::uniform_real_distribution<T>(min, max)(m_engine);
+            const double unit = static_cast<double>(nextBits() >> 11) * 0x1.0p-53;
+            return min + static_cast<T>(unit * (static_cast<double>(max) - static_cast<double>(min)));
         }
 
+        // Returns a value in [min, max] (a word below 2^64 mod (max - min + 1) is rejected to avoid the bias)
         template <typename T = int>
         T nextInt(T min, T max)
         {
-            return std::uniform_int_distribution<T>(min, max)(m_engine);
+            using U = std::make_unsigned_t<T>;
+            const std::uint64_t range = static_cast<std::uint64_t>(static_cast<U>(max) - static_cast<U>(min));
+            if (range == std::numeric_limits<std::uint64_t>::max())
+            {
+                return static_cast<T>(nextBits());
+            }
+
+            const std::uint64_t count = range + 1;
+            const std::uint64_t threshold = (0 - count) % count;
+            std::uint64_t bits;
+            do
+            {
+                bits = nextBits();
+            } while (bits < threshold);
+            return static_cast<T>(static_cast<U>(min) + static_cast<U>(bits % count));
+        }
+
+        // Calls func(i) for each index i (in ascending order) of the successful ones in the given number of
+        // Bernoulli trials with the probability
+        //   The number of failures before each success is drawn from the geometric distribution, so that one
+        //   random number is used for each success instead of one for each trial. The distribution of the
+        //   successful indices is the same as drawing for each trial.
+        template <typename Function>
+        void forEachBernoulliSuccess(std::size_t trialCount, double probability, Function && func)
+        {
+            if (!(probability > 0.0))
+            {
+                return;
+            }
+
+            if (probability >= 1.0)
+            {
+                for (std::size_t i = 0; i < trialCount; ++i)
+                {
+                    func(i);
+                }
+                return;
+            }
+
+            const double logFailureProbability = std::log1p(-probability);
+            std::size_t i = 0;
+            while (i < trialCount)
+            {
+                // 1.0 - nextDouble() is in (0, 1]
+                const double failureCount = std::floor(std::log(1.0 - nextDouble()) / logFailureProbability);
+                if (failureCount >= static_cast<double>(trialCount - i))
+                {
+                    break;
+                }
+                i += static_cast<std::size_t>(failureCount);
+                func(i);
+                ++i;
+            }
         }
 
         template <typename T>
@@ -54,30 +201,34 @@ namespace xcspp
         template <typename T>
         T chooseFrom(const std::set<T> & container)
         {
-            // Create temporary std::vector from std::set and call the first chooseFrom function
-            std::vector<T> vec(container.cbegin(), container.cend());
-            return chooseFrom(vec);
+            if (container.empty())
+            {
+                throw std::invalid_argument("Random::chooseFrom() received an empty container.");
+            }
+
+            // Advance to the chosen element instead of copying the set
+            return *std::next(container.cbegin(), static_cast<std::ptrdiff_t>(nextInt<std::size_t>(0, container.size() - 1)));
         }
 
         template <typename T>
         T chooseFrom(const std::unordered_set<T> & container)
         {
-            // Create temporary std::vector from std::unordered_set and call the first chooseFrom function
-            std::vector<T> vec(container.cbegin(), container.cend());
-            return chooseFrom(vec);
+            if (container.empty())
+            {
+                throw std::invalid_argument("Random::chooseFrom() received an empty container.");
+            }
+
+            // Advance to the chosen element instead of copying the set
+            return *std::next(container.cbegin(), static_cast<std::ptrdiff_t>(nextInt<std::size_t>(0, container.size() - 1)));
         }
 
         template <typename T>
         std::size_t rouletteWheelSelection(const std::vector<T> & container)
         {
-            // Prepare a roulette wheel by the weights
             T sum = 0;
-            std::vector<T> rouletteWheel;
-            rouletteWheel.reserve(container.size());
             for (const auto & value : container)
             {
                 sum += value;
-                rouletteWheel.push_back(sum);
             }
 
             if (sum <= static_cast<T>(0))
@@ -86,11 +237,20 @@ namespace xcspp
             }
 
             // Spin the roulette wheel
+            //   (The cumulative weights are summed up in the same order as the total, so the first one
+            //   not less than the value is found without storing them.)
             const T randValue = nextDouble<T>(0, sum);
-            const auto it = std::lower_bound(std::cbegin(rouletteWheel), std::cend(rouletteWheel), randValue);
-
-            // Returns index of selected item
-            return std::distance(std::cbegin(rouletteWheel), it);
+            T cumulativeWeight = 0;
+            for (std::size_t i = 0; i < container.size(); ++i)
+            {
+                cumulativeWeight += container[i];
+                if (cumulativeWeight >= randValue)
+                {
+                    // Returns index of selected item
+                    return i;
+                }
+            }
+            return container.size() - 1;
         }
 
         template <typename T>
@@ -180,14 +340,14 @@ namespace xcspp
 
                 if (best < weight / numerosity)
                 {
-                    for (std::uint64_t j = 0; j < numerosity; ++j)
+                    // Whether at least one of the micro-classifiers takes part in the tournament
+                    //   (A single draw with the probability 1 - (1 - tau)^numerosity, which is the same as
+                    //   drawing for each micro-classifier)
+                    const double participationProbability = -std::expm1(static_cast<double>(numerosity) * std::log1p(-tau));
+                    if (nextDouble() < participationProbability)
                     {
-                        if (nextDouble() < tau)
-                        {
-                            best = weight / numerosity;
-                            selectedIdx = i;
-                            break;
-                        }
+                        best = weight / numerosity;
+                        selectedIdx = i;
                     }
                 }
             }
@@ -203,4 +363,61 @@ namespace xcspp
         }
     };
 
+    // Roulette wheel which is built once and spun several times
+    //   The cumulative weights are kept, so that each spin is a binary search. The selected index is the
+    //   same as Random::rouletteWheelSelection() for the same weights and random number.
+    template <typename T = double>
+    class RouletteWheel
+    {
+    private:
+        std::vector<T> m_cumulativeWeights;
+
+    public:
+        void clear() noexcept
+        {
+            m_cumulativeWeights.clear();
+        }
+
+        void reserve(std::size_t capacity)
+        {
+            m_cumulativeWeights.reserve(capacity);
+        }
+
+        // Add an item with the weight to the end
+        void push_back(T weight)
+        {
+            m_cumulativeWeights.push_back(m_cumulativeWeights.empty() ? weight : m_cumulativeWeights.back() + weight);
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_cumulativeWeights.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_cumulativeWeights.empty();
+        }
+
+        T sum() const noexcept
+        {
+            return m_cumulativeWeights.empty() ? static_cast<T>(0) : m_cumulativeWeights.back();
+        }
+
+        // Returns the index of the selected item
+        std::size_t spin(Random & random) const
+        {
+            const T weightSum = sum();
+            if (weightSum <= static_cast<T>(0))
+            {
+                throw std::runtime_error("RouletteWheel::spin() generated an invalid weight sum.");
+            }
+
+            // The first item whose cumulative weight is not less than the value
+            const T randValue = random.nextDouble<T>(0, weightSum);
+            const auto it = std::lower_bound(m_cumulativeWeights.begin(), m_cumulativeWeights.end(), randValue);
+            return (it != m_cumulativeWeights.end()) ? static_cast<std::size_t>(it - m_cumulativeWeights.begin()) : m_cumulativeWeights.size() - 1;
+        }
+    };
+
 }
@@ -0,0 +1,174 @@
+#pragma once
+#include <array>
+#include <limits>
+#include <cstdint> // std::uint32_t, std::uint64_t
+
+namespace xcspp
+{
+
+    // Pseudo-random number engines which can be chosen for Random
+    enum class RandomEngineType
+    {
+        // std::mt19937 (Mersenne Twister; the standard engine used so far)
+        kMT19937,
+
+        // xoshiro256++ [Blackman & Vigna, 2019]
+        kXoshiro256PlusPlus,
+
+        // PCG64 (PCG XSL-RR 128/64) [O'Neill, 2014]
+        kPCG64,
+    };
+
+    namespace RandomEngineDetail
+    {
+        // SplitMix64, which expands a seed into the state of the other engines
+        inline std::uint64_t SplitMix64(std::uint64_t & state) noexcept
+        {
+            std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        inline std::uint64_t RotateLeft(std::uint64_t x, unsigned int k) noexcept
+        {
+            return (x << (k & 63)) | (x >> ((64 - k) & 63));
+        }
+
+        inline std::uint64_t RotateRight(std::uint64_t x, unsigned int k) noexcept
+        {
+            return (x >> (k & 63)) | (x << ((64 - k) & 63));
+        }
+
+        // Returns the upper 64 bits of the 128-bit product (the lower 64 bits are x * y)
+        inline std::uint64_t MultiplyHigh(std::uint64_t x, std::uint64_t y) noexcept
+        {
+            const std::uint64_t xLow = x & 0xFFFFFFFFULL;
+            const std::uint64_t xHigh = x >> 32;
+            const std::uint64_t yLow = y & 0xFFFFFFFFULL;
+            const std::uint64_t yHigh = y >> 32;
+
+            const std::uint64_t lowLow = xLow * yLow;
+            const std::uint64_t highLow = xHigh * yLow;
+            const std::uint64_t lowHigh = xLow * yHigh;
+            const std::uint64_t highHigh = xHigh * yHigh;
+
+            const std::uint64_t middle = (lowLow >> 32) + (highLow & 0xFFFFFFFFULL) + lowHigh;
+            return highHigh + (highLow >> 32) + (middle >> 32);
+        }
+    }
+
+    // xoshiro256++ (satisfies UniformRandomBitGenerator)
+    class Xoshiro256PlusPlus
+    {
+    private:
+        std::uint64_t m_state[4];
+
+    public:
+        using result_type = std::uint64_t;
+
+        explicit Xoshiro256PlusPlus(std::uint64_t seed)
+        {
+            for (auto & s : m_state)
+            {
+                s = RandomEngineDetail::SplitMix64(seed);
+            }
+        }
+
+        // Constructor with the state words (as the reference implementation; they must not be all zero)
+        explicit Xoshiro256PlusPlus(const std::array<std::uint64_t, 4> & state)
+            : m_state{ state[0], state[1], state[2], state[3] }
+        {
+        }
+
+        static constexpr result_type min() noexcept
+        {
+            return std::numeric_limits<result_type>::min();
+        }
+
+        static constexpr result_type max() noexcept
+        {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        result_type operator()() noexcept
+        {
+            const std::uint64_t result = RandomEngineDetail::RotateLeft(m_state[0] + m_state[3], 23) + m_state[0];
+            const std::uint64_t t = m_state[1] << 17;
+            m_state[2] ^= m_state[0];
+            m_state[3] ^= m_state[1];
+            m_state[1] ^= m_state[2];
+            m_state[0] ^= m_state[3];
+            m_state[2] ^= t;
+            m_state[3] = RandomEngineDetail::RotateLeft(m_state[3], 45);
+            return result;
+        }
+    };
+
+    // PCG64 with the XSL-RR output function (satisfies UniformRandomBitGenerator)
+    //   The 128-bit state is kept in two 64-bit words so as not to depend on a 128-bit integer type.
+    class PCG64
+    {
+    private:
+        static constexpr std::uint64_t kMultiplierHigh = 2549297995355413924ULL;
+        static constexpr std::uint64_t kMultiplierLow = 4865540595714422341ULL;
+
+        std::uint64_t m_stateHigh;
+        std::uint64_t m_stateLow;
+        std::uint64_t m_incrementHigh;
+        std::uint64_t m_incrementLow;
+
+        void step() noexcept
+        {
+            // state = state * multiplier + increment (mod 2^128)
+            const std::uint64_t productHigh =
+                RandomEngineDetail::MultiplyHigh(m_stateLow, kMultiplierLow) + m_stateHigh * kMultiplierLow + m_stateLow * kMultiplierHigh;
+            const std::uint64_t productLow = m_stateLow * kMultiplierLow;
+            m_stateLow = productLow + m_incrementLow;
+            m_stateHigh = productHigh + m_incrementHigh + (m_stateLow < productLow ? 1 : 0);
+        }
+
+    public:
+        using result_type = std::uint64_t;
+
+        explicit PCG64(std::uint64_t seed)
+        {
+            // The increment must be odd
+            m_incrementHigh = RandomEngineDetail::SplitMix64(seed);
+            m_incrementLow = RandomEngineDetail::SplitMix64(seed) | 1;
+            m_stateHigh = RandomEngineDetail::SplitMix64(seed);
+            m_stateLow = RandomEngineDetail::SplitMix64(seed);
+            step();
+        }
+
+        // Constructor with the 128-bit initial state and sequence (the same as pcg64_srandom_r() of the reference implementation)
+        PCG64(std::uint64_t initStateHigh, std::uint64_t initStateLow, std::uint64_t initSequenceHigh, std::uint64_t initSequenceLow)
+            : m_stateHigh(0)
+            , m_stateLow(0)
+            , m_incrementHigh((initSequenceHigh << 1) | (initSequenceLow >> 63))
+            , m_incrementLow((initSequenceLow << 1) | 1)
+        {
+            step();
+            m_stateLow += initStateLow;
+            m_stateHigh += initStateHigh + (m_stateLow < initStateLow ? 1 : 0);
+            step();
+        }
+
+        static constexpr result_type min() noexcept
+        {
+            return std::numeric_limits<result_type>::min();
+        }
+
+        static constexpr result_type max() noexcept
+        {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        result_type operator()() noexcept
+        {
+            step();
+            return RandomEngineDetail::RotateRight(m_stateHigh ^ m_stateLow, static_cast<unsigned int>(m_stateHigh >> 58));
+        }
+    };
+
+}
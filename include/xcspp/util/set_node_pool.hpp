@@ -0,0 +1,72 @@
+#pragma once
+#include <utility> // std::move
+#include <vector>
+#include <cstddef> // std::size_t
+
+namespace xcspp
+{
+
+    // Pool of the nodes of an ordered set (std::set or std::map)
+    //   Elements erased through the pool leave their nodes in the pool, and the elements inserted
+    //   through the pool take them back. The sets sharing a pool do not allocate memory as long as
+    //   the total number of their elements does not exceed the number of nodes made so far.
+    template <typename Set>
+    class SetNodePool
+    {
+    private:
+        std::vector<typename Set::node_type> m_nodes;
+
+    public:
+        // Make nodes in advance so that the pool holds at least the given number of nodes
+        void reserve(std::size_t count)
+        {
+            m_nodes.reserve(count);
+            Set set;
+            while (m_nodes.size() < count)
+            {
+                set.emplace();
+                m_nodes.push_back(set.extract(set.begin()));
+            }
+        }
+
+        void insert(Set & set, const typename Set::value_type & value)
+        {
+            if (m_nodes.empty())
+            {
+                set.insert(value);
+                return;
+            }
+
+            auto node = std::move(m_nodes.back());
+            m_nodes.pop_back();
+            node.value() = value;
+            set.insert(std::move(node));
+        }
+
+        // Remove the element equal to the key (nothing happens if there is no such element)
+        void erase(Set & set, const typename Set::key_type & key)
+        {
+            auto node = set.extract(key);
+            if (!node.empty())
+            {
+                m_nodes.push_back(std::move(node));
+            }
+        }
+
+        // Remove all elements of the set
+        void clear(Set & set)
+        {
+            while (!set.empty())
+            {
+                m_nodes.push_back(set.extract(set.begin()));
+            }
+        }
+
+        // The number of nodes in the pool
+        std::size_t size() const noexcept
+        {
+            return m_nodes.size();
+        }
+    };
+
+}
@@ -1,13 +1,18 @@
 #pragma once
 
 #include "core/xcs/action_set.hpp"
+#include "core/xcs/bit_sliced_matcher.hpp"
 #include "core/xcs/classifier.hpp"
-#include "core/xcs/classifier_ptr_set.hpp"
+#include "core/xcs/classifier_handle_set.hpp"
 #include "core/xcs/condition.hpp"
+#include "core/xcs/deletion_wheel.hpp"
 #include "core/xcs/ga.hpp"
+#include "core/xcs/inverted_match_index.hpp"
 #include "core/xcs/match_set.hpp"
+#include "core/xcs/match_set_cache.hpp"
 #include "core/xcs/population.hpp"
 #include "core/xcs/prediction_array.hpp"
+#include "core/xcs/subsumption_index.hpp"
 #include "core/xcs/symbol.hpp"
 #include "core/xcs/xcs.hpp"
 #include "core/xcs/xcs_params.hpp"
@@ -20,15 +25,22 @@ namespace xcspp
 
 #include "core/xcsr/action_set.hpp"
 #include "core/xcsr/classifier.hpp"
-#include "core/xcsr/classifier_ptr_set.hpp"
+#include "core/xcsr/classifier_handle_set.hpp"
 #include "core/xcsr/condition.hpp"
+#include "core/xcsr/deletion_wheel.hpp"
+#include "core/xcsr/interval_containment.hpp"
+#include "core/xcsr/interval_matcher.hpp"
 #include "core/xcsr/ga.hpp"
 #include "core/xcsr/match_set.hpp"
+#include "core/xcsr/match_set_cache.hpp"
 #include "core/xcsr/population.hpp"
 #include "core/xcsr/prediction_array.hpp"
+#include "core/xcsr/spatial_match_index.hpp"
+#include "core/xcsr/subsumption_index.hpp"
 #include "core/xcsr/symbol.hpp"
 #include "core/xcsr/xcsr.hpp"
 #include "core/xcsr/xcsr_params.hpp"
+#include "core/xcsr/xcsr_precision.hpp"
 #include "core/xcsr/xcsr_repr.hpp"
 
 namespace xcspp
@@ -36,6 +48,7 @@ namespace xcspp
     using xcsr::XCSR;
     using xcsr::XCSRParams;
     using xcsr::XCSRRepr;
+    using xcsr::XCSRPrecision;
 }
 
 #include "environment/ienvironment.hpp"
@@ -51,6 +64,12 @@ namespace xcspp
 #include "helper/experiment_settings.hpp"
 #include "helper/simple_moving_average.hpp"
 
+#include "util/action_ordinals.hpp"
 #include "util/csv.hpp"
 #include "util/dataset.hpp"
+#include "util/fast_pow.hpp"
+#include "util/fenwick_tree.hpp"
+#include "util/page_allocator.hpp"
 #include "util/random.hpp"
+#include "util/random_engine.hpp"
+#include "util/set_node_pool.hpp"
@@ -1,108 +1,258 @@
 #include "xcspp/core/xcs/action_set.hpp"
-#include <cmath>
+#include <cmath> // std::abs
+
+#include "xcspp/util/fast_pow.hpp"
 
 namespace xcspp::xcs
 {
 
+    void ActionSet::UpdateBuffers::resize(std::size_t size)
+    {
+        predictions.resize(size);
+        epsilons.resize(size);
+        actionSetSizes.resize(size);
+        experiences.resize(size);
+        numerosities.resize(size);
+        fitnesses.resize(size);
+        accuracies.resize(size);
+        powerBases.resize(size);
+    }
+
+    void ActionSet::UpdateBuffers::reserve(std::size_t capacity)
+    {
+        predictions.reserve(capacity);
+        epsilons.reserve(capacity);
+        actionSetSizes.reserve(capacity);
+        experiences.reserve(capacity);
+        numerosities.reserve(capacity);
+        fitnesses.reserve(capacity);
+        accuracies.reserve(capacity);
+        powerBases.reserve(capacity);
+    }
+
+    // UPDATE PREDICTION, PREDICTION ERROR AND ACTION SET SIZE ESTIMATE
+    //   (The loop has no data-dependent branch so that the compiler can vectorize it.)
+    void ActionSet::updateParameters(double p, double numerositySum)
+    {
+        auto & b = m_updateBuffers;
+        const double beta = m_pParams->beta;
+        const double averagingExperience = 1.0 / beta;
+        const bool useMAM = m_pParams->useMAM;
+
+        for (std::size_t i = 0; i < b.predictions.size(); ++i)
+        {
+            const double experience = b.experiences[i];
+
+            // Update prediction, prediction error
+            const bool usesAverage = useMAM && experience < averagingExperience;
+            const double epsilonDelta = std::abs(p - b.predictions[i]) - b.epsilons[i];
+            const double predictionDelta = p - b.predictions[i];
+            b.epsilons[i] += usesAverage ? epsilonDelta / experience : beta * epsilonDelta;
+            b.predictions[i] += usesAverage ? predictionDelta / experience : beta * predictionDelta;
+
+            // Update action set size estimate
+            const double actionSetSizeDelta = numerositySum - b.actionSetSizes[i];
+            b.actionSetSizes[i] += (experience < averagingExperience) ? actionSetSizeDelta / experience : beta * actionSetSizeDelta;
+        }
+    }
+
+    void ActionSet::updateAccuracies()
+    {
+        auto & b = m_updateBuffers;
+        const double epsilonZero = m_pParams->epsilonZero;
+        const double nu = m_pParams->nu;
+
+        // (epsilonZero / epsilon)^nu
+        if (IsFastPowExponent(nu))
+        {
+            // Repeated squaring over all members, which multiplies in the same order as FastPow()
+            for (std::size_t i = 0; i < b.epsilons.size(); ++i)
+            {
+                b.powerBases[i] = epsilonZero / b.epsilons[i];
+                b.accuracies[i] = 1.0;
+            }
+            for (auto n = static_cast<unsigned int>(nu); n > 0; n >>= 1)
+            {
+                if (n & 1)
+                {
+                    for (std::size_t i = 0; i < b.accuracies.size(); ++i)
+                    {
+                        b.accuracies[i] *= b.powerBases[i];
+                    }
+                }
+                for (std::size_t i = 0; i < b.powerBases.size(); ++i)
+                {
+                    b.powerBases[i] *= b.powerBases[i];
+                }
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < b.epsilons.size(); ++i)
+            {
+                b.accuracies[i] = FastPow(epsilonZero / b.epsilons[i], nu);
+            }
+        }
+
+        const double alpha = m_pParams->alpha;
+        for (std::size_t i = 0; i < b.accuracies.size(); ++i)
+        {
+            b.accuracies[i] = (b.epsilons[i] < epsilonZero) ? 1.0 : alpha * b.accuracies[i];
+        }
+    }
+
     // UPDATE FITNESS
     void ActionSet::updateFitness()
     {
+        auto & b = m_updateBuffers;
+
         double accuracySum = 0.0;
-        for (const auto & cl : m_set)
+        for (std::size_t i = 0; i < b.accuracies.size(); ++i)
         {
-            accuracySum += cl->accuracy() * cl->numerosity;
+            accuracySum += b.accuracies[i] * b.numerosities[i];
         }
+        m_nicheStatistics.accuracySum = accuracySum;
 
-        for (const auto & cl : m_set)
+        const double beta = m_pParams->beta;
+        for (std::size_t i = 0; i < b.fitnesses.size(); ++i)
         {
-            cl->fitness += m_pParams->beta * (cl->accuracy() * cl->numerosity / accuracySum - cl->fitness);
+            b.fitnesses[i] += beta * (b.accuracies[i] * b.numerosities[i] / accuracySum - b.fitnesses[i]);
         }
     }
 
     // DO ACTION SET SUBSUMPTION
     void ActionSet::doSubsumption(Population & population)
     {
-        ClassifierPtr cl;
-        for (const auto & c : m_set)
+        const ClassifierHandle *pSubsumer = nullptr;
+        for (const auto & handle : m_set)
         {
-            if (c->isSubsumer())
+            if (population.isSubsumer(handle.index))
             {
-                if ((cl.get() == nullptr) || c->condition.isMoreGeneral(cl->condition))
+                if ((pSubsumer == nullptr) ||
+                    (population.mayBeMoreGeneral(handle.index, pSubsumer->index) && population[handle].condition.isMoreGeneral(population[*pSubsumer].condition)))
                 {
-                    cl = c;
+                    pSubsumer = &handle;
                 }
             }
         }
 
-        if (cl.get() != nullptr)
+        if (pSubsumer != nullptr)
         {
-            std::vector<ClassifierPtr> removedClassifiers;
-            for (const auto & c : m_set)
+            const ClassifierHandle subsumer = *pSubsumer;
+            m_removedClassifiers.clear();
+            for (const auto & handle : m_set)
             {
-                // Since all classifiers in [A] should have the same action, "cl->action == c->action" check is skipped
-                if (cl->condition.isMoreGeneral(c->condition))
+                // Since all classifiers in [A] should have the same action, the action check is skipped
+                if (population[subsumer].condition.isMoreGeneral(population[handle].condition))
                 {
-                    cl->numerosity += c->numerosity;
-                    removedClassifiers.push_back(c);
+                    const std::uint64_t numerosity = population[handle].numerosity;
+                    population[subsumer].numerosity += numerosity;
+                    m_removedClassifiers.push_back(handle);
+
+                    // The micro-classifiers move to the subsumer, so the numerosity sum does not change
+                    m_nicheStatistics.timeStampSum += numerosity * population[subsumer].timeStamp;
+                    m_nicheStatistics.timeStampSum -= numerosity * population[handle].timeStamp;
+                    m_nicheStatistics.fitnessSum -= population[handle].fitness;
+                    m_nicheStatistics.accuracySum += numerosity * (population.accuracy(subsumer.index) - population.accuracy(handle.index));
                 }
             }
 
-            for (const auto & removedClassifier : removedClassifiers)
+            // Drop the removed members at once
+            for (const auto & removedClassifier : m_removedClassifiers)
             {
-                population.erase(removedClassifier);
-                m_set.erase(removedClassifier);
+                population.erase(removedClassifier.index);
             }
+            removeStaleHandles(population);
         }
     }
 
     ActionSet::ActionSet(const XCSParams *pParams, const std::unordered_set<int> & availableActions)
-        : ClassifierPtrSet(pParams, availableActions)
+        : ClassifierHandleSet(pParams, availableActions)
+        , m_hasNicheStatistics(false)
+    {
+    }
+
+    ActionSet::ActionSet(const MatchSet & matchSet, int action, const Population & population, const XCSParams *pParams, const std::unordered_set<int> & availableActions)
+        : ClassifierHandleSet(pParams, availableActions)
+        , m_hasNicheStatistics(false)
     {
+        generateSet(matchSet, action, population);
     }
 
-    ActionSet::ActionSet(const MatchSet & matchSet, int action, const XCSParams *pParams, const std::unordered_set<int> & availableActions)
-        : ClassifierPtrSet(pParams, availableActions)
+    void ActionSet::calculateNicheStatistics(const Population & population)
     {
-        generateSet(matchSet, action);
+        m_nicheStatistics = NicheStatistics();
+        for (const auto & handle : m_set)
+        {
+            const auto cl = population[handle];
+            m_nicheStatistics.numerositySum += cl.numerosity;
+            m_nicheStatistics.timeStampSum += cl.numerosity * cl.timeStamp;
+            m_nicheStatistics.fitnessSum += cl.fitness;
+            m_nicheStatistics.accuracySum += population.accuracy(handle.index) * cl.numerosity;
+        }
+        m_hasNicheStatistics = true;
     }
 
     // GENERATE ACTION SET
-    void ActionSet::generateSet(const MatchSet & matchSet, int action)
+    void ActionSet::generateSet(const MatchSet & matchSet, int action, const Population & population)
     {
-        m_set.clear();
+        clear();
+        m_hasNicheStatistics = false;
+
+        // [A] is a partition of [M] if [M] is grouped by action
+        const std::size_t ordinal = matchSet.actionOrdinals().ordinalOf(action);
+        if (matchSet.isPartitioned() && ordinal < matchSet.actionOrdinals().size())
+        {
+            assign(matchSet.partitionBegin(ordinal), matchSet.partitionEnd(ordinal));
+            return;
+        }
 
-        for (const auto & cl : matchSet)
+        for (const auto & handle : matchSet)
         {
-            if (cl->action == action)
+            if (population[handle].action == action)
             {
-                m_set.insert(cl);
+                pushBack(handle);
             }
         }
     }
 
     void ActionSet::copyTo(ActionSet & dest)
     {
-        dest.m_set = m_set;
+        dest.assign(m_set.begin(), m_set.end());
+        dest.m_hasNicheStatistics = false;
+    }
+
+    void ActionSet::reserve(std::size_t capacity)
+    {
+        ClassifierHandleSet::reserve(capacity);
+        m_removedClassifiers.reserve(capacity);
+        m_gaBuffers.reserve(capacity);
+        m_updateBuffers.reserve(capacity);
     }
 
     // RUN GA (refer to GA::Run() for the latter part)
     void ActionSet::runGA(const std::vector<int> & situation, Population & population, std::uint64_t timeStamp, Random & random)
     {
-        double numerositySum = 0.0;
-        for (const auto & cl : m_set)
+        const std::size_t size = m_set.size();
+        removeStaleHandles(population);
+        if (m_set.empty())
         {
-            numerositySum += cl->numerosity;
+            return;
         }
-        if (numerositySum <= 0.0)
+
+        // The niche statistics of update() are reused unless [A] has lost members since then
+        if (!m_hasNicheStatistics || m_set.size() != size)
         {
-            throw std::runtime_error("Invalid numerosity sum detected in ActionSet::runGA().");
+            calculateNicheStatistics(population);
         }
 
-        double averageTimeStamp = 0.0;
-        for (const auto & cl : m_set)
+        const double numerositySum = static_cast<double>(m_nicheStatistics.numerositySum);
+        if (numerositySum <= 0.0)
         {
-            averageTimeStamp += cl->timeStamp / numerositySum * cl->numerosity;
+            throw std::runtime_error("Invalid numerosity sum detected in ActionSet::runGA().");
         }
+
+        const double averageTimeStamp = static_cast<double>(m_nicheStatistics.timeStampSum) / numerositySum;
         if (averageTimeStamp >= timeStamp + 1)
         {
             throw std::runtime_error("Invalid average timestamp detected in ActionSet::runGA().");
@@ -110,54 +260,69 @@ namespace xcspp::xcs
 
         if (timeStamp - averageTimeStamp >= m_pParams->thetaGA)
         {
-            for (const auto & cl : m_set)
+            for (const auto & handle : m_set)
             {
-                cl->timeStamp = timeStamp;
+                population[handle].timeStamp = timeStamp;
             }
 
-            GA::Run(*this, situation, population, m_availableActions, m_pParams, random);
+            GA::Run(*this, situation, population, m_availableActions, m_pParams, random, m_gaBuffers);
+
+            // The GA may have changed the numerosities of the members
+            m_hasNicheStatistics = false;
         }
     }
 
     // UPDATE SET
     void ActionSet::update(double p, Population & population)
     {
-        // Calculate numerosity sum used for updating action set size estimate
-        std::uint64_t numerositySum = 0;
-        for (const auto & cl : m_set)
+        removeStaleHandles(population);
+        if (m_set.empty())
         {
-            numerositySum += cl->numerosity;
+            return;
         }
 
-        for (const auto & cl : m_set)
+        // Gather the members of the classifiers into contiguous arrays
+        // (Also calculate the numerosity sum used for updating action set size estimate, and the other
+        // niche statistics)
+        auto & b = m_updateBuffers;
+        b.resize(m_set.size());
+        std::uint64_t numerositySum = 0;
+        std::uint64_t timeStampSum = 0;
+        for (std::size_t i = 0; i < m_set.size(); ++i)
         {
-            ++cl->experience;
-
-            // Update prediction, prediction error
-            if (m_pParams->useMAM && cl->experience < 1.0 / m_pParams->beta)
-            {
-                cl->epsilon += (std::abs(p - cl->prediction) - cl->epsilon) / cl->experience;
-                cl->prediction += (p - cl->prediction) / cl->experience;
-            }
-            else
-            {
-                cl->epsilon += m_pParams->beta * (std::abs(p - cl->prediction) - cl->epsilon);
-                cl->prediction += m_pParams->beta * (p - cl->prediction);
-            }
-
-            // Update action set size estimate
-            if (cl->experience < 1.0 / m_pParams->beta)
-            {
-                cl->actionSetSize += (numerositySum - cl->actionSetSize) / cl->experience;
-            }
-            else
-            {
-                cl->actionSetSize += m_pParams->beta * (numerositySum - cl->actionSetSize);
-            }
+            auto cl = population[m_set[i]];
+            ++cl.experience;
+            b.predictions[i] = cl.prediction;
+            b.epsilons[i] = cl.epsilon;
+            b.actionSetSizes[i] = cl.actionSetSize;
+            b.experiences[i] = static_cast<double>(cl.experience);
+            b.numerosities[i] = static_cast<double>(cl.numerosity);
+            b.fitnesses[i] = cl.fitness;
+            numerositySum += cl.numerosity;
+            timeStampSum += cl.numerosity * cl.timeStamp;
         }
+        m_nicheStatistics.numerositySum = numerositySum;
+        m_nicheStatistics.timeStampSum = timeStampSum;
 
+        updateParameters(p, static_cast<double>(numerositySum));
+        updateAccuracies();
         updateFitness();
 
+        // Write the results back to [P]
+        double fitnessSum = 0.0;
+        for (std::size_t i = 0; i < m_set.size(); ++i)
+        {
+            fitnessSum += b.fitnesses[i];
+            auto cl = population[m_set[i]];
+            cl.prediction = b.predictions[i];
+            cl.epsilon = b.epsilons[i];
+            cl.actionSetSize = b.actionSetSizes[i];
+            cl.fitness = b.fitnesses[i];
+            population.cacheAccuracy(m_set[i].index, b.accuracies[i]);
+        }
+        m_nicheStatistics.fitnessSum = fitnessSum;
+        m_hasNicheStatistics = true;
+
         if (m_pParams->doActionSetSubsumption)
         {
             doSubsumption(population);
@@ -0,0 +1,223 @@
+#include "xcspp/core/xcs/bit_sliced_matcher.hpp"
+#include <algorithm> // std::find, std::min
+#include <stdexcept>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "xcspp/util/bit.hpp"
+
+namespace xcspp::xcs
+{
+
+    namespace
+    {
+        constexpr std::size_t kBlockBits = BitSlicedMatcher::kBlockBits;
+        constexpr std::size_t kBlockWords = BitSlicedMatcher::kBlockWords;
+
+        // The number of positions processed between checks of whether all columns of a block are already rejected
+        constexpr std::size_t kEarlyExitInterval = 16;
+
+        // OR the selected reject masks of positions [first, last) into the accumulator
+        void AccumulateRejects(const std::uint64_t *blockWords, const std::uint32_t *offsets, std::size_t first, std::size_t last, std::uint64_t *acc)
+        {
+#if defined(__AVX512F__)
+            __m512i v = _mm512_loadu_si512(acc);
+            for (std::size_t p = first; p < last; ++p)
+            {
+                v = _mm512_or_si512(v, _mm512_loadu_si512(blockWords + offsets[p]));
+            }
+            _mm512_storeu_si512(acc, v);
+#elif defined(__AVX2__)
+            __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc));
+            __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc + 4));
+            for (std::size_t p = first; p < last; ++p)
+            {
+                const std::uint64_t *words = blockWords + offsets[p];
+                v0 = _mm256_or_si256(v0, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words)));
+                v1 = _mm256_or_si256(v1, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + 4)));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc), v0);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc + 4), v1);
+#else
+            for (std::size_t p = first; p < last; ++p)
+            {
+                const std::uint64_t *words = blockWords + offsets[p];
+                for (std::size_t w = 0; w < kBlockWords; ++w)
+                {
+                    acc[w] |= words[w];
+                }
+            }
+#endif
+        }
+
+        bool IsAllRejected(const std::uint64_t *acc, const std::uint64_t *live)
+        {
+            std::uint64_t remaining = 0;
+            for (std::size_t w = 0; w < kBlockWords; ++w)
+            {
+                remaining |= live[w] & ~acc[w];
+            }
+            return remaining == 0;
+        }
+    }
+
+    void BitSlicedMatcher::reset(std::size_t conditionLength)
+    {
+        m_conditionLength = conditionLength;
+        m_rejectWords.clear();
+        m_liveWords.clear();
+        m_unslicedColumns.clear();
+        m_size = 0;
+    }
+
+    BitSlicedMatcher::BitSlicedMatcher()
+        : m_conditionLength(0)
+        , m_size(0)
+    {
+    }
+
+    void BitSlicedMatcher::insert(std::size_t column, const Condition & condition)
+    {
+        if (m_size == 0 && condition.size() != m_conditionLength)
+        {
+            reset(condition.size());
+        }
+        else if (condition.size() != m_conditionLength)
+        {
+            throw std::invalid_argument("BitSlicedMatcher::insert() received a condition with a different length.");
+        }
+
+        // Allocate blocks up to the column
+        while (column >= m_liveWords.size() / kBlockWords * kBlockBits)
+        {
+            m_rejectWords.resize(m_rejectWords.size() + m_conditionLength * 2 * kBlockWords, 0);
+            m_liveWords.resize(m_liveWords.size() + kBlockWords, 0);
+        }
+        ++m_size;
+
+        if (!condition.isPacked())
+        {
+            m_unslicedColumns.push_back(column);
+            return;
+        }
+
+        const std::size_t block = column / kBlockBits;
+        const std::size_t w = (column % kBlockBits) / 64;
+        const std::uint64_t bit = std::uint64_t{ 1 } << (column % 64);
+        m_liveWords[block * kBlockWords + w] |= bit;
+
+        for (std::size_t p = 0; p < m_conditionLength; ++p)
+        {
+            if (!condition.isDontCare(p))
+            {
+                // The specified value 1 rejects the input value 0, and vice versa
+                const std::size_t rejectedValue = (condition[p].value() == 1) ? 0 : 1;
+                m_rejectWords[((block * m_conditionLength + p) * 2 + rejectedValue) * kBlockWords + w] |= bit;
+            }
+        }
+    }
+
+    void BitSlicedMatcher::erase(std::size_t column)
+    {
+        const std::size_t block = column / kBlockBits;
+        const std::size_t w = (column % kBlockBits) / 64;
+        const std::uint64_t bit = std::uint64_t{ 1 } << (column % 64);
+
+        if (block < m_liveWords.size() / kBlockWords && (m_liveWords[block * kBlockWords + w] & bit) != 0)
+        {
+            m_liveWords[block * kBlockWords + w] &= ~bit;
+            for (std::size_t i = block * m_conditionLength * 2; i < (block + 1) * m_conditionLength * 2; ++i)
+            {
+                m_rejectWords[i * kBlockWords + w] &= ~bit;
+            }
+        }
+        else
+        {
+            const auto it = std::find(m_unslicedColumns.begin(), m_unslicedColumns.end(), column);
+            if (it == m_unslicedColumns.end())
+            {
+                throw std::invalid_argument("BitSlicedMatcher::erase() received a column not in use.");
+            }
+            *it = m_unslicedColumns.back();
+            m_unslicedColumns.pop_back();
+        }
+
+        --m_size;
+    }
+
+    void BitSlicedMatcher::clear()
+    {
+        reset(0);
+    }
+
+    void BitSlicedMatcher::reserve(std::size_t columnCount, std::size_t conditionLength)
+    {
+        const std::size_t blockCount = (columnCount + kBlockBits - 1) / kBlockBits;
+        m_rejectWords.reserve(blockCount * conditionLength * 2 * kBlockWords);
+        m_liveWords.reserve(blockCount * kBlockWords);
+        m_unslicedColumns.reserve(columnCount);
+        m_selectedOffsets.reserve(conditionLength * 2);
+    }
+
+    void BitSlicedMatcher::match(const PackedSituation & situation, std::vector<std::size_t> & matchedColumns) const
+    {
+        matchedColumns.clear();
+
+        if (m_size == 0)
+        {
+            return;
+        }
+
+        if (situation.size() != m_conditionLength)
+        {
+            throw std::invalid_argument("BitSlicedMatcher::match() could not process the situation with a different length.");
+        }
+
+        // Select the reject masks by the input values
+        //   (Non-binary input values are rejected by any specified symbol, so both masks are selected.)
+        const auto & words = situation.words();
+        m_selectedOffsets.clear();
+        for (std::size_t p = 0; p < m_conditionLength; ++p)
+        {
+            const std::uint64_t valueBit = (words[p / 64 * 2] >> (p % 64)) & 1;
+            const std::uint64_t nonBinaryBit = (words[p / 64 * 2 + 1] >> (p % 64)) & 1;
+            const std::uint32_t offset = static_cast<std::uint32_t>(p * 2 * kBlockWords);
+            if (nonBinaryBit)
+            {
+                m_selectedOffsets.push_back(offset);
+                m_selectedOffsets.push_back(offset + kBlockWords);
+            }
+            else
+            {
+                m_selectedOffsets.push_back(offset + static_cast<std::uint32_t>(valueBit * kBlockWords));
+            }
+        }
+
+        const std::size_t blockCount = m_liveWords.size() / kBlockWords;
+        const std::size_t selectedCount = m_selectedOffsets.size();
+        for (std::size_t block = 0; block < blockCount; ++block)
+        {
+            const std::uint64_t *live = m_liveWords.data() + block * kBlockWords;
+            const std::uint64_t *blockWords = m_rejectWords.data() + block * m_conditionLength * 2 * kBlockWords;
+
+            std::uint64_t acc[kBlockWords] = {};
+            for (std::size_t first = 0; first < selectedCount && !IsAllRejected(acc, live); first += kEarlyExitInterval)
+            {
+                AccumulateRejects(blockWords, m_selectedOffsets.data(), first, std::min(first + kEarlyExitInterval, selectedCount), acc);
+            }
+
+            for (std::size_t w = 0; w < kBlockWords; ++w)
+            {
+                std::uint64_t matched = live[w] & ~acc[w];
+                while (matched != 0)
+                {
+                    matchedColumns.push_back(block * kBlockBits + w * 64 + Bit::CountTrailingZeros(matched));
+                    matched &= matched - 1;
+                }
+            }
+        }
+    }
+
+}
@@ -1,7 +1,9 @@
 #include "xcspp/core/xcs/classifier.hpp"
 #include <utility> // std::move
 #include <cstddef> // std::size_t
-#include <cmath> // std::pow
+
+#include "xcspp/util/fast_pow.hpp"
+#include "xcspp/util/hash.hpp"
 
 namespace xcspp::xcs
 {
@@ -18,6 +20,11 @@ namespace xcspp::xcs
     {
     }
 
+    std::uint64_t ConditionActionPair::hash() const
+    {
+        return Hash::Combine(condition.hash(), static_cast<std::uint32_t>(action));
+    }
+
     std::ostream & operator<< (std::ostream & os, const ConditionActionPair & obj)
     {
         return os << obj.condition << ':' << obj.action;
@@ -77,61 +84,8 @@ namespace xcspp::xcs
         }
         else
         {
-            return alpha * std::pow(epsilon / epsilonZero, -nu);
+            return alpha * FastPow(epsilonZero / epsilon, nu);
         }
     }
 
-    StoredClassifier::StoredClassifier(const Classifier & obj, const XCSParams *pParams)
-        : Classifier(obj)
-        , m_pParams(pParams)
-    {
-    }
-
-    StoredClassifier::StoredClassifier(const Condition & condition, int action, std::uint64_t timeStamp, const XCSParams *pParams)
-        : Classifier(condition, action, pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
-        , m_pParams(pParams)
-    {
-    }
-
-    StoredClassifier::StoredClassifier(const ConditionActionPair & conditionActionPair, std::uint64_t timeStamp, const XCSParams *pParams)
-        : Classifier(conditionActionPair, pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
-        , m_pParams(pParams)
-    {
-    }
-
-    StoredClassifier::StoredClassifier(ConditionActionPair && conditionActionPair, std::uint64_t timeStamp, const XCSParams *pParams)
-        : Classifier(std::move(conditionActionPair), pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
-        , m_pParams(pParams)
-    {
-    }
-
-    StoredClassifier::StoredClassifier(const std::vector<int> & situation, int action, std::uint64_t timeStamp, const XCSParams *pParams)
-        : Classifier(situation, action, pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
-        , m_pParams(pParams)
-    {
-    }
-
-    StoredClassifier::StoredClassifier(const std::string & condition, int action, std::uint64_t timeStamp, const XCSParams *pParams)
-        : Classifier(condition, action, pParams->initialPrediction, pParams->initialEpsilon, pParams->initialFitness, timeStamp)
-        , m_pParams(pParams)
-    {
-    }
-
-    // COULD SUBSUME
-    bool StoredClassifier::isSubsumer() const
-    {
-        return experience > m_pParams->thetaSub && epsilon < m_pParams->epsilonZero;
-    }
-
-    // DOES SUBSUME
-    bool StoredClassifier::subsumes(const Classifier & cl) const
-    {
-        return action == cl.action && isSubsumer() && condition.isMoreGeneral(cl.condition);
-    }
-
-    double StoredClassifier::accuracy() const
-    {
-        return Classifier::accuracy(m_pParams->epsilonZero, m_pParams->alpha, m_pParams->nu);
-    }
-
 }
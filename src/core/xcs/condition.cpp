@@ -1,16 +1,148 @@
 #include "xcspp/core/xcs/condition.hpp"
+#include <algorithm> // std::min, std::max
 #include <sstream>
+#include <stdexcept>
 
+#include "xcspp/util/bit.hpp"
+#include "xcspp/util/hash.hpp"
 #include "xcspp/util/random.hpp"
 
 namespace xcspp::xcs
 {
 
-    Condition::Condition(const std::vector<Symbol> & symbols) : m_symbols(symbols) {}
+    namespace
+    {
+        constexpr std::size_t kBitsPerWord = Condition::kBitsPerWord;
+
+        constexpr std::size_t WordCount(std::size_t size)
+        {
+            return (size + kBitsPerWord - 1) / kBitsPerWord;
+        }
+
+        constexpr bool IsBinaryValue(int value)
+        {
+            return value == 0 || value == 1;
+        }
+
+        // Hash of the symbol at the position ("#" has no effect on the hash of the condition)
+        std::uint64_t SymbolHash(std::size_t idx, const Symbol & symbol)
+        {
+            if (symbol.isDontCare())
+            {
+                return 0;
+            }
+            return Hash::Mix64(((static_cast<std::uint64_t>(idx) << 32) | static_cast<std::uint32_t>(symbol.value())) + 0x9E3779B97F4A7C15ULL);
+        }
+    }
+
+    PackedSituation::PackedSituation(const std::vector<int> & situation)
+    {
+        assign(situation);
+    }
+
+    void PackedSituation::assign(const std::vector<int> & situation)
+    {
+        m_values.assign(situation.begin(), situation.end());
+        m_words.assign(WordCount(situation.size()) * 2, 0);
+
+        for (std::size_t i = 0; i < situation.size(); ++i)
+        {
+            const std::uint64_t bit = std::uint64_t{ 1 } << (i % kBitsPerWord);
+            if (situation[i] == 1)
+            {
+                m_words[i / kBitsPerWord * 2] |= bit;
+            }
+            else if (situation[i] != 0)
+            {
+                m_words[i / kBitsPerWord * 2 + 1] |= bit;
+            }
+        }
+    }
+
+    void Condition::pushBack(const Symbol & symbol)
+    {
+        m_hash ^= SymbolHash(m_size, symbol);
+
+        if (m_isPacked && !symbol.isDontCare() && !IsBinaryValue(symbol.value()))
+        {
+            unpack();
+        }
+
+        if (m_isPacked)
+        {
+            if (m_size % kBitsPerWord == 0)
+            {
+                m_bits.push_back(0); // care-mask
+                m_bits.push_back(0); // value-mask
+            }
+
+            if (!symbol.isDontCare())
+            {
+                const std::uint64_t bit = std::uint64_t{ 1 } << (m_size % kBitsPerWord);
+                m_bits[m_size / kBitsPerWord * 2] |= bit;
+                if (symbol.value() == 1)
+                {
+                    m_bits[m_size / kBitsPerWord * 2 + 1] |= bit;
+                }
+            }
+        }
+        else
+        {
+            m_symbols.push_back(symbol);
+        }
+
+        ++m_size;
+    }
+
+    void Condition::unpack()
+    {
+        if (!m_isPacked)
+        {
+            return;
+        }
+
+        std::vector<Symbol> symbols;
+        symbols.reserve(m_size);
+        for (std::size_t i = 0; i < m_size; ++i)
+        {
+            symbols.push_back((*this)[i]);
+        }
+
+        m_symbols = std::move(symbols);
+        m_bits.clear();
+        m_bits.shrink_to_fit();
+        m_isPacked = false;
+    }
+
+    Condition::Condition()
+        : m_size(0)
+        , m_isPacked(true)
+        , m_hash(0)
+    {
+    }
+
+    Condition::Condition(const std::vector<Symbol> & symbols)
+        : Condition()
+    {
+        m_bits.reserve(WordCount(symbols.size()) * 2);
+        for (const auto & symbol : symbols)
+        {
+            pushBack(symbol);
+        }
+    }
 
-    Condition::Condition(const std::vector<int> & symbols) : m_symbols(symbols.begin(), symbols.end()) {}
+    Condition::Condition(const std::vector<int> & symbols)
+        : Condition()
+    {
+        m_bits.reserve(WordCount(symbols.size()) * 2);
+        for (const auto & symbol : symbols)
+        {
+            pushBack(Symbol(symbol));
+        }
+    }
 
     Condition::Condition(const std::string & symbols)
+        : Condition()
     {
         std::istringstream iss(symbols);
         std::string symbol;
@@ -21,17 +153,30 @@ namespace xcspp::xcs
                 continue;
             }
 
-            m_symbols.emplace_back(symbol);
+            pushBack(Symbol(symbol));
+        }
+    }
+
+    void Condition::assign(const std::vector<int> & symbols)
+    {
+        m_bits.clear();
+        m_symbols.clear();
+        m_size = 0;
+        m_isPacked = true;
+        m_hash = 0;
+        for (const auto & symbol : symbols)
+        {
+            pushBack(Symbol(symbol));
         }
     }
 
     std::string Condition::toString() const
     {
         std::string str;
-        str.reserve(m_symbols.size() * 2);
-        for (const auto & symbol : m_symbols)
+        str.reserve(m_size * 2);
+        for (std::size_t i = 0; i < m_size; ++i)
         {
-            str += symbol.toString();
+            str += (*this)[i].toString();
             str += ' ';
         }
 
@@ -47,16 +192,75 @@ namespace xcspp::xcs
     // DOES MATCH
     bool Condition::matches(const std::vector<int> & situation) const
     {
-        if (m_symbols.size() != situation.size())
+        if (m_size != situation.size())
         {
-            std::invalid_argument("Condition::matches() could not process the situation with a different length.");
+            throw std::invalid_argument("Condition::matches() could not process the situation with a different length.");
         }
 
-        for (std::size_t i = 0; i < m_symbols.size(); ++i)
+        if (m_isPacked)
         {
-            if (!m_symbols[i].matches(situation[i]))
+            for (std::size_t w = 0; w < m_bits.size() / 2; ++w)
             {
-                return false;
+                const std::size_t offset = w * kBitsPerWord;
+                const std::size_t count = std::min(kBitsPerWord, m_size - offset);
+
+                // Pack the situation on the fly (values other than 0 and 1 never match specified symbols)
+                std::uint64_t mismatch = 0;
+                for (std::size_t b = 0; b < count; ++b)
+                {
+                    const int value = situation[offset + b];
+                    const std::uint64_t valueBit = (m_bits[w * 2 + 1] >> b) & 1;
+                    mismatch |= static_cast<std::uint64_t>(!IsBinaryValue(value) || static_cast<std::uint64_t>(value) != valueBit) << b;
+                }
+
+                if ((mismatch & m_bits[w * 2]) != 0)
+                {
+                    return false;
+                }
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < m_size; ++i)
+            {
+                if (!m_symbols[i].matches(situation[i]))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool Condition::matches(const PackedSituation & situation) const
+    {
+        if (m_size != situation.size())
+        {
+            throw std::invalid_argument("Condition::matches() could not process the situation with a different length.");
+        }
+
+        if (m_isPacked)
+        {
+            const auto & words = situation.words();
+            for (std::size_t w = 0; w < m_bits.size(); w += 2)
+            {
+                // Mismatch if a specified symbol differs from the input value (or the input value is not binary)
+                if ((((m_bits[w + 1] ^ words[w]) | words[w + 1]) & m_bits[w]) != 0)
+                {
+                    return false;
+                }
+            }
+        }
+        else
+        {
+            const auto & values = situation.values();
+            for (std::size_t i = 0; i < m_size; ++i)
+            {
+                if (!m_symbols[i].matches(values[i]))
+                {
+                    return false;
+                }
             }
         }
 
@@ -65,24 +269,48 @@ namespace xcspp::xcs
 
     bool Condition::isMoreGeneral(const Condition & cond) const
     {
-        if (m_symbols.size() != cond.size())
+        if (m_size != cond.size())
         {
             throw std::invalid_argument("In Condition::isMoreGeneral(), both conditions must have the same length.");
         }
 
         bool ret = false;
 
-        for (std::size_t i = 0; i < m_symbols.size(); ++i)
+        if (m_isPacked && cond.m_isPacked)
         {
-            if (m_symbols[i] != cond[i])
+            for (std::size_t w = 0; w < m_bits.size(); w += 2)
             {
-                if (m_symbols[i].isDontCare())
+                const std::uint64_t selfCare = m_bits[w];
+                const std::uint64_t otherCare = cond.m_bits[w];
+
+                // Return false if this condition specifies a symbol that is "#" or a different value in the other
+                if ((selfCare & ~otherCare) != 0 || ((m_bits[w + 1] ^ cond.m_bits[w + 1]) & selfCare) != 0)
+                {
+                    return false;
+                }
+
+                if ((otherCare & ~selfCare) != 0)
                 {
                     ret = true;
                 }
-                else 
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < m_size; ++i)
+            {
+                const Symbol selfSymbol = (*this)[i];
+                const Symbol otherSymbol = cond[i];
+                if (selfSymbol != otherSymbol)
                 {
-                    return false;
+                    if (selfSymbol.isDontCare())
+                    {
+                        ret = true;
+                    }
+                    else
+                    {
+                        return false;
+                    }
                 }
             }
         }
@@ -93,20 +321,248 @@ namespace xcspp::xcs
     std::size_t Condition::dontCareCount() const
     {
         std::size_t count = 0;
-        for (const auto & symbol : m_symbols)
+
+        if (m_isPacked)
         {
-            if (symbol.isDontCare())
+            std::size_t careCount = 0;
+            for (std::size_t w = 0; w < m_bits.size(); w += 2)
+            {
+                careCount += Bit::PopCount(m_bits[w]);
+            }
+            count = m_size - careCount;
+        }
+        else
+        {
+            for (const auto & symbol : m_symbols)
             {
-                count++;
+                if (symbol.isDontCare())
+                {
+                    count++;
+                }
             }
         }
 
         return count;
     }
 
+    bool Condition::isDontCare(std::size_t idx) const
+    {
+        if (m_isPacked)
+        {
+            return ((m_bits[idx / kBitsPerWord * 2] >> (idx % kBitsPerWord)) & 1) == 0;
+        }
+        else
+        {
+            return m_symbols[idx].isDontCare();
+        }
+    }
+
+    void Condition::setValue(std::size_t idx, int value)
+    {
+        m_hash ^= SymbolHash(idx, (*this)[idx]) ^ SymbolHash(idx, Symbol(value));
+
+        if (m_isPacked && !IsBinaryValue(value))
+        {
+            unpack();
+        }
+
+        if (m_isPacked)
+        {
+            const std::uint64_t bit = std::uint64_t{ 1 } << (idx % kBitsPerWord);
+            m_bits[idx / kBitsPerWord * 2] |= bit;
+            if (value == 1)
+            {
+                m_bits[idx / kBitsPerWord * 2 + 1] |= bit;
+            }
+            else
+            {
+                m_bits[idx / kBitsPerWord * 2 + 1] &= ~bit;
+            }
+        }
+        else
+        {
+            m_symbols[idx].setValue(value);
+        }
+    }
+
+    void Condition::setToDontCare(std::size_t idx)
+    {
+        m_hash ^= SymbolHash(idx, (*this)[idx]);
+
+        if (m_isPacked)
+        {
+            const std::uint64_t bit = std::uint64_t{ 1 } << (idx % kBitsPerWord);
+            m_bits[idx / kBitsPerWord * 2] &= ~bit;
+            m_bits[idx / kBitsPerWord * 2 + 1] &= ~bit;
+        }
+        else
+        {
+            m_symbols[idx].setToDontCare();
+        }
+    }
+
+    void Condition::setSymbol(std::size_t idx, const Symbol & symbol)
+    {
+        if (symbol.isDontCare())
+        {
+            setToDontCare(idx);
+        }
+        else
+        {
+            setValue(idx, symbol.value());
+        }
+    }
+
+    void Condition::swapSymbol(Condition & other, std::size_t idx)
+    {
+        swapSymbols(other, idx, idx + 1);
+    }
+
+    void Condition::swapSymbols(Condition & other, std::size_t first, std::size_t last)
+    {
+        if (first >= last)
+        {
+            return;
+        }
+
+        if (m_isPacked && other.m_isPacked)
+        {
+            for (std::size_t w = first / kBitsPerWord; w <= (last - 1) / kBitsPerWord; ++w)
+            {
+                const std::size_t offset = w * kBitsPerWord;
+                const unsigned int begin = static_cast<unsigned int>(std::max(first, offset) - offset);
+                const unsigned int end = static_cast<unsigned int>(std::min(last, offset + kBitsPerWord) - offset);
+                const std::uint64_t mask = Bit::RangeMask(begin, end);
+
+                // Both hashes change by the difference of the swapped symbols
+                std::uint64_t changedBits = ((m_bits[w * 2] ^ other.m_bits[w * 2]) | (m_bits[w * 2 + 1] ^ other.m_bits[w * 2 + 1])) & mask;
+                while (changedBits != 0)
+                {
+                    const std::size_t idx = offset + Bit::CountTrailingZeros(changedBits);
+                    const std::uint64_t diff = SymbolHash(idx, (*this)[idx]) ^ SymbolHash(idx, other[idx]);
+                    m_hash ^= diff;
+                    other.m_hash ^= diff;
+                    changedBits &= changedBits - 1;
+                }
+
+                for (std::size_t k = w * 2; k <= w * 2 + 1; ++k)
+                {
+                    const std::uint64_t diff = (m_bits[k] ^ other.m_bits[k]) & mask;
+                    m_bits[k] ^= diff;
+                    other.m_bits[k] ^= diff;
+                }
+            }
+        }
+        else
+        {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                const Symbol symbol = (*this)[i];
+                setSymbol(i, other[i]);
+                other.setSymbol(i, symbol);
+            }
+        }
+    }
+
+    void Condition::swapMaskedSymbols(Condition & other, std::size_t offset, std::uint64_t mask)
+    {
+        if (offset >= m_size)
+        {
+            return;
+        }
+        if (m_size - offset < kBitsPerWord)
+        {
+            mask &= Bit::RangeMask(0, static_cast<unsigned int>(m_size - offset));
+        }
+
+        if (m_isPacked && other.m_isPacked && offset % kBitsPerWord == 0)
+        {
+            const std::size_t w = offset / kBitsPerWord;
+
+            // Both hashes change by the difference of the swapped symbols
+            std::uint64_t changedBits = ((m_bits[w * 2] ^ other.m_bits[w * 2]) | (m_bits[w * 2 + 1] ^ other.m_bits[w * 2 + 1])) & mask;
+            while (changedBits != 0)
+            {
+                const std::size_t idx = offset + Bit::CountTrailingZeros(changedBits);
+                const std::uint64_t diff = SymbolHash(idx, (*this)[idx]) ^ SymbolHash(idx, other[idx]);
+                m_hash ^= diff;
+                other.m_hash ^= diff;
+                changedBits &= changedBits - 1;
+            }
+
+            for (std::size_t k = w * 2; k <= w * 2 + 1; ++k)
+            {
+                const std::uint64_t diff = (m_bits[k] ^ other.m_bits[k]) & mask;
+                m_bits[k] ^= diff;
+                other.m_bits[k] ^= diff;
+            }
+        }
+        else
+        {
+            for (; mask != 0; mask &= mask - 1)
+            {
+                swapSymbol(other, offset + Bit::CountTrailingZeros(mask));
+            }
+        }
+    }
+
+    Symbol Condition::operator[] (std::size_t idx) const
+    {
+        if (m_isPacked)
+        {
+            const std::size_t w = idx / kBitsPerWord;
+            const std::size_t b = idx % kBitsPerWord;
+            if (((m_bits[w * 2] >> b) & 1) == 0)
+            {
+                return Symbol();
+            }
+            return Symbol(static_cast<int>((m_bits[w * 2 + 1] >> b) & 1));
+        }
+        else
+        {
+            return m_symbols[idx];
+        }
+    }
+
+    Symbol Condition::at(std::size_t idx) const
+    {
+        if (idx >= m_size)
+        {
+            throw std::out_of_range("Condition::at() received an out-of-range index.");
+        }
+        return (*this)[idx];
+    }
+
     std::ostream & operator<< (std::ostream & os, const Condition & obj)
     {
         return os << obj.toString();
     }
 
+    bool operator== (const Condition & lhs, const Condition & rhs)
+    {
+        if (lhs.m_size != rhs.m_size)
+        {
+            return false;
+        }
+
+        if (lhs.m_isPacked && rhs.m_isPacked)
+        {
+            return lhs.m_bits == rhs.m_bits;
+        }
+
+        for (std::size_t i = 0; i < lhs.m_size; ++i)
+        {
+            if (lhs[i] != rhs[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!= (const Condition & lhs, const Condition & rhs)
+    {
+        return !(lhs == rhs);
+    }
+
 }
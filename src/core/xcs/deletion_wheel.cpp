@@ -0,0 +1,220 @@
+#include "xcspp/core/xcs/deletion_wheel.hpp"
+#include <algorithm> // std::max, std::min
+#include <stdexcept>
+
+namespace xcspp::xcs
+{
+
+    namespace
+    {
+        // The number of changes after which the sums are recomputed at least
+        constexpr std::size_t kMinRecomputeInterval = 1024;
+    }
+
+    bool DeletionWheel::isExperienced(std::size_t idx) const
+    {
+        return m_numerosities[idx] > 0 && m_experiences[idx] >= m_thetaDel;
+    }
+
+    double DeletionWheel::fitnessPerNumerosity(std::size_t idx) const
+    {
+        return m_fitnesses[idx] / m_numerosities[idx];
+    }
+
+    void DeletionWheel::updateBucket(std::size_t idx)
+    {
+        const double vote = m_actionSetSizes[idx] * m_numerosities[idx];
+        const bool isPenalized = isExperienced(idx) && fitnessPerNumerosity(idx) < m_threshold;
+        if (isPenalized)
+        {
+            m_votes.set(idx, 0.0);
+            m_penalizedWeights.set(idx, vote / fitnessPerNumerosity(idx));
+        }
+        else
+        {
+            m_votes.set(idx, vote);
+            m_penalizedWeights.set(idx, 0.0);
+        }
+    }
+
+    void DeletionWheel::moveThreshold(double threshold)
+    {
+        const double lower = std::min(threshold, m_threshold);
+        const double upper = std::max(threshold, m_threshold);
+        m_threshold = threshold;
+        for (auto it = m_experiencedClassifiers.lower_bound({ lower, 0 }); it != m_experiencedClassifiers.end() && it->first < upper; ++it)
+        {
+            updateBucket(it->second);
+        }
+    }
+
+    void DeletionWheel::recomputeSums()
+    {
+        m_numerositySum = 0;
+        m_fitnessSum = 0.0;
+        for (std::size_t i = 0; i < m_numerosities.size(); ++i)
+        {
+            m_numerositySum += m_numerosities[i];
+            m_fitnessSum += m_fitnesses[i];
+        }
+        m_votes.rebuild();
+        m_penalizedWeights.rebuild();
+        m_changeCount = 0;
+    }
+
+    void DeletionWheel::rebuild()
+    {
+        m_thetaDel = m_pParams->thetaDel;
+        m_delta = m_pParams->delta;
+        m_threshold = 0.0;
+        m_nodePool.clear(m_experiencedClassifiers);
+        for (std::size_t i = 0; i < m_numerosities.size(); ++i)
+        {
+            if (isExperienced(i))
+            {
+                m_nodePool.insert(m_experiencedClassifiers, { fitnessPerNumerosity(i), static_cast<std::uint32_t>(i) });
+            }
+            updateBucket(i);
+        }
+        recomputeSums();
+    }
+
+    DeletionWheel::DeletionWheel(const XCSParams *pParams)
+        : m_pParams(pParams)
+        , m_thetaDel(pParams->thetaDel)
+        , m_delta(pParams->delta)
+        , m_numerositySum(0)
+        , m_fitnessSum(0.0)
+        , m_threshold(0.0)
+        , m_changeCount(0)
+    {
+    }
+
+    void DeletionWheel::update(std::size_t idx, double actionSetSize, std::uint64_t numerosity, double fitness, std::uint64_t experience)
+    {
+        if (idx >= m_numerosities.size())
+        {
+            m_actionSetSizes.resize(idx + 1, 0.0);
+            m_numerosities.resize(idx + 1, 0);
+            m_fitnesses.resize(idx + 1, 0.0);
+            m_experiences.resize(idx + 1, 0);
+            m_votes.resize(idx + 1);
+            m_penalizedWeights.resize(idx + 1);
+        }
+
+        const bool wasExperienced = isExperienced(idx);
+        const double oldFitnessPerNumerosity = wasExperienced ? fitnessPerNumerosity(idx) : 0.0;
+
+        m_numerositySum = m_numerositySum - m_numerosities[idx] + numerosity;
+        m_fitnessSum += fitness - m_fitnesses[idx];
+        m_actionSetSizes[idx] = actionSetSize;
+        m_numerosities[idx] = numerosity;
+        m_fitnesses[idx] = fitness;
+        m_experiences[idx] = experience;
+
+        // Keep the order of the experienced classifiers (the node is reused to avoid reallocation)
+        const bool isExperienced = this->isExperienced(idx);
+        if (wasExperienced && isExperienced)
+        {
+            const double newFitnessPerNumerosity = fitnessPerNumerosity(idx);
+            if (newFitnessPerNumerosity != oldFitnessPerNumerosity)
+            {
+                auto node = m_experiencedClassifiers.extract({ oldFitnessPerNumerosity, static_cast<std::uint32_t>(idx) });
+                node.value().first = newFitnessPerNumerosity;
+                m_experiencedClassifiers.insert(std::move(node));
+            }
+        }
+        else if (wasExperienced)
+        {
+            m_nodePool.erase(m_experiencedClassifiers, { oldFitnessPerNumerosity, static_cast<std::uint32_t>(idx) });
+        }
+        else if (isExperienced)
+        {
+            m_nodePool.insert(m_experiencedClassifiers, { fitnessPerNumerosity(idx), static_cast<std::uint32_t>(idx) });
+        }
+
+        updateBucket(idx);
+        ++m_changeCount;
+    }
+
+    void DeletionWheel::clear()
+    {
+        m_thetaDel = m_pParams->thetaDel;
+        m_delta = m_pParams->delta;
+        m_actionSetSizes.clear();
+        m_numerosities.clear();
+        m_fitnesses.clear();
+        m_experiences.clear();
+        m_numerositySum = 0;
+        m_fitnessSum = 0.0;
+        m_votes.clear();
+        m_penalizedWeights.clear();
+        m_nodePool.clear(m_experiencedClassifiers);
+        m_threshold = 0.0;
+        m_changeCount = 0;
+    }
+
+    void DeletionWheel::reserve(std::size_t slotCount)
+    {
+        if (slotCount > m_numerosities.size())
+        {
+            m_actionSetSizes.resize(slotCount, 0.0);
+            m_numerosities.resize(slotCount, 0);
+            m_fitnesses.resize(slotCount, 0.0);
+            m_experiences.resize(slotCount, 0);
+            m_votes.resize(slotCount);
+            m_penalizedWeights.resize(slotCount);
+        }
+
+        // Every slot may become experienced at the same time
+        if (slotCount > m_experiencedClassifiers.size() + m_nodePool.size())
+        {
+            m_nodePool.reserve(slotCount - m_experiencedClassifiers.size());
+        }
+    }
+
+    std::size_t DeletionWheel::select(Random & random)
+    {
+        if (m_thetaDel != m_pParams->thetaDel || m_delta != m_pParams->delta)
+        {
+            rebuild();
+        }
+        else if (m_changeCount >= std::max(m_numerosities.size(), kMinRecomputeInterval))
+        {
+            recomputeSums();
+        }
+
+        if (m_numerositySum == 0)
+        {
+            throw std::runtime_error("DeletionWheel::select() was called for an empty population.");
+        }
+
+        // Bring the classifiers crossing the threshold to the other bucket
+        const double averageFitness = m_fitnessSum / m_numerositySum;
+        moveThreshold(m_delta * averageFitness);
+
+        // Spin the roulette wheel
+        const double voteSum = m_votes.sum();
+        const double sum = voteSum + m_penalizedWeights.sum() * averageFitness;
+        if (!(sum > 0.0))
+        {
+            throw std::runtime_error("DeletionWheel::select() generated an invalid vote sum.");
+        }
+        const double randValue = random.nextDouble(0.0, sum);
+        std::size_t selectedIdx = (randValue < voteSum)
+            ? m_votes.find(randValue)
+            : m_penalizedWeights.find((randValue - voteSum) / averageFitness);
+
+        // Choose the last classifier if the value exceeds the sum due to rounding errors
+        if (selectedIdx >= m_numerosities.size())
+        {
+            do
+            {
+                --selectedIdx;
+            } while (selectedIdx > 0 && m_votes.value(selectedIdx) <= 0.0 && m_penalizedWeights.value(selectedIdx) <= 0.0);
+        }
+
+        return selectedIdx;
+    }
+
+}
@@ -1,48 +1,69 @@
 #include "xcspp/core/xcs/ga.hpp"
-#include <memory> // std::shared_ptr, std::make_shared
 #include <vector>
 #include <unordered_set>
+#include <utility> // std::move
 #include <cstdint> // std::uint64_t
 #include <cstddef> // std::size_t
 
+#include "xcspp/util/bit.hpp"
+
 namespace xcspp::xcs
 {
 
     namespace
     {
-        // SELECT OFFSPRING
-        ClassifierPtr SelectOffspring(const ClassifierPtrSet & actionSet, double tau, Random & random)
+        bool UsesTournamentSelection(double tau)
         {
-            std::vector<const ClassifierPtr *> targets;
-            for (const auto & cl : actionSet)
+            return tau > 0.0 && tau <= 1.0;
+        }
+
+        // Gather the candidates of SELECT OFFSPRING from [A] into the buffers
+        //   (Both parents are selected from the same candidates, so this is done once per GA invocation.)
+        void PrepareOffspringSelection(const ClassifierHandleSet & actionSet, const Population & population, double tau, GA::Buffers & buffers)
+        {
+            auto & targets = buffers.targets;
+            targets.clear();
+            for (const auto & handle : actionSet)
             {
-                targets.push_back(&cl);
+                targets.push_back(handle.index);
             }
 
-            std::size_t selectedIdx;
-            if (tau > 0.0 && tau <= 1.0)
+            if (UsesTournamentSelection(tau))
             {
-                // Tournament selection
-                std::vector<std::pair<double, std::uint64_t>> fitnesses;
-                fitnesses.reserve(actionSet.size());
+                auto & fitnesses = buffers.tournamentFitnesses;
+                fitnesses.clear();
                 for (const auto & target : targets)
                 {
-                    fitnesses.emplace_back((*target)->fitness, (*target)->numerosity);
+                    fitnesses.emplace_back(population[target].fitness, population[target].numerosity);
                 }
-                selectedIdx = random.tournamentSelectionMicroClassifier(fitnesses, tau);
             }
             else
             {
-                // Roulette-wheel selection
-                std::vector<double> fitnesses;
-                fitnesses.reserve(actionSet.size());
+                auto & rouletteWheel = buffers.rouletteWheel;
+                rouletteWheel.clear();
                 for (const auto & target : targets)
                 {
-                    fitnesses.push_back((*target)->fitness);
+                    rouletteWheel.push_back(population[target].fitness);
                 }
-                selectedIdx = random.rouletteWheelSelection(fitnesses);
             }
-            return *targets[selectedIdx];
+        }
+
+        // SELECT OFFSPRING
+        //   (Returns the slot index of the selected classifier in [P]. Call PrepareOffspringSelection() first.)
+        std::size_t SelectOffspring(double tau, Random & random, const GA::Buffers & buffers)
+        {
+            std::size_t selectedIdx;
+            if (UsesTournamentSelection(tau))
+            {
+                // Tournament selection
+                selectedIdx = random.tournamentSelectionMicroClassifier(buffers.tournamentFitnesses, tau);
+            }
+            else
+            {
+                // Roulette-wheel selection
+                selectedIdx = buffers.rouletteWheel.spin(random);
+            }
+            return buffers.targets[selectedIdx];
         }
 
         // APPLY CROSSOVER (uniform crossover)
@@ -53,14 +74,18 @@ namespace xcspp::xcs
                 throw std::invalid_argument("The condition lengths do not match in GA::UniformCrossover().");
             }
 
+            // Each bit of the random words decides whether to swap an allele
+            // (The alleles of a word are swapped at once in the bit-packed representation.)
             bool isChanged = false;
-            for (std::size_t i = 0; i < cl1.condition.size(); ++i)
+            for (std::size_t offset = 0; offset < cl1.condition.size(); offset += Condition::kBitsPerWord)
             {
-                if (random.nextDouble() < 0.5)
+                std::uint64_t bits = random.nextBits();
+                if (cl1.condition.size() - offset < Condition::kBitsPerWord)
                 {
-                    std::swap(cl1.condition[i], cl2.condition[i]);
-                    isChanged = true;
+                    bits &= Bit::RangeMask(0, static_cast<unsigned int>(cl1.condition.size() - offset));
                 }
+                cl1.condition.swapMaskedSymbols(cl2.condition, offset, bits);
+                isChanged = isChanged || (bits != 0);
             }
             return isChanged;
         }
@@ -75,13 +100,9 @@ namespace xcspp::xcs
 
             std::size_t x = random.nextInt<std::size_t>(0, cl1.condition.size());
 
-            bool isChanged = false;
-            for (std::size_t i = x + 1; i < cl1.condition.size(); ++i)
-            {
-                std::swap(cl1.condition[i], cl2.condition[i]);
-                isChanged = true;
-            }
-            return isChanged;
+            // Swap the symbols in [x+1, L) word by word
+            cl1.condition.swapSymbols(cl2.condition, x + 1, cl1.condition.size());
+            return x + 1 < cl1.condition.size();
         }
 
         // APPLY CROSSOVER (two point crossover)
@@ -100,13 +121,9 @@ namespace xcspp::xcs
                 std::swap(x, y);
             }
 
-            bool isChanged = false;
-            for (std::size_t i = x + 1; i < y; ++i)
-            {
-                std::swap(cl1.condition[i], cl2.condition[i]);
-                isChanged = true;
-            }
-            return isChanged;
+            // Swap the symbols in [x+1, y) word by word
+            cl1.condition.swapSymbols(cl2.condition, x + 1, y);
+            return x + 1 < y;
         }
 
         // APPLY CROSSOVER
@@ -128,6 +145,26 @@ namespace xcspp::xcs
             }
         }
 
+        // Choose one of the available actions other than the given action at random
+        //   (The available actions are visited in place instead of copying them.)
+        int ChooseOtherAction(int action, const std::unordered_set<int> & availableActions, Random & random)
+        {
+            const bool isAvailable = (availableActions.count(action) != 0);
+            std::size_t choiceIdx = random.nextInt<std::size_t>(0, availableActions.size() - (isAvailable ? 2 : 1));
+            for (const int otherAction : availableActions)
+            {
+                if (otherAction != action)
+                {
+                    if (choiceIdx == 0)
+                    {
+                        return otherAction;
+                    }
+                    --choiceIdx;
+                }
+            }
+            return action;
+        }
+
         // APPLY MUTATION
         void mutate(Classifier & cl, const std::vector<int> & situation, const std::unordered_set<int> & availableActions, double mu, bool doActionMutation, Random & random)
         {
@@ -136,78 +173,66 @@ namespace xcspp::xcs
                 std::invalid_argument("GA::mutate() could not process the situation with a different length.");
             }
 
-            for (std::size_t i = 0; i < cl.condition.size(); ++i)
-            {
-                if (random.nextDouble() < mu)
+            random.forEachBernoulliSuccess(cl.condition.size(), mu, [&cl, &situation](std::size_t i) {
+                if (cl.condition.isDontCare(i))
                 {
-                    if (cl.condition[i].isDontCare())
-                    {
-                        cl.condition[i] = Symbol(situation.at(i));
-                    }
-                    else
-                    {
-                        cl.condition[i].setToDontCare();
-                    }
+                    cl.condition.setValue(i, situation.at(i));
                 }
-            }
+                else
+                {
+                    cl.condition.setToDontCare(i);
+                }
+            });
 
             if (doActionMutation && (random.nextDouble() < mu) && (availableActions.size() >= 2))
             {
-                std::unordered_set<int> otherPossibleActions(availableActions);
-                otherPossibleActions.erase(cl.action);
-                cl.action = random.chooseFrom(otherPossibleActions);
+                cl.action = ChooseOtherAction(cl.action, availableActions, random);
             }
         }
 
-        void subsumeClassifier(const Classifier & child, Population & population, const XCSParams *pParams, Random & random)
+        void subsumeClassifier(Classifier & child, Population & population, Random & random, std::vector<std::size_t> & choices)
         {
-            std::vector<ClassifierPtr> choices;
-
-            for (const auto & cl : population)
-            {
-                if (cl->subsumes(child))
-                {
-                    choices.push_back(cl);
-                }
-            }
+            population.collectSubsumers(child, choices);
 
             if (!choices.empty())
             {
                 std::size_t choice = random.nextInt<std::size_t>(0, choices.size() - 1);
-                ++choices[choice]->numerosity;
+                ++population[choices[choice]].numerosity;
                 return;
             }
 
-            population.insertOrIncrementNumerosity(std::make_shared<StoredClassifier>(child, pParams));
+            population.insertOrIncrementNumerosity(std::move(child));
         }
 
-        void subsumeClassifier(const Classifier & child, const ClassifierPtr & parent1, const ClassifierPtr & parent2, Population & population, const XCSParams *pParams, Random & random)
+        void subsumeClassifier(Classifier & child, std::size_t parent1, std::size_t parent2, Population & population, Random & random, std::vector<std::size_t> & choices)
         {
-            if (parent1->subsumes(child))
+            if (population.subsumes(parent1, child))
             {
-                ++parent1->numerosity;
+                ++population[parent1].numerosity;
             }
-            else if (parent2->subsumes(child))
+            else if (population.subsumes(parent2, child))
             {
-                ++parent2->numerosity;
+                ++population[parent2].numerosity;
             }
             else
             {
-                subsumeClassifier(child, population, pParams, random); // calls first subsumeClassifier function!
+                subsumeClassifier(child, population, random, choices); // calls first subsumeClassifier function!
             }
         }
 
-        void insertDiscoveredClassifiers(const Classifier & child1, const Classifier & child2, const ClassifierPtr & parent1, const ClassifierPtr & parent2, Population & population, const XCSParams *pParams, Random & random)
+        // (The children are absorbed by a subsumer or an identical classifier if possible, and their conditions
+        // are moved into [P] only if they are added as new classifiers.)
+        void insertDiscoveredClassifiers(Classifier & child1, Classifier & child2, std::size_t parent1, std::size_t parent2, Population & population, const XCSParams *pParams, Random & random, std::vector<std::size_t> & subsumers)
         {
             if (pParams->doGASubsumption)
             {
-                subsumeClassifier(child1, parent1, parent2, population, pParams, random);
-                subsumeClassifier(child2, parent1, parent2, population, pParams, random);
+                subsumeClassifier(child1, parent1, parent2, population, random, subsumers);
+                subsumeClassifier(child2, parent1, parent2, population, random, subsumers);
             }
             else
             {
-                population.insertOrIncrementNumerosity(std::make_shared<StoredClassifier>(child1, pParams));
-                population.insertOrIncrementNumerosity(std::make_shared<StoredClassifier>(child2, pParams));
+                population.insertOrIncrementNumerosity(std::move(child1));
+                population.insertOrIncrementNumerosity(std::move(child2));
             }
 
             while (population.deleteExtraClassifiers(random)) {}
@@ -217,19 +242,23 @@ namespace xcspp::xcs
     namespace GA
     {
         // RUN GA (refer to ActionSet::runGA() for the former part)
-        void Run(ClassifierPtrSet & actionSet, const std::vector<int> & situation, Population & population, const std::unordered_set<int> & availableActions, const XCSParams *pParams, Random & random)
+        void Run(const ClassifierHandleSet & actionSet, const std::vector<int> & situation, Population & population, const std::unordered_set<int> & availableActions, const XCSParams *pParams, Random & random, Buffers & buffers)
         {
-            const ClassifierPtr parent1 = SelectOffspring(actionSet, pParams->tau, random);
-            const ClassifierPtr parent2 = SelectOffspring(actionSet, pParams->tau, random);
-            if (parent1->condition.size() != parent2->condition.size())
+            PrepareOffspringSelection(actionSet, population, pParams->tau, buffers);
+            const std::size_t parent1 = SelectOffspring(pParams->tau, random, buffers);
+            const std::size_t parent2 = SelectOffspring(pParams->tau, random, buffers);
+            if (population[parent1].condition.size() != population[parent2].condition.size())
             {
                 std::domain_error("The condition lengths of selected parents do not match in GA::Run().");
             }
 
-            Classifier child1(*parent1);
-            Classifier child2(*parent2);
-            child1.fitness = parent1->fitness / parent1->numerosity;
-            child2.fitness = parent2->fitness / parent2->numerosity;
+            // The children are made in the buffers to reuse the memory of their conditions
+            Classifier & child1 = buffers.child1;
+            Classifier & child2 = buffers.child2;
+            population[parent1].copyTo(child1);
+            population[parent2].copyTo(child2);
+            child1.fitness = population[parent1].fitness / population[parent1].numerosity;
+            child2.fitness = population[parent2].fitness / population[parent2].numerosity;
             child1.numerosity = child2.numerosity = 1;
             child1.experience = child2.experience = 0;
 
@@ -263,7 +292,7 @@ namespace xcspp::xcs
                 child2.fitness *= 0.1; // fitnessReduction
             }
 
-            insertDiscoveredClassifiers(child1, child2, parent1, parent2, population, pParams, random);
+            insertDiscoveredClassifiers(child1, child2, parent1, parent2, population, pParams, random, buffers.subsumers);
         }
     }
 
@@ -0,0 +1,269 @@
+#include "xcspp/core/xcs/inverted_match_index.hpp"
+#include <algorithm> // std::find, std::fill_n, std::min, std::sort
+#include <limits> // std::numeric_limits
+#include <stdexcept>
+
+namespace xcspp::xcs
+{
+
+    namespace
+    {
+        constexpr std::size_t kBitsPerWord = Condition::kBitsPerWord;
+        constexpr std::size_t kGroupWidth = InvertedMatchIndex::kGroupWidth;
+
+        constexpr std::size_t Pow3(std::size_t exponent)
+        {
+            return (exponent == 0) ? 1 : 3 * Pow3(exponent - 1);
+        }
+
+        // The number of posting lists per group
+        constexpr std::size_t kPostingsPerGroup = Pow3(kGroupWidth);
+
+        // Extract the bits of the positions [first, first + width) from the interleaved words
+        // (offset is 0 for the first words of the pairs, and 1 for the second words)
+        std::uint64_t ExtractBits(const std::uint64_t *words, std::size_t offset, std::size_t first, std::size_t width)
+        {
+            std::uint64_t bits = 0;
+            for (std::size_t i = 0; i < width; ++i)
+            {
+                const std::size_t p = first + i;
+                bits |= ((words[p / kBitsPerWord * 2 + offset] >> (p % kBitsPerWord)) & 1) << i;
+            }
+            return bits;
+        }
+    }
+
+    void InvertedMatchIndex::reset(std::size_t conditionLength)
+    {
+        m_conditionLength = conditionLength;
+        m_groupCount = (conditionLength + kGroupWidth - 1) / kGroupWidth;
+        m_wordCount = (conditionLength + kBitsPerWord - 1) / kBitsPerWord * 2;
+        m_postings.assign(m_groupCount * kPostingsPerGroup, {});
+        m_postingOffsets.clear();
+        m_columnWords.clear();
+        m_isIndexed.clear();
+        m_unindexedColumns.clear();
+        m_size = 0;
+    }
+
+    std::size_t InvertedMatchIndex::postingKey(std::size_t column, std::size_t group) const
+    {
+        const std::uint64_t *words = m_columnWords.data() + column * m_wordCount;
+        const std::size_t first = group * kGroupWidth;
+        const std::size_t width = std::min(kGroupWidth, m_conditionLength - first);
+        const std::uint64_t careBits = ExtractBits(words, 0, first, width);
+        const std::uint64_t valueBits = ExtractBits(words, 1, first, width);
+
+        std::size_t key = 0;
+        for (std::size_t i = 0, weight = 1; i < width; ++i, weight *= 3)
+        {
+            key += (((careBits >> i) & 1) ? ((valueBits >> i) & 1) : 2) * weight;
+        }
+        return key;
+    }
+
+    template <typename Func>
+    void InvertedMatchIndex::forEachAgreeingKey(const PackedSituation & situation, std::size_t group, Func func) const
+    {
+        const auto & words = situation.words();
+        const std::size_t first = group * kGroupWidth;
+        const std::size_t width = std::min(kGroupWidth, m_conditionLength - first);
+        const std::uint64_t valueBits = ExtractBits(words.data(), 0, first, width);
+
+        // Non-binary input values are rejected by any specified symbol, so only "#" agrees with them
+        const std::uint64_t binaryBits = ~ExtractBits(words.data(), 1, first, width) & ((std::uint64_t{ 1 } << width) - 1);
+
+        // Enumerate the subsets of the binary positions which have the specified symbols
+        const std::size_t allDontCareKey = Pow3(width) - 1;
+        std::uint64_t careBits = binaryBits;
+        while (true)
+        {
+            std::size_t key = allDontCareKey;
+            for (std::size_t i = 0, weight = 1; i < width; ++i, weight *= 3)
+            {
+                if ((careBits >> i) & 1)
+                {
+                    key -= (2 - ((valueBits >> i) & 1)) * weight;
+                }
+            }
+            func(key);
+
+            if (careBits == 0)
+            {
+                break;
+            }
+            careBits = (careBits - 1) & binaryBits;
+        }
+    }
+
+    InvertedMatchIndex::InvertedMatchIndex()
+        : m_conditionLength(0)
+        , m_groupCount(0)
+        , m_wordCount(0)
+        , m_size(0)
+    {
+    }
+
+    void InvertedMatchIndex::insert(std::size_t column, const Condition & condition)
+    {
+        if (m_size == 0 && condition.size() != m_conditionLength)
+        {
+            reset(condition.size());
+        }
+        else if (condition.size() != m_conditionLength)
+        {
+            throw std::invalid_argument("InvertedMatchIndex::insert() received a condition with a different length.");
+        }
+
+        if (column >= m_isIndexed.size())
+        {
+            m_postingOffsets.resize((column + 1) * m_groupCount, 0);
+            m_columnWords.resize((column + 1) * m_wordCount, 0);
+            m_isIndexed.resize(column + 1, 0);
+        }
+        else if (m_isIndexed[column])
+        {
+            throw std::invalid_argument("InvertedMatchIndex::insert() received a column in use.");
+        }
+        ++m_size;
+
+        if (!condition.isPacked())
+        {
+            m_unindexedColumns.push_back(column);
+            return;
+        }
+
+        std::uint64_t *words = m_columnWords.data() + column * m_wordCount;
+        for (std::size_t p = 0; p < m_conditionLength; ++p)
+        {
+            if (!condition.isDontCare(p))
+            {
+                words[p / kBitsPerWord * 2] |= std::uint64_t{ 1 } << (p % kBitsPerWord);
+                words[p / kBitsPerWord * 2 + 1] |= static_cast<std::uint64_t>(condition[p].value() == 1) << (p % kBitsPerWord);
+            }
+        }
+
+        for (std::size_t g = 0; g < m_groupCount; ++g)
+        {
+            auto & postings = m_postings[g * kPostingsPerGroup + postingKey(column, g)];
+            m_postingOffsets[column * m_groupCount + g] = static_cast<std::uint32_t>(postings.size());
+            postings.push_back(static_cast<std::uint32_t>(column));
+        }
+        m_isIndexed[column] = 1;
+    }
+
+    void InvertedMatchIndex::erase(std::size_t column)
+    {
+        if (column < m_isIndexed.size() && m_isIndexed[column])
+        {
+            // Remove the column from its posting lists by moving the last element into its place
+            for (std::size_t g = 0; g < m_groupCount; ++g)
+            {
+                auto & postings = m_postings[g * kPostingsPerGroup + postingKey(column, g)];
+                const std::uint32_t offset = m_postingOffsets[column * m_groupCount + g];
+                const std::uint32_t movedColumn = postings.back();
+                postings[offset] = movedColumn;
+                m_postingOffsets[movedColumn * m_groupCount + g] = offset;
+                postings.pop_back();
+            }
+
+            std::fill_n(m_columnWords.begin() + column * m_wordCount, m_wordCount, 0);
+            m_isIndexed[column] = 0;
+        }
+        else
+        {
+            const auto it = std::find(m_unindexedColumns.begin(), m_unindexedColumns.end(), column);
+            if (it == m_unindexedColumns.end())
+            {
+                throw std::invalid_argument("InvertedMatchIndex::erase() received a column not in use.");
+            }
+            *it = m_unindexedColumns.back();
+            m_unindexedColumns.pop_back();
+        }
+
+        --m_size;
+    }
+
+    void InvertedMatchIndex::clear()
+    {
+        reset(0);
+    }
+
+    std::size_t InvertedMatchIndex::mostSelectiveGroup(const PackedSituation & situation, std::size_t & candidateCount) const
+    {
+        if (situation.size() != m_conditionLength)
+        {
+            throw std::invalid_argument("InvertedMatchIndex could not process the situation with a different length.");
+        }
+
+        std::size_t bestGroup = 0;
+        candidateCount = std::numeric_limits<std::size_t>::max();
+        for (std::size_t g = 0; g < m_groupCount && candidateCount > 0; ++g)
+        {
+            std::size_t count = 0;
+            forEachAgreeingKey(situation, g, [&](std::size_t key) {
+                count += m_postings[g * kPostingsPerGroup + key].size();
+            });
+            if (count < candidateCount)
+            {
+                bestGroup = g;
+                candidateCount = count;
+            }
+        }
+        return bestGroup;
+    }
+
+    void InvertedMatchIndex::match(const PackedSituation & situation, std::vector<std::size_t> & matchedColumns) const
+    {
+        matchedColumns.clear();
+
+        if (m_size == 0 || m_conditionLength == 0)
+        {
+            for (std::size_t column = 0; column < m_isIndexed.size(); ++column)
+            {
+                if (m_isIndexed[column])
+                {
+                    matchedColumns.push_back(column);
+                }
+            }
+            return;
+        }
+
+        std::size_t candidateCount;
+        const std::size_t g = mostSelectiveGroup(situation, candidateCount);
+
+        // Verify the candidates with all positions at once
+        const auto & situationWords = situation.words();
+        forEachAgreeingKey(situation, g, [&](std::size_t key) {
+            for (const auto & column : m_postings[g * kPostingsPerGroup + key])
+            {
+                const std::uint64_t *columnWords = m_columnWords.data() + column * m_wordCount;
+                std::uint64_t mismatch = 0;
+                for (std::size_t w = 0; w < m_wordCount; w += 2)
+                {
+                    mismatch |= columnWords[w] & ((columnWords[w + 1] ^ situationWords[w]) | situationWords[w + 1]);
+                }
+                if (mismatch == 0)
+                {
+                    matchedColumns.push_back(column);
+                }
+            }
+        });
+
+        // Posting lists are not ordered after removals
+        std::sort(matchedColumns.begin(), matchedColumns.end());
+    }
+
+    std::size_t InvertedMatchIndex::candidateCount(const PackedSituation & situation) const
+    {
+        if (m_size == 0 || m_conditionLength == 0)
+        {
+            return m_size - m_unindexedColumns.size();
+        }
+
+        std::size_t count;
+        mostSelectiveGroup(situation, count);
+        return count;
+    }
+
+}
@@ -0,0 +1,117 @@
+#include "xcspp/core/xcs/match_set_cache.hpp"
+#include <algorithm> // std::lower_bound
+
+namespace xcspp::xcs
+{
+
+    std::size_t MatchSetCache::SituationHash::operator() (const std::vector<int> & situation) const noexcept
+    {
+        // FNV-1a
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (const auto & value : situation)
+        {
+            hash ^= static_cast<std::uint32_t>(value);
+            hash *= 1099511628211ULL;
+        }
+        return static_cast<std::size_t>(hash);
+    }
+
+    std::size_t MatchSetCache::EstimateMemoryUsage(const std::vector<int> & situation, const Entry & entry)
+    {
+        // The key and the entry with rough estimates of the nodes of the hash map and the list
+        constexpr std::size_t kNodeOverhead = sizeof(std::vector<int>) + sizeof(Entry) + 6 * sizeof(void *);
+        return kNodeOverhead + situation.capacity() * sizeof(int) + entry.matchedIndices.capacity() * sizeof(std::uint32_t);
+    }
+
+    void MatchSetCache::evictLeastRecentlyUsed()
+    {
+        const auto it = m_entries.find(*m_recentlyUsedSituations.back());
+        m_memoryUsage -= it->second.memoryUsage;
+        m_recentlyUsedSituations.pop_back();
+        m_entries.erase(it);
+    }
+
+    MatchSetCache::MatchSetCache(const XCSParams *pParams)
+        : m_pParams(pParams)
+        , m_memoryUsage(0)
+        , m_hitCount(0)
+        , m_missCount(0)
+    {
+    }
+
+    void MatchSetCache::match(const Population & population, const std::vector<int> & situation, const PackedSituation & packedSituation, std::vector<std::size_t> & matchedIndices)
+    {
+        if (!isEnabled())
+        {
+            population.match(packedSituation, matchedIndices);
+            return;
+        }
+
+        auto it = m_entries.find(situation);
+        if (it == m_entries.end())
+        {
+            ++m_missCount;
+            population.match(packedSituation, matchedIndices);
+
+            it = m_entries.emplace(situation, Entry()).first;
+            auto & entry = it->second;
+            entry.matchedIndices.assign(matchedIndices.begin(), matchedIndices.end());
+            entry.epoch = population.epoch();
+            m_recentlyUsedSituations.push_front(&it->first);
+            entry.recentlyUsedIterator = m_recentlyUsedSituations.begin();
+            entry.memoryUsage = EstimateMemoryUsage(it->first, entry);
+            m_memoryUsage += entry.memoryUsage;
+        }
+        else
+        {
+            ++m_hitCount;
+            auto & entry = it->second;
+            m_recentlyUsedSituations.splice(m_recentlyUsedSituations.begin(), m_recentlyUsedSituations, entry.recentlyUsedIterator);
+
+            if (entry.epoch != population.epoch())
+            {
+                // Test again only the slots modified since the entry was updated
+                auto & indices = entry.matchedIndices;
+                const bool isRepaired = population.forEachChangedSlotSince(entry.epoch, [&](std::size_t idx) {
+                    const bool isMatched = population.isOccupied(idx) && population[idx].condition.matches(packedSituation);
+                    const auto pos = std::lower_bound(indices.begin(), indices.end(), static_cast<std::uint32_t>(idx));
+                    const bool isCached = (pos != indices.end() && *pos == idx);
+                    if (isMatched && !isCached)
+                    {
+                        indices.insert(pos, static_cast<std::uint32_t>(idx));
+                    }
+                    else if (!isMatched && isCached)
+                    {
+                        indices.erase(pos);
+                    }
+                });
+
+                if (!isRepaired)
+                {
+                    population.match(packedSituation, matchedIndices);
+                    indices.assign(matchedIndices.begin(), matchedIndices.end());
+                }
+                entry.epoch = population.epoch();
+
+                m_memoryUsage -= entry.memoryUsage;
+                entry.memoryUsage = EstimateMemoryUsage(it->first, entry);
+                m_memoryUsage += entry.memoryUsage;
+            }
+
+            matchedIndices.assign(entry.matchedIndices.begin(), entry.matchedIndices.end());
+        }
+
+        while (m_memoryUsage > m_pParams->matchSetCacheSize && !m_recentlyUsedSituations.empty())
+        {
+            evictLeastRecentlyUsed();
+        }
+    }
+
+    void MatchSetCache::clear()
+    {
+        m_entries.clear();
+        m_recentlyUsedSituations.clear();
+        m_memoryUsage = 0;
+    }
+
+}
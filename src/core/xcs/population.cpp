@@ -1,7 +1,14 @@
 #include "xcspp/core/xcs/population.hpp"
-#include <cstdint> // std::uint64_t
+#include <fstream>
+#include <algorithm> // std::fill, std::max, std::inplace_merge, std::remove_if, std::sort
+#include <stdexcept>
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <limits> // std::numeric_limits
+#include <type_traits> // std::is_lvalue_reference_v
+#include <utility> // std::forward, std::move, std::swap
 
-#include "xcspp/core/xcs/classifier_ptr_set.hpp"
+#include "xcspp/util/csv.hpp"
+#include "xcspp/util/fast_pow.hpp"
 #include "xcspp/util/random.hpp"
 
 namespace xcspp::xcs
@@ -9,45 +16,526 @@ namespace xcspp::xcs
 
     namespace
     {
-        // DELETION VOTE
-        double DeletionVote(const Classifier & cl, double averageFitness, std::uint64_t thetaDel, double delta)
+        // The length of the modification history kept at least
+        constexpr std::size_t kMinChangeLogSize = 1024;
+
+        // The end of the chain of a hash bucket
+        constexpr std::uint32_t kNoSlot = std::numeric_limits<std::uint32_t>::max();
+
+        // The epsilon of the slots without a valid cached accuracy
+        constexpr double kNoAccuracyEpsilon = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    Population::Population(const XCSParams *pParams, const std::unordered_set<int> & availableActions)
+        : m_pParams(pParams)
+        , m_availableActions(availableActions)
+        , m_actionOrdinals(availableActions)
+        , m_conditions(PageAllocator<Condition>(pParams->useHugePages))
+        , m_actions(PageAllocator<int>(pParams->useHugePages))
+        , m_predictions(PageAllocator<double>(pParams->useHugePages))
+        , m_epsilons(PageAllocator<double>(pParams->useHugePages))
+        , m_fitnesses(PageAllocator<double>(pParams->useHugePages))
+        , m_experiences(PageAllocator<std::uint64_t>(pParams->useHugePages))
+        , m_timeStamps(PageAllocator<std::uint64_t>(pParams->useHugePages))
+        , m_actionSetSizes(PageAllocator<double>(pParams->useHugePages))
+        , m_numerosities(PageAllocator<std::uint64_t>(pParams->useHugePages))
+        , m_accuracies(PageAllocator<double>(pParams->useHugePages))
+        , m_accuracyEpsilons(PageAllocator<double>(pParams->useHugePages))
+        , m_accuracyEpsilonZero(pParams->epsilonZero)
+        , m_accuracyAlpha(pParams->alpha)
+        , m_accuracyNu(pParams->nu)
+        , m_slotActionOrdinals(PageAllocator<std::uint32_t>(pParams->useHugePages))
+        , m_isOccupied(PageAllocator<std::uint8_t>(pParams->useHugePages))
+        , m_generations(PageAllocator<std::uint32_t>(pParams->useHugePages))
+        , m_size(0)
+        , m_hashes(PageAllocator<std::uint64_t>(pParams->useHugePages))
+        , m_nextSlotsInBucket(PageAllocator<std::uint32_t>(pParams->useHugePages))
+        , m_epoch(0)
+        , m_changeLogFirstEpoch(0)
+        , m_deletionWheel(pParams)
+        , m_subsumptionIndex(pParams)
+        , m_isModified(PageAllocator<std::uint8_t>(pParams->useHugePages))
+    {
+    }
+
+    Population::Population(const std::vector<Classifier> & initialClassifiers, const XCSParams *pParams, const std::unordered_set<int> & availableActions)
+        : Population(pParams, availableActions)
+    {
+        setClassifiers(initialClassifiers);
+    }
+
+    void Population::setClassifiers(const std::vector<Classifier> & classifiers)
+    {
+        // Replace classifiers
+        //   (Classifiers with the same condition and action are merged into the first one.)
+        clear();
+        for (const auto & cl : classifiers)
+        {
+            const std::uint64_t hash = cl.hash();
+            const std::size_t idx = find(cl, hash);
+            if (idx != slotCount())
+            {
+                m_numerosities[idx] += cl.numerosity;
+                markModified(idx);
+            }
+            else
+            {
+                insert(cl, hash);
+            }
+        }
+    }
+
+    void Population::inputCSV(std::istream & is, bool initClassifierVariables)
+    {
+        auto classifiers = CSV::ReadClassifiers<Classifier>(is);
+        if (initClassifierVariables)
+        {
+            for (auto & cl : classifiers)
+            {
+                cl.prediction = m_pParams->initialPrediction;
+                cl.epsilon = m_pParams->initialEpsilon;
+                cl.fitness = m_pParams->initialFitness;
+                cl.experience = 0;
+                cl.timeStamp = 0;
+                cl.actionSetSize = 1;
+                //cl.numerosity = 1; // commented out to keep macroclassifier as is
+            }
+        }
+        setClassifiers(classifiers);
+    }
+
+    void Population::outputCSV(std::ostream & os) const
+    {
+        os << "Condition,Action,prediction,epsilon,F,exp,ts,as,n,acc\n";
+        for (auto it = begin(); it != end(); ++it)
+        {
+            const auto cl = *it;
+            os  << cl.condition << ','
+                << cl.action << ','
+                << cl.prediction << ','
+                << cl.epsilon << ','
+                << cl.fitness << ','
+                << cl.experience << ','
+                << cl.timeStamp << ','
+                << cl.actionSetSize << ','
+                << cl.numerosity << ','
+                << accuracy(it.index()) << '\n';
+        }
+    }
+
+    bool Population::loadCSVFile(const std::string & filename, bool initClassifierVariables)
+    {
+        // Open file stream
+        std::ifstream ifs(filename);
+        if (!ifs.good())
+        {
+            return false;
+        }
+
+        // Read CSV
+        inputCSV(ifs, initClassifierVariables);
+        return true;
+    }
+
+    bool Population::saveCSVFile(const std::string & filename) const
+    {
+        // Open file stream
+        std::ofstream ofs(filename);
+        if (!ofs.good())
+        {
+            return false;
+        }
+
+        // Write CSV
+        outputCSV(ofs);
+        return true;
+    }
+
+    template <typename ClassifierType>
+    std::size_t Population::insert(ClassifierType && cl, std::uint64_t hash)
+    {
+        if (m_pParams->preallocate && m_freeSlots.empty() && m_isOccupied.size() < preallocatedSlotCount())
+        {
+            preallocateSlots(cl.condition);
+        }
+
+        std::size_t idx;
+        if (!m_freeSlots.empty())
+        {
+            // Reuse a released slot
+            idx = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            if constexpr (std::is_lvalue_reference_v<ClassifierType>)
+            {
+                m_conditions[idx] = cl.condition;
+            }
+            else
+            {
+                using std::swap;
+                swap(m_conditions[idx], cl.condition);
+            }
+            m_actions[idx] = cl.action;
+            m_predictions[idx] = cl.prediction;
+            m_epsilons[idx] = cl.epsilon;
+            m_fitnesses[idx] = cl.fitness;
+            m_experiences[idx] = cl.experience;
+            m_timeStamps[idx] = cl.timeStamp;
+            m_actionSetSizes[idx] = cl.actionSetSize;
+            m_numerosities[idx] = cl.numerosity;
+            m_accuracyEpsilons[idx] = kNoAccuracyEpsilon;
+            m_slotActionOrdinals[idx] = static_cast<std::uint32_t>(m_actionOrdinals.ordinalOf(cl.action));
+            m_isOccupied[idx] = 1;
+            m_hashes[idx] = hash;
+            markModified(idx);
+        }
+        else
+        {
+            idx = m_isOccupied.size();
+            reserveSlot();
+            m_conditions.push_back(std::forward<ClassifierType>(cl).condition);
+            m_actions.push_back(cl.action);
+            m_predictions.push_back(cl.prediction);
+            m_epsilons.push_back(cl.epsilon);
+            m_fitnesses.push_back(cl.fitness);
+            m_experiences.push_back(cl.experience);
+            m_timeStamps.push_back(cl.timeStamp);
+            m_actionSetSizes.push_back(cl.actionSetSize);
+            m_numerosities.push_back(cl.numerosity);
+            m_accuracies.push_back(0.0);
+            m_accuracyEpsilons.push_back(kNoAccuracyEpsilon);
+            m_slotActionOrdinals.push_back(static_cast<std::uint32_t>(m_actionOrdinals.ordinalOf(cl.action)));
+            m_isOccupied.push_back(1);
+            m_generations.push_back(0);
+            m_hashes.push_back(hash);
+            m_nextSlotsInBucket.push_back(kNoSlot);
+            m_isModified.push_back(0);
+            markModified(idx);
+        }
+
+        if (m_bucketHeads.size() < m_isOccupied.size())
+        {
+            rehash(m_isOccupied.size());
+        }
+        else
+        {
+            linkToBucket(idx);
+        }
+
+        if (usesInvertedIndex())
+        {
+            m_invertedIndex.insert(idx, m_conditions[idx]);
+        }
+        else
+        {
+            m_matcher.insert(idx, m_conditions[idx]);
+        }
+        ++m_size;
+        recordChange(idx);
+
+        return idx;
+    }
+
+    std::size_t Population::insert(const Classifier & cl)
+    {
+        return insert(cl, cl.hash());
+    }
+
+    std::size_t Population::insert(Classifier && cl)
+    {
+        const std::uint64_t hash = cl.hash();
+        return insert(std::move(cl), hash);
+    }
+
+    void Population::erase(std::size_t idx)
+    {
+        if (idx >= m_isOccupied.size() || !m_isOccupied[idx])
+        {
+            throw std::invalid_argument("Population::erase() received an empty slot.");
+        }
+
+        if (usesInvertedIndex())
+        {
+            m_invertedIndex.erase(idx);
+        }
+        else
+        {
+            m_matcher.erase(idx);
+        }
+
+        unlinkFromBucket(idx);
+
+        // Zero-fill the numeric members so that sums over all slots ignore the released slot
+        // (The condition is kept to reuse its buffer.)
+        m_predictions[idx] = 0.0;
+        m_epsilons[idx] = 0.0;
+        m_fitnesses[idx] = 0.0;
+        m_experiences[idx] = 0;
+        m_timeStamps[idx] = 0;
+        m_actionSetSizes[idx] = 0.0;
+        m_numerosities[idx] = 0;
+        m_accuracies[idx] = 0.0;
+        m_accuracyEpsilons[idx] = kNoAccuracyEpsilon;
+        m_isOccupied[idx] = 0;
+        ++m_generations[idx];
+        m_freeSlots.push_back(static_cast<std::uint32_t>(idx));
+        m_subsumptionIndex.erase(idx);
+        markModified(idx);
+        --m_size;
+        recordChange(idx);
+    }
+
+    void Population::clear()
+    {
+        m_conditions.clear();
+        m_actions.clear();
+        m_predictions.clear();
+        m_epsilons.clear();
+        m_fitnesses.clear();
+        m_experiences.clear();
+        m_timeStamps.clear();
+        m_actionSetSizes.clear();
+        m_numerosities.clear();
+        m_accuracies.clear();
+        m_accuracyEpsilons.clear();
+        m_slotActionOrdinals.clear();
+        m_isOccupied.clear();
+        m_generations.clear();
+        m_freeSlots.clear();
+        m_size = 0;
+        m_hashes.clear();
+        m_nextSlotsInBucket.clear();
+        m_bucketHeads.clear();
+        m_deletionWheel.clear();
+        m_subsumptionIndex.clear();
+        m_isModified.clear();
+        m_modifiedSlots.clear();
+
+        // Slots are reused from the beginning, so the history before clearing is useless
+        ++m_epoch;
+        m_changeLogFirstEpoch = m_epoch;
+        m_changedSlots.clear();
+        m_matcher.clear();
+        m_invertedIndex.clear();
+    }
+
+    void Population::reserveSlot()
+    {
+        const std::size_t chunkSize = m_pParams->populationChunkSize;
+        if (chunkSize == 0 || m_isOccupied.size() < m_isOccupied.capacity())
+        {
+            return;
+        }
+
+        const std::size_t capacity = (m_isOccupied.size() / chunkSize + 1) * chunkSize;
+        m_conditions.reserve(capacity);
+        m_actions.reserve(capacity);
+        m_predictions.reserve(capacity);
+        m_epsilons.reserve(capacity);
+        m_fitnesses.reserve(capacity);
+        m_experiences.reserve(capacity);
+        m_timeStamps.reserve(capacity);
+        m_actionSetSizes.reserve(capacity);
+        m_numerosities.reserve(capacity);
+        m_accuracies.reserve(capacity);
+        m_accuracyEpsilons.reserve(capacity);
+        m_slotActionOrdinals.reserve(capacity);
+        m_isOccupied.reserve(capacity);
+        m_generations.reserve(capacity);
+        m_hashes.reserve(capacity);
+        m_nextSlotsInBucket.reserve(capacity);
+        m_isModified.reserve(capacity);
+    }
+
+    std::size_t Population::preallocatedSlotCount() const noexcept
+    {
+        return m_pParams->n + std::max<std::size_t>(2, m_actionOrdinals.size());
+    }
+
+    void Population::preallocateSlots(const Condition & condition)
+    {
+        const std::size_t firstIdx = m_isOccupied.size();
+        const std::size_t capacity = preallocatedSlotCount();
+        m_conditions.reserve(capacity);
+        m_actions.reserve(capacity);
+        m_predictions.reserve(capacity);
+        m_epsilons.reserve(capacity);
+        m_fitnesses.reserve(capacity);
+        m_experiences.reserve(capacity);
+        m_timeStamps.reserve(capacity);
+        m_actionSetSizes.reserve(capacity);
+        m_numerosities.reserve(capacity);
+        m_accuracies.reserve(capacity);
+        m_accuracyEpsilons.reserve(capacity);
+        m_slotActionOrdinals.reserve(capacity);
+        m_isOccupied.reserve(capacity);
+        m_generations.reserve(capacity);
+        m_hashes.reserve(capacity);
+        m_nextSlotsInBucket.reserve(capacity);
+        m_isModified.reserve(capacity);
+        for (std::size_t idx = firstIdx; idx < capacity; ++idx)
+        {
+            m_conditions.push_back(condition);
+            m_actions.push_back(0);
+            m_predictions.push_back(0.0);
+            m_epsilons.push_back(0.0);
+            m_fitnesses.push_back(0.0);
+            m_experiences.push_back(0);
+            m_timeStamps.push_back(0);
+            m_actionSetSizes.push_back(0.0);
+            m_numerosities.push_back(0);
+            m_accuracies.push_back(0.0);
+            m_accuracyEpsilons.push_back(kNoAccuracyEpsilon);
+            m_slotActionOrdinals.push_back(0);
+            m_isOccupied.push_back(0);
+            m_generations.push_back(0);
+            m_hashes.push_back(0);
+            m_nextSlotsInBucket.push_back(kNoSlot);
+            m_isModified.push_back(0);
+        }
+
+        // The free list is used from the back, so the new slots are used in ascending order as if they were appended
+        m_freeSlots.reserve(capacity);
+        for (std::size_t idx = capacity; idx > firstIdx; --idx)
+        {
+            m_freeSlots.push_back(static_cast<std::uint32_t>(idx - 1));
+        }
+
+        m_modifiedSlots.reserve(capacity);
+        m_changedSlots.reserve(std::max(capacity, kMinChangeLogSize));
+        m_deletionWheel.reserve(capacity);
+        m_subsumptionIndex.reserve(capacity);
+        m_matcher.reserve(capacity, condition.size());
+        rehash(capacity);
+    }
+
+    void Population::linkToBucket(std::size_t idx)
+    {
+        auto & head = m_bucketHeads[m_hashes[idx] & (m_bucketHeads.size() - 1)];
+        m_nextSlotsInBucket[idx] = head;
+        head = static_cast<std::uint32_t>(idx);
+    }
+
+    void Population::unlinkFromBucket(std::size_t idx)
+    {
+        std::uint32_t *pLink = &m_bucketHeads[m_hashes[idx] & (m_bucketHeads.size() - 1)];
+        while (*pLink != idx)
+        {
+            pLink = &m_nextSlotsInBucket[*pLink];
+        }
+        *pLink = m_nextSlotsInBucket[idx];
+    }
+
+    void Population::rehash(std::size_t slotCount)
+    {
+        std::size_t bucketCount = 16;
+        while (bucketCount < slotCount)
         {
-            double vote = cl.actionSetSize * cl.numerosity;
+            bucketCount *= 2;
+        }
+        m_bucketHeads.assign(bucketCount, kNoSlot);
 
-            // Consider fitness for deletion vote
-            if ((cl.experience >= thetaDel) && (cl.fitness / cl.numerosity < delta * averageFitness))
+        for (std::size_t i = 0; i < m_isOccupied.size(); ++i)
+        {
+            if (m_isOccupied[i])
             {
-                vote *= averageFitness / (cl.fitness / cl.numerosity);
+                linkToBucket(i);
             }
+        }
+    }
+
+    void Population::recordChange(std::size_t idx)
+    {
+        // Discard the history when it becomes longer than the population, since replaying it
+        // would cost more than generating the match set from scratch
+        if (m_changedSlots.size() >= std::max(m_isOccupied.size(), kMinChangeLogSize))
+        {
+            m_changeLogFirstEpoch = m_epoch;
+            m_changedSlots.clear();
+        }
+        m_changedSlots.push_back(static_cast<std::uint32_t>(idx));
+        ++m_epoch;
+    }
+
+    std::size_t Population::find(const ConditionActionPair & cl) const
+    {
+        return find(cl, cl.hash());
+    }
 
-            return vote;
+    std::size_t Population::find(const ConditionActionPair & cl, std::uint64_t hash) const
+    {
+        // Choose the smallest slot index in case there are duplicates inserted by insert()
+        std::size_t foundIdx = slotCount();
+        if (m_bucketHeads.empty())
+        {
+            return foundIdx;
+        }
+
+        for (std::uint32_t idx = m_bucketHeads[hash & (m_bucketHeads.size() - 1)]; idx != kNoSlot; idx = m_nextSlotsInBucket[idx])
+        {
+            if (idx < foundIdx && m_hashes[idx] == hash && m_actions[idx] == cl.action && m_conditions[idx] == cl.condition)
+            {
+                foundIdx = idx;
+            }
         }
+        return foundIdx;
     }
 
     // INSERT IN POPULATION
-    void Population::insertOrIncrementNumerosity(const ClassifierPtr & cl)
+    void Population::insertOrIncrementNumerosity(const Classifier & cl)
+    {
+        const std::uint64_t hash = cl.hash();
+        const std::size_t idx = find(cl, hash);
+        if (idx != slotCount())
+        {
+            ++m_numerosities[idx];
+            markModified(idx);
+        }
+        else
+        {
+            insert(cl, hash);
+        }
+    }
+
+    void Population::insertOrIncrementNumerosity(Classifier && cl)
+    {
+        const std::uint64_t hash = cl.hash();
+        const std::size_t idx = find(cl, hash);
+        if (idx != slotCount())
+        {
+            ++m_numerosities[idx];
+            markModified(idx);
+        }
+        else
+        {
+            insert(std::move(cl), hash);
+        }
+    }
+
+    void Population::applyModifications()
     {
-        for (auto & c : m_set)
+        if (m_subsumptionIndex.isOutdated())
         {
-            if (c->condition == cl->condition && c->action == cl->action)
+            m_subsumptionIndex.clear();
+            for (std::size_t i = 0; i < m_isOccupied.size(); ++i)
             {
-                ++c->numerosity;
-                return;
+                markModified(i);
             }
         }
-        m_set.insert(cl);
+
+        for (const auto & idx : m_modifiedSlots)
+        {
+            m_deletionWheel.update(idx, m_actionSetSizes[idx], m_numerosities[idx], m_fitnesses[idx], m_experiences[idx]);
+            m_subsumptionIndex.update(idx, m_conditions[idx], m_actions[idx], m_experiences[idx], m_epsilons[idx]);
+            m_isModified[idx] = 0;
+        }
+        m_modifiedSlots.clear();
     }
 
     // DELETE FROM POPULATION
     bool Population::deleteExtraClassifiers(Random & random)
     {
-        uint64_t numerositySum = 0;
-        double fitnessSum = 0.0;
-        for (const auto & c : m_set)
-        {
-            numerositySum += c->numerosity;
-            fitnessSum += c->fitness;
-        }
+        applyModifications();
+        const std::uint64_t numerositySum = m_deletionWheel.numerositySum();
 
         // Return false if the sum of numerosity has not met its maximum limit
         if (numerositySum <= m_pParams->n)
@@ -55,35 +543,147 @@ namespace xcspp::xcs
             return false;
         }
 
-        // The average fitness in the population
-        double averageFitness = fitnessSum / numerositySum;
+        // Roulette-wheel selection
+        const std::size_t selectedIdx = m_deletionWheel.select(random);
 
-        std::vector<const ClassifierPtr *> targets;
-        for (const auto & cl : m_set)
+        // Distrust the selected classifier
+        if (m_numerosities[selectedIdx] > 1)
         {
-            targets.push_back(&cl);
+            m_numerosities[selectedIdx]--;
+            markModified(selectedIdx);
         }
-
-        // Roulette-wheel selection
-        std::vector<double> votes;
-        votes.reserve(targets.size());
-        for (const auto & target : targets)
+        else
         {
-            votes.push_back(DeletionVote(**target, averageFitness, m_pParams->thetaDel, m_pParams->delta));
+            erase(selectedIdx);
         }
-        std::size_t selectedIdx = random.rouletteWheelSelection(votes);
 
-        // Distrust the selected classifier
-        if ((*targets[selectedIdx])->numerosity > 1)
+        return (numerositySum - 1) > m_pParams->n;
+    }
+
+    void Population::match(const PackedSituation & situation, std::vector<std::size_t> & matchedIndices) const
+    {
+        if (usesInvertedIndex())
         {
-            (*targets[selectedIdx])->numerosity--;
+            m_invertedIndex.match(situation, matchedIndices);
         }
         else
         {
-            m_set.erase(*targets[selectedIdx]);
+            m_matcher.match(situation, matchedIndices);
         }
 
-        return (numerositySum - 1) > m_pParams->n;
+        // Conditions with non-binary symbols are matched one by one
+        const std::size_t indexedCount = matchedIndices.size();
+        const auto & unindexedIndices = usesInvertedIndex() ? m_invertedIndex.unindexedColumns() : m_matcher.unslicedColumns();
+        for (const auto & idx : unindexedIndices)
+        {
+            if (m_conditions[idx].matches(situation))
+            {
+                matchedIndices.push_back(idx);
+            }
+        }
+
+        // Keep the ascending order
+        if (matchedIndices.size() > indexedCount)
+        {
+            std::sort(matchedIndices.begin() + indexedCount, matchedIndices.end());
+            std::inplace_merge(matchedIndices.begin(), matchedIndices.begin() + indexedCount, matchedIndices.end());
+        }
+    }
+
+    void Population::partitionByAction(std::vector<std::size_t> & indices, std::vector<std::size_t> & partitionBegins, std::vector<std::size_t> & buffer) const
+    {
+        // Counting sort by action ordinal (the last partition is for the actions that are not available)
+        const std::size_t partitionCount = m_actionOrdinals.size() + 1;
+        partitionBegins.assign(partitionCount + 1, 0);
+        for (const auto & idx : indices)
+        {
+            ++partitionBegins[m_slotActionOrdinals[idx] + 1];
+        }
+        for (std::size_t i = 1; i <= partitionCount; ++i)
+        {
+            partitionBegins[i] += partitionBegins[i - 1];
+        }
+
+        // Place the slots from the beginning of each partition, which moves partitionBegins[i] to the end of the
+        // partition i, and shift them back afterwards
+        buffer.resize(indices.size());
+        for (const auto & idx : indices)
+        {
+            buffer[partitionBegins[m_slotActionOrdinals[idx]]++] = idx;
+        }
+        for (std::size_t i = partitionCount; i > 0; --i)
+        {
+            partitionBegins[i] = partitionBegins[i - 1];
+        }
+        partitionBegins[0] = 0;
+
+        indices.swap(buffer);
+    }
+
+    // COULD SUBSUME
+    bool Population::isSubsumer(std::size_t idx) const
+    {
+        return m_experiences[idx] > m_pParams->thetaSub && m_epsilons[idx] < m_pParams->epsilonZero;
+    }
+
+    // DOES SUBSUME
+    bool Population::subsumes(std::size_t idx, const ConditionActionPair & cl) const
+    {
+        return m_actions[idx] == cl.action && isSubsumer(idx) && m_conditions[idx].isMoreGeneral(cl.condition);
+    }
+
+    void Population::collectSubsumers(const ConditionActionPair & cl, std::vector<std::size_t> & subsumerIndices)
+    {
+        applyModifications();
+        m_subsumptionIndex.collectCandidates(cl, subsumerIndices);
+        subsumerIndices.erase(
+            std::remove_if(subsumerIndices.begin(), subsumerIndices.end(), [&](std::size_t idx) { return !subsumes(idx, cl); }),
+            subsumerIndices.end());
+        std::sort(subsumerIndices.begin(), subsumerIndices.end());
+    }
+
+    bool Population::mayBeMoreGeneral(std::size_t idx, std::size_t otherIdx)
+    {
+        applyModifications();
+        return m_subsumptionIndex.mayBeMoreGeneral(idx, otherIdx);
+    }
+
+    void Population::validateAccuracyCache() const
+    {
+        if (m_accuracyEpsilonZero != m_pParams->epsilonZero || m_accuracyAlpha != m_pParams->alpha || m_accuracyNu != m_pParams->nu)
+        {
+            m_accuracyEpsilonZero = m_pParams->epsilonZero;
+            m_accuracyAlpha = m_pParams->alpha;
+            m_accuracyNu = m_pParams->nu;
+            std::fill(m_accuracyEpsilons.begin(), m_accuracyEpsilons.end(), kNoAccuracyEpsilon);
+        }
+    }
+
+    double Population::accuracy(std::size_t idx) const
+    {
+        validateAccuracyCache();
+
+        // (NaN is not equal to any epsilon.)
+        if (m_accuracyEpsilons[idx] != m_epsilons[idx])
+        {
+            if (m_epsilons[idx] < m_pParams->epsilonZero)
+            {
+                m_accuracies[idx] = 1.0;
+            }
+            else
+            {
+                m_accuracies[idx] = m_pParams->alpha * FastPow(m_pParams->epsilonZero / m_epsilons[idx], m_pParams->nu);
+            }
+            m_accuracyEpsilons[idx] = m_epsilons[idx];
+        }
+        return m_accuracies[idx];
+    }
+
+    void Population::cacheAccuracy(std::size_t idx, double accuracy)
+    {
+        validateAccuracyCache();
+        m_accuracies[idx] = accuracy;
+        m_accuracyEpsilons[idx] = m_epsilons[idx];
     }
 
 }
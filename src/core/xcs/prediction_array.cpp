@@ -1,4 +1,5 @@
 #include "xcspp/core/xcs/prediction_array.hpp"
+#include <algorithm> // std::fill, std::max
 #include <cfloat> // DBL_EPSILON
 #include <cmath> // std::abs
 
@@ -13,44 +14,90 @@ namespace xcspp::xcs
         constexpr double kInitialMaxPA = -100000.0;
     }
 
-    // GENERATE PREDICTION ARRAY
-    PredictionArray::PredictionArray(const MatchSet & matchSet, const XCSParams *pParams)
+    PredictionArray::PredictionArray(const std::unordered_set<int> & availableActions, const XCSParams *pParams)
         : m_pParams(pParams)
+        , m_actionOrdinals(availableActions)
+        , m_pa(m_actionOrdinals.size(), 0.0)
+        , m_fsa(m_actionOrdinals.size(), 0.0)
+        , m_isInMatchSet(m_actionOrdinals.size(), 0)
+        , m_maxPA(kInitialMaxPA)
     {
-        // FSA (Fitness Sum Array)
-        std::unordered_map<int, double> fsa;
-
-        for (const auto & cl : matchSet)
-        {
-            if (m_pa.count(cl->action) == 0) {
-                m_paActions.push_back(cl->action);
-            }
+        m_paActions.reserve(m_actionOrdinals.size());
+        m_maxPAActions.reserve(m_actionOrdinals.size());
+    }
 
-            // Note: it is okay to skip zero initialization before these
-            //       because std::unordered_map::operator[] does zero initialization.
-            m_pa[cl->action] += cl->prediction * cl->fitness;
-            fsa[cl->action] += cl->fitness;
-        }
+    // GENERATE PREDICTION ARRAY
+    PredictionArray::PredictionArray(const MatchSet & matchSet, const Population & population, const XCSParams *pParams)
+        : PredictionArray(matchSet.availableActions(), pParams)
+    {
+        generate(matchSet, population);
+    }
 
-        m_maxPA = kInitialMaxPA;
+    // GENERATE PREDICTION ARRAY
+    void PredictionArray::generate(const MatchSet & matchSet, const Population & population)
+    {
+        std::fill(m_pa.begin(), m_pa.end(), 0.0);
+        std::fill(m_fsa.begin(), m_fsa.end(), 0.0);
+        std::fill(m_isInMatchSet.begin(), m_isInMatchSet.end(), std::uint8_t{ 0 });
 
-        for (auto & [ action, prediction ] : m_pa)
+        if (matchSet.isPartitioned() && matchSet.actionOrdinals().actions() == m_actionOrdinals.actions())
         {
-            if (std::abs(fsa[action]) > 0.0)
+            // Sum up each partition of [M] (the last one is for the actions that are not available)
+            if (matchSet.partitionBegin(m_actionOrdinals.size()) != matchSet.partitionEnd(m_actionOrdinals.size()))
             {
-                prediction /= fsa[action];
+                throw std::runtime_error("PredictionArray::generate() found a classifier whose action is not available.");
             }
-
-            // Update the best actions
-            if (std::abs(m_maxPA - prediction) < DBL_EPSILON) // m_maxPA == prediction
+            for (std::size_t i = 0; i < m_actionOrdinals.size(); ++i)
             {
-                m_maxPAActions.push_back(action);
+                for (auto it = matchSet.partitionBegin(i); it != matchSet.partitionEnd(i); ++it)
+                {
+                    const auto cl = population[*it];
+                    m_pa[i] += cl.prediction * cl.fitness;
+                    m_fsa[i] += cl.fitness;
+                }
+                m_isInMatchSet[i] = (matchSet.partitionBegin(i) != matchSet.partitionEnd(i));
             }
-            else if (m_maxPA < prediction)
+        }
+        else
+        {
+            for (const auto & handle : matchSet)
+            {
+                const auto cl = population[handle];
+
+                const std::size_t i = m_actionOrdinals.ordinalOf(cl.action);
+                if (i == m_actionOrdinals.size())
+                {
+                    throw std::runtime_error("PredictionArray::generate() found a classifier whose action is not available.");
+                }
+
+                m_pa[i] += cl.prediction * cl.fitness;
+                m_fsa[i] += cl.fitness;
+                m_isInMatchSet[i] = 1;
+            }
+        }
+
+        // Normalize PA and take its maximum in a single pass over the contiguous arrays
+        // (The loop has no data-dependent branch so that the compiler can vectorize it.)
+        double maxPA = kInitialMaxPA;
+        for (std::size_t i = 0; i < m_pa.size(); ++i)
+        {
+            m_pa[i] = (std::abs(m_fsa[i]) > 0.0) ? m_pa[i] / m_fsa[i] : m_pa[i];
+            maxPA = std::max(maxPA, m_isInMatchSet[i] ? m_pa[i] : kInitialMaxPA);
+        }
+        m_maxPA = maxPA;
+
+        // Collect the actions in [M] and the best actions
+        m_paActions.clear();
+        m_maxPAActions.clear();
+        for (std::size_t i = 0; i < m_pa.size(); ++i)
+        {
+            if (m_isInMatchSet[i])
             {
-                m_maxPAActions.clear();
-                m_maxPAActions.push_back(action);
-                m_maxPA = prediction;
+                m_paActions.push_back(m_actionOrdinals.action(i));
+                if (std::abs(m_maxPA - m_pa[i]) < DBL_EPSILON) // m_maxPA == m_pa[i]
+                {
+                    m_maxPAActions.push_back(m_actionOrdinals.action(i));
+                }
             }
         }
     }
@@ -68,7 +115,8 @@ namespace xcspp::xcs
 
     double PredictionArray::predictionFor(int action) const
     {
-        return m_pa.count(action) ? m_pa.at(action) : 0.0;
+        const std::size_t i = m_actionOrdinals.ordinalOf(action);
+        return (i < m_pa.size()) ? m_pa[i] : 0.0;
     }
 
     // SELECT ACTION
@@ -0,0 +1,93 @@
+#include "xcspp/core/xcs/subsumption_index.hpp"
+#include <limits> // std::numeric_limits
+
+namespace xcspp::xcs
+{
+
+    SubsumptionIndex::SubsumptionIndex(const XCSParams *pParams)
+        : m_pParams(pParams)
+        , m_thetaSub(pParams->thetaSub)
+        , m_epsilonZero(pParams->epsilonZero)
+    {
+    }
+
+    void SubsumptionIndex::update(std::size_t idx, const Condition & condition, int action, std::uint64_t experience, double epsilon)
+    {
+        // COULD SUBSUME
+        const bool isSubsumer = experience > m_thetaSub && epsilon < m_epsilonZero;
+
+        if (isSubsumer && !contains(idx))
+        {
+            if (idx >= m_isIndexed.size())
+            {
+                m_isIndexed.resize(idx + 1, 0);
+                m_actions.resize(idx + 1, 0);
+                m_generalities.resize(idx + 1, 0);
+            }
+            m_isIndexed[idx] = 1;
+            m_actions[idx] = action;
+            m_generalities[idx] = condition.dontCareCount();
+            m_nodePool.insert(m_subsumers, { action, m_generalities[idx], static_cast<std::uint32_t>(idx) });
+        }
+        else if (!isSubsumer)
+        {
+            erase(idx);
+        }
+    }
+
+    void SubsumptionIndex::erase(std::size_t idx)
+    {
+        if (contains(idx))
+        {
+            m_nodePool.erase(m_subsumers, { m_actions[idx], m_generalities[idx], static_cast<std::uint32_t>(idx) });
+            m_isIndexed[idx] = 0;
+        }
+    }
+
+    void SubsumptionIndex::clear()
+    {
+        m_thetaSub = m_pParams->thetaSub;
+        m_epsilonZero = m_pParams->epsilonZero;
+        m_nodePool.clear(m_subsumers);
+        m_isIndexed.clear();
+        m_actions.clear();
+        m_generalities.clear();
+    }
+
+    void SubsumptionIndex::reserve(std::size_t slotCount)
+    {
+        if (slotCount > m_isIndexed.size())
+        {
+            m_isIndexed.resize(slotCount, 0);
+            m_actions.resize(slotCount, 0);
+            m_generalities.resize(slotCount, 0);
+        }
+        if (slotCount > m_subsumers.size() + m_nodePool.size())
+        {
+            m_nodePool.reserve(slotCount - m_subsumers.size());
+        }
+    }
+
+    bool SubsumptionIndex::isOutdated() const noexcept
+    {
+        return m_thetaSub != m_pParams->thetaSub || m_epsilonZero != m_pParams->epsilonZero;
+    }
+
+    void SubsumptionIndex::collectCandidates(const ConditionActionPair & cl, std::vector<std::size_t> & candidateIndices) const
+    {
+        candidateIndices.clear();
+
+        // A more general condition has strictly more "#" symbols
+        const std::tuple<int, std::size_t, std::uint32_t> lowerBound(cl.action, cl.condition.dontCareCount(), std::numeric_limits<std::uint32_t>::max());
+        for (auto it = m_subsumers.upper_bound(lowerBound); it != m_subsumers.end() && std::get<0>(*it) == cl.action; ++it)
+        {
+            candidateIndices.push_back(std::get<2>(*it));
+        }
+    }
+
+    bool SubsumptionIndex::mayBeMoreGeneral(std::size_t idx, std::size_t otherIdx) const
+    {
+        return m_generalities[idx] > m_generalities[otherIdx];
+    }
+
+}
@@ -1,6 +1,5 @@
 #include "xcspp/core/xcs/xcs.hpp"
 #include <iostream>
-#include <memory> // std::make_shared
 
 #include "xcspp/core/xcs/match_set.hpp"
 #include "xcspp/util/csv.hpp"
@@ -13,18 +12,22 @@ namespace xcspp::xcs
         m_timeStamp = 0;
         for (const auto & cl : m_population)
         {
-            if (m_timeStamp < cl->timeStamp)
+            if (m_timeStamp < cl.timeStamp)
             {
-                m_timeStamp = cl->timeStamp;
+                m_timeStamp = cl.timeStamp;
             }
         }
     }
 
     XCS::XCS(const std::unordered_set<int> & availableActions, const XCSParams & params)
-        : m_params(params)
+        : m_random(params.seed, params.randomEngine)
+        , m_params(params)
         , m_population(&m_params, availableActions)
         , m_actionSet(&m_params, availableActions)
         , m_prevActionSet(&m_params, availableActions)
+        , m_matchSet(&m_params, availableActions)
+        , m_predictionArray(availableActions, &m_params)
+        , m_matchSetCache(&m_params)
         , m_availableActions(availableActions)
         , m_timeStamp(0)
         , m_expectsReward(false)
@@ -33,6 +36,12 @@ namespace xcspp::xcs
         , m_prediction(0.0)
         , m_isCoveringPerformed(false)
     {
+        if (m_params.preallocate)
+        {
+            m_matchSet.reserve(m_population.preallocatedSlotCount());
+            m_actionSet.reserve(m_population.preallocatedSlotCount());
+            m_prevActionSet.reserve(m_population.preallocatedSlotCount());
+        }
     }
 
     int XCS::explore(const std::vector<int> & situation)
@@ -45,26 +54,23 @@ namespace xcspp::xcs
         // [M]
         //   The match set [M] is formed out of the current [P].
         //   It includes all classifiers that match the current situation.
-        const MatchSet matchSet(m_population, situation, m_timeStamp, &m_params, m_availableActions, m_random);
-        m_isCoveringPerformed = matchSet.isCoveringPerformed();
+        m_matchSet.generateSet(m_population, situation, m_timeStamp, m_random, &m_matchSetCache);
+        m_isCoveringPerformed = m_matchSet.isCoveringPerformed();
 
-        const PredictionArray predictionArray(matchSet, &m_params);
+        m_predictionArray.generate(m_matchSet, m_population);
 
-        const int action = predictionArray.selectAction(m_params.exploreProbability, m_random);
-        m_prediction = predictionArray.predictionFor(action);
-        for (const auto & a : m_availableActions)
-        {
-            m_predictions[a] = predictionArray.predictionFor(a);
-        }
+        const int action = m_predictionArray.selectAction(m_params.exploreProbability, m_random);
+        m_prediction = m_predictionArray.predictionFor(action);
+        m_predictions = m_predictionArray.predictions();
 
-        m_actionSet.generateSet(matchSet, action);
+        m_actionSet.generateSet(m_matchSet, action, m_population);
 
         m_expectsReward = true;
         m_isPrevModeExplore = true;
 
         if (!m_prevActionSet.empty())
         {
-            double p = m_prevReward + m_params.gamma * predictionArray.max();
+            double p = m_prevReward + m_params.gamma * m_predictionArray.max();
             m_prevActionSet.update(p, m_population);
             m_prevActionSet.runGA(m_prevSituation, m_population, m_timeStamp, m_random);
         }
@@ -116,21 +122,21 @@ namespace xcspp::xcs
             // [M]
             //   The match set [M] is formed out of the current [P].
             //   It includes all classifiers that match the current situation.
-            const MatchSet matchSet(m_population, situation, m_timeStamp, &m_params, m_availableActions, m_random);
-            m_isCoveringPerformed = matchSet.isCoveringPerformed();
+            m_matchSet.generateSet(m_population, situation, m_timeStamp, m_random, &m_matchSetCache);
+            m_isCoveringPerformed = m_matchSet.isCoveringPerformed();
 
-            const PredictionArray predictionArray(matchSet, &m_params);
+            m_predictionArray.generate(m_matchSet, m_population);
 
-            const int action = predictionArray.selectAction(0.0, m_random);
+            const int action = m_predictionArray.selectAction(0.0, m_random);
 
-            m_actionSet.generateSet(matchSet, action);
+            m_actionSet.generateSet(m_matchSet, action, m_population);
 
             m_expectsReward = true;
             m_isPrevModeExplore = false;
 
             if (!m_prevActionSet.empty())
             {
-                double p = m_prevReward + m_params.gamma * predictionArray.max();
+                double p = m_prevReward + m_params.gamma * m_predictionArray.max();
                 m_prevActionSet.update(p, m_population);
 
                 // Do not perform GA operations in exploitation
@@ -142,37 +148,24 @@ namespace xcspp::xcs
         }
         else
         {
-            // Create new match set as sandbox
-            MatchSet matchSet(&m_params, m_availableActions);
-            for (const auto & cl : m_population)
-            {
-                if (cl->condition.matches(situation))
-                {
-                    matchSet.insert(cl);
-                }
-            }
+            // Make the match set without covering
+            m_matchSet.generateSetWithoutCovering(m_population, situation, &m_matchSetCache);
 
-            if (!matchSet.empty())
+            if (!m_matchSet.empty())
             {
                 m_isCoveringPerformed = false;
 
-                PredictionArray predictionArray(matchSet, &m_params);
-                const int action = predictionArray.selectAction(0.0, m_random);
-                m_prediction = predictionArray.predictionFor(action);
-                for (const auto & a : m_availableActions)
-                {
-                    m_predictions[a] = predictionArray.predictionFor(a);
-                }
+                m_predictionArray.generate(m_matchSet, m_population);
+                const int action = m_predictionArray.selectAction(0.0, m_random);
+                m_prediction = m_predictionArray.predictionFor(action);
+                m_predictions = m_predictionArray.predictions();
                 return action;
             }
             else
             {
                 m_isCoveringPerformed = true;
                 m_prediction = m_params.initialPrediction;
-                for (const auto & action : m_availableActions)
-                {
-                    m_predictions[action] = m_params.initialPrediction;
-                }
+                m_predictions.assign(m_predictionArray.actionOrdinals().size(), m_params.initialPrediction);
                 return m_random.chooseFrom(m_availableActions);
             }
         }
@@ -185,7 +178,7 @@ namespace xcspp::xcs
 
     double XCS::predictionFor(int action) const
     {
-        return m_predictions.at(action);
+        return m_predictions.at(m_predictionArray.actionOrdinals().ordinalOf(action));
     }
 
     bool XCS::isCoveringPerformed() const
@@ -196,12 +189,12 @@ namespace xcspp::xcs
     std::vector<Classifier> XCS::getMatchingClassifiers(const std::vector<int> & situation) const
     {
         std::vector<Classifier> classifiers;
-        for (const auto & cl : m_population)
+        std::vector<std::size_t> matchedIndices;
+        m_population.match(PackedSituation(situation), matchedIndices);
+        classifiers.reserve(matchedIndices.size());
+        for (const auto & idx : matchedIndices)
         {
-            if (cl->condition.matches(situation))
-            {
-                classifiers.emplace_back(*cl);
-            }
+            classifiers.push_back(m_population[idx].toClassifier());
         }
         return classifiers;
     }
@@ -211,6 +204,11 @@ namespace xcspp::xcs
         return m_population;
     }
 
+    const MatchSetCache & XCS::matchSetCache() const
+    {
+        return m_matchSetCache;
+    }
+
     void XCS::setPopulationClassifiers(const std::vector<Classifier> & classifiers, bool syncTimeStamp)
     {
         m_population.setClassifiers(classifiers);
@@ -273,7 +271,7 @@ namespace xcspp::xcs
         std::uint64_t sum = 0;
         for (const auto & cl : m_population)
         {
-            sum += cl->numerosity;
+            sum += cl.numerosity;
         }
         return sum;
     }
@@ -0,0 +1,63 @@
+#include "xcspp/core/xcsr/classifier_handle_set.hpp"
+#include <algorithm> // std::find, std::find_if, std::remove_if
+
+namespace xcspp::xcsr
+{
+
+    ClassifierHandleSet::ClassifierHandleSet(const XCSRParams *pParams, const std::unordered_set<int> & availableActions)
+        : m_pParams(pParams)
+        , m_availableActions(availableActions)
+    {
+    }
+
+    void ClassifierHandleSet::pushBack(const ClassifierHandle & handle)
+    {
+        if (handle.index >= m_memberTags.size())
+        {
+            m_memberTags.resize(handle.index + 1, 0);
+        }
+        else if (m_memberTags[handle.index] != 0)
+        {
+            // The slot has been reused since the older member was added
+            const auto it = std::find_if(m_set.begin(), m_set.end(), [&handle](const ClassifierHandle & member) {
+                return member.index == handle.index;
+            });
+            m_set.erase(it);
+        }
+        m_memberTags[handle.index] = handle.generation + 1;
+        m_set.push_back(handle);
+    }
+
+    void ClassifierHandleSet::removeStaleHandles(const Population & population)
+    {
+        m_set.erase(
+            std::remove_if(m_set.begin(), m_set.end(), [this, &population](const ClassifierHandle & handle) {
+                if (population.contains(handle))
+                {
+                    return false;
+                }
+                m_memberTags[handle.index] = 0;
+                return true;
+            }),
+            m_set.end());
+    }
+
+    void ClassifierHandleSet::erase(const ClassifierHandle & handle)
+    {
+        if (count(handle) > 0)
+        {
+            m_memberTags[handle.index] = 0;
+            m_set.erase(std::find(m_set.begin(), m_set.end(), handle));
+        }
+    }
+
+    void ClassifierHandleSet::reserve(std::size_t capacity)
+    {
+        m_set.reserve(capacity);
+        if (capacity > m_memberTags.size())
+        {
+            m_memberTags.resize(capacity, 0);
+        }
+    }
+
+}
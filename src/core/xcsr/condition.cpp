@@ -1,11 +1,75 @@
 #include "xcspp/core/xcsr/condition.hpp"
 #include <sstream>
+#include <cstring> // std::memcpy
 
+#include "xcspp/util/hash.hpp"
 #include "xcspp/util/random.hpp"
 
 namespace xcspp::xcsr
 {
 
+    namespace
+    {
+        std::uint64_t ValueBits(double value)
+        {
+            // 0.0 and -0.0 are equal
+            const double normalizedValue = (value == 0.0) ? 0.0 : value;
+            std::uint64_t bits;
+            std::memcpy(&bits, &normalizedValue, sizeof(bits));
+            return bits;
+        }
+
+        template <XCSRRepr Repr>
+        bool Matches(const std::vector<Symbol> & symbols, const std::vector<double> & situation)
+        {
+            for (std::size_t i = 0; i < symbols.size(); ++i)
+            {
+                if (!(GetLowerBound<Repr>(symbols[i]) <= situation[i] && situation[i] < GetUpperBound<Repr>(symbols[i])))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <XCSRRepr Repr>
+        bool IsMoreGeneral(const std::vector<Symbol> & symbols, const Condition & cond)
+        {
+            std::size_t equalCount = 0;
+
+            for (std::size_t i = 0; i < symbols.size(); ++i)
+            {
+                const double otherL = GetLowerBound<Repr>(cond[i]);
+                const double otherU = GetUpperBound<Repr>(cond[i]);
+                const double selfL = GetLowerBound<Repr>(symbols[i]);
+                const double selfU = GetUpperBound<Repr>(symbols[i]);
+
+                if (otherL < selfL || selfU < otherU)
+                {
+                    return false;
+                }
+
+                if (otherL == selfL && selfU == otherU)
+                {
+                    ++equalCount;
+                }
+            }
+
+            return equalCount != symbols.size();
+        }
+
+        template <XCSRRepr Repr>
+        double Generality(const std::vector<Symbol> & symbols)
+        {
+            double sum = 0.0;
+            for (const auto & symbol : symbols)
+            {
+                sum += GetUpperBound<Repr>(symbol) - GetLowerBound<Repr>(symbol);
+            }
+            return sum;
+        }
+    }
+
     Condition::Condition(const std::vector<Symbol> & symbols) : m_symbols(symbols) {}
 
     Condition::Condition(const std::string & symbols)
@@ -50,15 +114,9 @@ namespace xcspp::xcsr
             std::invalid_argument("Condition::matches() could not process the situation with a different length.");
         }
 
-        for (std::size_t i = 0; i < m_symbols.size(); ++i)
-        {
-            if (!m_symbols[i].matches(situation[i], repr))
-            {
-                return false;
-            }
-        }
-
-        return true;
+        return VisitXCSRRepr(repr, [&](auto reprConstant) {
+            return Matches<decltype(reprConstant)::value>(m_symbols, situation);
+        });
     }
 
     bool Condition::isMoreGeneral(const Condition & cond, XCSRRepr repr) const
@@ -68,32 +126,27 @@ namespace xcspp::xcsr
             throw std::invalid_argument("In Condition::isMoreGeneral(), both conditions must have the same length.");
         }
 
-        std::size_t equalCount = 0;
-
-        for (std::size_t i = 0; i < m_symbols.size(); ++i)
-        {
-            const double otherL = GetLowerBound(cond[i], repr);
-            const double otherU = GetUpperBound(cond[i], repr);
-            const double selfL = GetLowerBound(m_symbols[i], repr);
-            const double selfU = GetUpperBound(m_symbols[i], repr);
-
-            if (otherL < selfL || selfU < otherU)
-            {
-                return false;
-            }
+        return VisitXCSRRepr(repr, [&](auto reprConstant) {
+            return IsMoreGeneral<decltype(reprConstant)::value>(m_symbols, cond);
+        });
+    }
 
-            if (otherL == selfL && selfU == otherU)
-            {
-                ++equalCount;
-            }
-        }
+    double Condition::generality(XCSRRepr repr) const
+    {
+        return VisitXCSRRepr(repr, [&](auto reprConstant) {
+            return Generality<decltype(reprConstant)::value>(m_symbols);
+        });
+    }
 
-        if (equalCount == m_symbols.size())
+    std::uint64_t Condition::hash() const
+    {
+        std::uint64_t hash = m_symbols.size();
+        for (const auto & symbol : m_symbols)
         {
-            return false;
+            hash = Hash::Combine(hash, ValueBits(symbol.v1));
+            hash = Hash::Combine(hash, ValueBits(symbol.v2));
         }
-
-        return true;
+        return hash;
     }
 
     std::ostream & operator<< (std::ostream & os, const Condition & obj)
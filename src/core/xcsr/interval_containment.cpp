@@ -0,0 +1,154 @@
+#include "xcspp/core/xcsr/interval_containment.hpp"
+#include <algorithm> // std::min, std::remove_if
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace xcspp::xcsr
+{
+
+    namespace
+    {
+        // Results of CompareChunk()
+        constexpr unsigned int kNotContained = 1; // Some interval does not contain the other
+        constexpr unsigned int kDifferent = 2; // Some interval is not equal to the other
+
+
+        // Compares the bounds of count (<= kContainmentChunkSize) dimensions
+        unsigned int CompareChunk(const double *lower, const double *upper, const double *otherLower, const double *otherUpper, std::size_t count) noexcept
+        {
+#if defined(__AVX512F__)
+            const __mmask8 mask = static_cast<__mmask8>((1u << count) - 1);
+            const __m512d l = _mm512_maskz_loadu_pd(mask, lower);
+            const __m512d u = _mm512_maskz_loadu_pd(mask, upper);
+            const __m512d ol = _mm512_maskz_loadu_pd(mask, otherLower);
+            const __m512d ou = _mm512_maskz_loadu_pd(mask, otherUpper);
+            const __mmask8 notContained = _mm512_mask_cmp_pd_mask(mask, ol, l, _CMP_LT_OQ) | _mm512_mask_cmp_pd_mask(mask, u, ou, _CMP_LT_OQ);
+            const __mmask8 equal = _mm512_mask_cmp_pd_mask(mask, ol, l, _CMP_EQ_OQ) & _mm512_mask_cmp_pd_mask(mask, u, ou, _CMP_EQ_OQ);
+            return (notContained ? kNotContained : 0) | ((equal != mask) ? kDifferent : 0);
+#else
+            unsigned int result = 0;
+            std::size_t i = 0;
+#if defined(__AVX2__)
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m256d l = _mm256_loadu_pd(lower + i);
+                const __m256d u = _mm256_loadu_pd(upper + i);
+                const __m256d ol = _mm256_loadu_pd(otherLower + i);
+                const __m256d ou = _mm256_loadu_pd(otherUpper + i);
+                const int notContained = _mm256_movemask_pd(_mm256_or_pd(_mm256_cmp_pd(ol, l, _CMP_LT_OQ), _mm256_cmp_pd(u, ou, _CMP_LT_OQ)));
+                const int equal = _mm256_movemask_pd(_mm256_and_pd(_mm256_cmp_pd(ol, l, _CMP_EQ_OQ), _mm256_cmp_pd(u, ou, _CMP_EQ_OQ)));
+                result |= (notContained ? kNotContained : 0) | ((equal != 0xF) ? kDifferent : 0);
+            }
+#endif
+            // (Branch-free so that the compiler can vectorize the loop with the baseline instruction set)
+            for (; i < count; ++i)
+            {
+                result |= static_cast<unsigned int>((otherLower[i] < lower[i]) | (upper[i] < otherUpper[i])) * kNotContained;
+                result |= static_cast<unsigned int>(!((otherLower[i] == lower[i]) & (upper[i] == otherUpper[i]))) * kDifferent;
+            }
+            return result;
+#endif
+        }
+    }
+
+    void GetConditionBounds(const Condition & condition, XCSRRepr repr, double *lowerBounds, double *upperBounds)
+    {
+        VisitXCSRRepr(repr, [&](auto reprConstant) {
+            constexpr XCSRRepr kRepr = decltype(reprConstant)::value;
+            for (std::size_t i = 0; i < condition.size(); ++i)
+            {
+                lowerBounds[i] = GetLowerBound<kRepr>(condition[i]);
+                upperBounds[i] = GetUpperBound<kRepr>(condition[i]);
+            }
+        });
+    }
+
+    bool IsMoreGeneral(const double *lowerBounds, const double *upperBounds, const double *otherLowerBounds, const double *otherUpperBounds, std::size_t length) noexcept
+    {
+        unsigned int result = 0;
+        for (std::size_t i = 0; i < length; i += kContainmentChunkSize)
+        {
+            result |= CompareChunk(lowerBounds + i, upperBounds + i, otherLowerBounds + i, otherUpperBounds + i, std::min(kContainmentChunkSize, length - i));
+            if (result & kNotContained)
+            {
+                return false;
+            }
+        }
+        return (result & kDifferent) != 0;
+    }
+
+    template <XCSRRepr Repr>
+    bool IsMoreGeneral(const double *lowerBounds, const double *upperBounds, const Condition & other) noexcept
+    {
+        const std::size_t length = other.size();
+        bool isDifferent = false;
+        std::size_t i = 0;
+#if defined(__AVX2__)
+        // The symbols (v1, v2) are loaded four at a time and separated into the vectors of v1 and v2, so
+        // that the bounds are calculated in the registers
+        static_assert(sizeof(Symbol) == 2 * sizeof(double), "Symbol must consist of v1 and v2.");
+        for (; i + 4 <= length; i += 4)
+        {
+            const double *values = &other[i].v1;
+            const __m256d symbols0 = _mm256_loadu_pd(values);
+            const __m256d symbols1 = _mm256_loadu_pd(values + 4);
+            const __m256d v1 = _mm256_permute4x64_pd(_mm256_unpacklo_pd(symbols0, symbols1), 0xD8);
+            const __m256d v2 = _mm256_permute4x64_pd(_mm256_unpackhi_pd(symbols0, symbols1), 0xD8);
+
+            __m256d ol;
+            __m256d ou;
+            if constexpr (Repr == XCSRRepr::kCSR)
+            {
+                ol = _mm256_sub_pd(v1, v2);
+                ou = _mm256_add_pd(v1, v2);
+            }
+            else if constexpr (Repr == XCSRRepr::kOBR)
+            {
+                ol = v1;
+                ou = v2;
+            }
+            else
+            {
+                // (The same operands as std::min(v1, v2) and std::max(v1, v2), including NaN and signed zeros)
+                ol = _mm256_min_pd(v2, v1);
+                ou = _mm256_max_pd(v2, v1);
+            }
+
+            const __m256d l = _mm256_loadu_pd(lowerBounds + i);
+            const __m256d u = _mm256_loadu_pd(upperBounds + i);
+            if (_mm256_movemask_pd(_mm256_or_pd(_mm256_cmp_pd(ol, l, _CMP_LT_OQ), _mm256_cmp_pd(u, ou, _CMP_LT_OQ))) != 0)
+            {
+                return false;
+            }
+            isDifferent |= (_mm256_movemask_pd(_mm256_and_pd(_mm256_cmp_pd(ol, l, _CMP_EQ_OQ), _mm256_cmp_pd(u, ou, _CMP_EQ_OQ))) != 0xF);
+        }
+#endif
+        for (; i < length; ++i)
+        {
+            const double otherL = GetLowerBound<Repr>(other[i]);
+            const double otherU = GetUpperBound<Repr>(other[i]);
+            if (otherL < lowerBounds[i] || upperBounds[i] < otherU)
+            {
+                return false;
+            }
+            isDifferent |= !(otherL == lowerBounds[i] && upperBounds[i] == otherU);
+        }
+        return isDifferent;
+    }
+
+    template bool IsMoreGeneral<XCSRRepr::kCSR>(const double *lowerBounds, const double *upperBounds, const Condition & other) noexcept;
+    template bool IsMoreGeneral<XCSRRepr::kOBR>(const double *lowerBounds, const double *upperBounds, const Condition & other) noexcept;
+    template bool IsMoreGeneral<XCSRRepr::kUBR>(const double *lowerBounds, const double *upperBounds, const Condition & other) noexcept;
+
+    void KeepMoreGeneralRows(const double *lowerBounds, const double *upperBounds, const double *otherLowerBounds, const double *otherUpperBounds, std::size_t length, std::vector<std::size_t> & rows)
+    {
+        rows.erase(
+            std::remove_if(rows.begin(), rows.end(), [&](std::size_t row) {
+                return !IsMoreGeneral(lowerBounds + row * length, upperBounds + row * length, otherLowerBounds, otherUpperBounds, length);
+            }),
+            rows.end());
+    }
+
+}
@@ -0,0 +1,325 @@
+#include "xcspp/core/xcsr/interval_matcher.hpp"
+#include <algorithm> // std::min
+#include <limits> // std::numeric_limits
+#include <stdexcept>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "xcspp/util/bit.hpp"
+
+namespace xcspp::xcsr
+{
+
+    namespace
+    {
+        constexpr std::size_t kBlockSize = IntervalMatcher::kBlockSize;
+
+        // The number of dimensions tested for all classifiers of a block at once
+        //   Without SIMD, the remaining dimensions are tested for each classifier alone, which stops at its
+        //   first rejecting dimension instead of the last one in the block.
+#if defined(__AVX512F__) || defined(__AVX2__)
+        constexpr std::size_t kBlockDimensions = std::numeric_limits<std::size_t>::max();
+#else
+        constexpr std::size_t kBlockDimensions = 8;
+#endif
+
+        // Returns the lanes of the block whose intervals contain the value (lower <= value < upper)
+        unsigned int MatchLanes(const double *lower, const double *upper, double value)
+        {
+#if defined(__AVX512F__)
+            const __m512d x = _mm512_set1_pd(value);
+            const __mmask8 lowerMask = _mm512_cmp_pd_mask(_mm512_loadu_pd(lower), x, _CMP_LE_OQ);
+            return _mm512_mask_cmp_pd_mask(lowerMask, x, _mm512_loadu_pd(upper), _CMP_LT_OQ);
+#elif defined(__AVX2__)
+            const __m256d x = _mm256_set1_pd(value);
+            const __m256d lanes0 = _mm256_and_pd(
+                _mm256_cmp_pd(_mm256_loadu_pd(lower), x, _CMP_LE_OQ),
+                _mm256_cmp_pd(x, _mm256_loadu_pd(upper), _CMP_LT_OQ));
+            const __m256d lanes1 = _mm256_and_pd(
+                _mm256_cmp_pd(_mm256_loadu_pd(lower + 4), x, _CMP_LE_OQ),
+                _mm256_cmp_pd(x, _mm256_loadu_pd(upper + 4), _CMP_LT_OQ));
+            return static_cast<unsigned int>(_mm256_movemask_pd(lanes0)) | (static_cast<unsigned int>(_mm256_movemask_pd(lanes1)) << 4);
+#else
+            // (Branch-free so that the compiler can vectorize the loop with the baseline instruction set)
+            unsigned int lanes = 0;
+            for (std::size_t lane = 0; lane < kBlockSize; ++lane)
+            {
+                lanes |= static_cast<unsigned int>((lower[lane] <= value) & (value < upper[lane])) << lane;
+            }
+            return lanes;
+#endif
+        }
+
+        // Returns the lanes of the block whose rounded intervals contain the value (lower <= value <= upper)
+        unsigned int MatchLanes(const float *lower, const float *upper, float value)
+        {
+#if defined(__AVX2__)
+            const __m256 x = _mm256_set1_ps(value);
+            const __m256 lanes = _mm256_and_ps(
+                _mm256_cmp_ps(_mm256_loadu_ps(lower), x, _CMP_LE_OQ),
+                _mm256_cmp_ps(x, _mm256_loadu_ps(upper), _CMP_LE_OQ));
+            return static_cast<unsigned int>(_mm256_movemask_ps(lanes));
+#else
+            unsigned int lanes = 0;
+            for (std::size_t lane = 0; lane < kBlockSize; ++lane)
+            {
+                lanes |= static_cast<unsigned int>((lower[lane] <= value) & (value <= upper[lane])) << lane;
+            }
+            return lanes;
+#endif
+        }
+
+        // Returns the lanes of the block whose intervals of levels contain the value (lower <= value <= upper)
+        unsigned int MatchLanes(const std::uint16_t *lower, const std::uint16_t *upper, std::uint16_t value)
+        {
+#if defined(__AVX2__)
+            // (a <= b for unsigned 16-bit integers is max(a, b) == b)
+            const __m128i x = _mm_set1_epi16(static_cast<short>(value));
+            const __m128i lanes = _mm_and_si128(
+                _mm_cmpeq_epi16(_mm_max_epu16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(lower)), x), x),
+                _mm_cmpeq_epi16(_mm_min_epu16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(upper)), x), x));
+            return static_cast<unsigned int>(_mm_movemask_epi8(_mm_packs_epi16(lanes, _mm_setzero_si128())));
+#else
+            unsigned int lanes = 0;
+            for (std::size_t lane = 0; lane < kBlockSize; ++lane)
+            {
+                lanes |= static_cast<unsigned int>((lower[lane] <= value) & (value <= upper[lane])) << lane;
+            }
+            return lanes;
+#endif
+        }
+
+        // The test of MatchLanes() for a single lane
+        bool Contains(double lower, double upper, double value)
+        {
+            return lower <= value && value < upper;
+        }
+
+        template <typename Bound>
+        bool Contains(Bound lower, Bound upper, Bound value)
+        {
+            return lower <= value && value <= upper;
+        }
+    }
+
+    void IntervalMatcher::reset(std::size_t conditionLength)
+    {
+        m_conditionLength = conditionLength;
+        m_lowerBounds.clear();
+        m_upperBounds.clear();
+        m_lowerFloatBounds.clear();
+        m_upperFloatBounds.clear();
+        m_lowerLevels.clear();
+        m_upperLevels.clear();
+        m_liveMasks.clear();
+        m_size = 0;
+    }
+
+    IntervalMatcher::IntervalMatcher(XCSRPrecision precision, double minValue, double maxValue)
+        : m_conditionLength(0)
+        , m_quantizer(precision, minValue, maxValue)
+        , m_size(0)
+    {
+    }
+
+    void IntervalMatcher::insert(std::size_t column, const Condition & condition, XCSRRepr repr)
+    {
+        if (m_size == 0 && condition.size() != m_conditionLength)
+        {
+            reset(condition.size());
+        }
+        else if (condition.size() != m_conditionLength)
+        {
+            throw std::invalid_argument("IntervalMatcher::insert() received a condition with a different length.");
+        }
+
+        // Allocate blocks up to the column
+        if (column >= m_liveMasks.size() * kBlockSize)
+        {
+            const std::size_t blockCount = column / kBlockSize + 1;
+            const std::size_t boundCount = blockCount * m_conditionLength * kBlockSize;
+            switch (m_quantizer.precision())
+            {
+            case XCSRPrecision::kDouble:
+                m_lowerBounds.resize(boundCount, 0.0);
+                m_upperBounds.resize(boundCount, 0.0);
+                break;
+
+            case XCSRPrecision::kFloat:
+                m_lowerFloatBounds.resize(boundCount, 0.0f);
+                m_upperFloatBounds.resize(boundCount, 0.0f);
+                break;
+
+            case XCSRPrecision::kUInt16:
+                m_lowerLevels.resize(boundCount, 0);
+                m_upperLevels.resize(boundCount, 0);
+                break;
+            };
+            m_liveMasks.resize(blockCount, 0);
+        }
+
+        const std::size_t block = column / kBlockSize;
+        const std::size_t lane = column % kBlockSize;
+        if (m_liveMasks[block] & (1u << lane))
+        {
+            throw std::invalid_argument("IntervalMatcher::insert() received a column in use.");
+        }
+        m_liveMasks[block] |= static_cast<std::uint8_t>(1u << lane);
+        ++m_size;
+
+        VisitXCSRRepr(repr, [&](auto reprConstant) {
+            constexpr XCSRRepr kRepr = decltype(reprConstant)::value;
+            for (std::size_t i = 0; i < m_conditionLength; ++i)
+            {
+                const std::size_t offset = (block * m_conditionLength + i) * kBlockSize + lane;
+                const double lowerBound = GetLowerBound<kRepr>(condition[i]);
+                const double upperBound = GetUpperBound<kRepr>(condition[i]);
+                switch (m_quantizer.precision())
+                {
+                case XCSRPrecision::kDouble:
+                    m_lowerBounds[offset] = lowerBound;
+                    m_upperBounds[offset] = upperBound;
+                    break;
+
+                case XCSRPrecision::kFloat:
+                    // (x < upper implies float(x) <= FloatUp(upper) since the conversion of x rounds to the nearest)
+                    m_lowerFloatBounds[offset] = SymbolQuantizer::FloatDown(lowerBound);
+                    m_upperFloatBounds[offset] = SymbolQuantizer::FloatUp(upperBound);
+                    break;
+
+                case XCSRPrecision::kUInt16:
+                    m_lowerLevels[offset] = m_quantizer.levelOf(lowerBound);
+                    m_upperLevels[offset] = m_quantizer.levelOf(upperBound);
+                    break;
+                };
+            }
+        });
+    }
+
+    void IntervalMatcher::erase(std::size_t column)
+    {
+        const std::size_t block = column / kBlockSize;
+        const std::size_t lane = column % kBlockSize;
+        if (block >= m_liveMasks.size() || !(m_liveMasks[block] & (1u << lane)))
+        {
+            throw std::invalid_argument("IntervalMatcher::erase() received a column not in use.");
+        }
+
+        // The bounds are left as they are since the lane is skipped until it is reused
+        m_liveMasks[block] &= static_cast<std::uint8_t>(~(1u << lane));
+        --m_size;
+    }
+
+    void IntervalMatcher::clear()
+    {
+        reset(0);
+    }
+
+    void IntervalMatcher::reserve(std::size_t columnCount, std::size_t conditionLength)
+    {
+        const std::size_t blockCount = (columnCount + kBlockSize - 1) / kBlockSize;
+        const std::size_t boundCount = blockCount * conditionLength * kBlockSize;
+        switch (m_quantizer.precision())
+        {
+        case XCSRPrecision::kDouble:
+            m_lowerBounds.reserve(boundCount);
+            m_upperBounds.reserve(boundCount);
+            break;
+
+        case XCSRPrecision::kFloat:
+            m_lowerFloatBounds.reserve(boundCount);
+            m_upperFloatBounds.reserve(boundCount);
+            break;
+
+        case XCSRPrecision::kUInt16:
+            m_lowerLevels.reserve(boundCount);
+            m_upperLevels.reserve(boundCount);
+            break;
+        };
+        m_liveMasks.reserve(blockCount);
+    }
+
+    template <typename Bound>
+    void IntervalMatcher::matchBounds(const std::vector<Bound> & lowerBounds, const std::vector<Bound> & upperBounds, const Bound *situation, std::vector<std::size_t> & matchedColumns) const
+    {
+        const std::size_t blockCount = m_liveMasks.size();
+        const std::size_t blockStride = m_conditionLength * kBlockSize;
+        for (std::size_t block = 0; block < blockCount; ++block)
+        {
+            unsigned int lanes = m_liveMasks[block];
+            const Bound *lower = lowerBounds.data() + block * blockStride;
+            const Bound *upper = upperBounds.data() + block * blockStride;
+
+            // Stop as soon as all classifiers of the block are rejected
+            const std::size_t blockDimensionCount = std::min(m_conditionLength, kBlockDimensions);
+            for (std::size_t i = 0; i < blockDimensionCount && lanes != 0; ++i)
+            {
+                lanes &= MatchLanes(lower + i * kBlockSize, upper + i * kBlockSize, situation[i]);
+            }
+
+            // Test the remaining dimensions for each classifier
+            for (unsigned int remaining = (blockDimensionCount < m_conditionLength) ? lanes : 0; remaining != 0; remaining &= remaining - 1)
+            {
+                const std::size_t lane = Bit::CountTrailingZeros(remaining);
+                for (std::size_t i = blockDimensionCount; i < m_conditionLength; ++i)
+                {
+                    const std::size_t offset = i * kBlockSize + lane;
+                    if (!Contains(lower[offset], upper[offset], situation[i]))
+                    {
+                        lanes &= ~(1u << lane);
+                        break;
+                    }
+                }
+            }
+
+            while (lanes != 0)
+            {
+                matchedColumns.push_back(block * kBlockSize + Bit::CountTrailingZeros(lanes));
+                lanes &= lanes - 1;
+            }
+        }
+    }
+
+    void IntervalMatcher::match(const std::vector<double> & situation, std::vector<std::size_t> & matchedColumns) const
+    {
+        matchedColumns.clear();
+
+        if (m_size == 0)
+        {
+            return;
+        }
+
+        if (situation.size() != m_conditionLength)
+        {
+            throw std::invalid_argument("IntervalMatcher::match() could not process the situation with a different length.");
+        }
+
+        switch (m_quantizer.precision())
+        {
+        case XCSRPrecision::kDouble:
+            matchBounds(m_lowerBounds, m_upperBounds, situation.data(), matchedColumns);
+            break;
+
+        case XCSRPrecision::kFloat:
+            m_floatSituation.resize(m_conditionLength);
+            for (std::size_t i = 0; i < m_conditionLength; ++i)
+            {
+                m_floatSituation[i] = static_cast<float>(situation[i]);
+            }
+            matchBounds(m_lowerFloatBounds, m_upperFloatBounds, m_floatSituation.data(), matchedColumns);
+            break;
+
+        case XCSRPrecision::kUInt16:
+            m_levelSituation.resize(m_conditionLength);
+            for (std::size_t i = 0; i < m_conditionLength; ++i)
+            {
+                m_levelSituation[i] = m_quantizer.levelOf(situation[i]);
+            }
+            matchBounds(m_lowerLevels, m_upperLevels, m_levelSituation.data(), matchedColumns);
+            break;
+        };
+    }
+
+}
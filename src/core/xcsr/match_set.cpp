@@ -1,6 +1,7 @@
 #include "xcspp/core/xcsr/match_set.hpp"
-#include <memory> // std::make_shared
+#include <algorithm> // std::fill, std::sort
 #include <sstream> // std::ostringstream
+#include <utility> // std::as_const
 
 namespace xcspp::xcsr
 {
@@ -8,58 +9,141 @@ namespace xcspp::xcsr
     namespace
     {
         // GENERATE COVERING CLASSIFIER
-        ClassifierPtr GenerateCoveringClassifier(
+        //   (The classifier is written into cl to reuse the buffer of its condition.)
+        void GenerateCoveringClassifier(
             const std::vector<double> & situation,
-            const std::unordered_set<int> & unselectedActions,
+            const std::vector<int> & unselectedActions,
             std::uint64_t timeStamp,
             const XCSRParams *pParams,
-            Random & random)
+            Random & random,
+            Classifier & cl)
         {
-            std::vector<Symbol> symbols;
-            for (const auto & s : situation)
-            {
-                symbols.push_back(MakeCoveringSymbol(s, pParams, random));
-            }
+            cl.condition.resize(situation.size());
+            VisitXCSRRepr(pParams->repr, [&](auto reprConstant) {
+                for (std::size_t i = 0; i < situation.size(); ++i)
+                {
+                    cl.condition[i] = MakeCoveringSymbol<decltype(reprConstant)::value>(situation[i], pParams, random);
+                }
+            });
 
-            return std::make_shared<StoredClassifier>(symbols, random.chooseFrom(unselectedActions), timeStamp, pParams);
+            cl.action = random.chooseFrom(unselectedActions);
+            cl.prediction = pParams->initialPrediction;
+            cl.epsilon = pParams->initialEpsilon;
+            cl.fitness = pParams->initialFitness;
+            cl.experience = 0;
+            cl.timeStamp = timeStamp;
+            cl.actionSetSize = 1;
+            cl.numerosity = 1;
         }
     }
 
-    MatchSet::MatchSet(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, const XCSRParams *pParams, const std::unordered_set<int> & availableActions, Random & random)
-        : ClassifierPtrSet(pParams, availableActions)
+    MatchSet::MatchSet(const XCSRParams *pParams, const std::unordered_set<int> & availableActions)
+        : ClassifierHandleSet(pParams, availableActions)
         , m_isCoveringPerformed(false)
+        , m_actionOrdinals(availableActions)
+        , m_isActionInSet(m_actionOrdinals.size(), 0)
+        , m_coveringClassifier(Condition(), 0, 0.0, 0.0, 0.0, 0)
+        , m_isPartitioned(false)
+    {
+        m_unselectedActions.reserve(availableActions.size());
+    }
+
+    MatchSet::MatchSet(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, const XCSRParams *pParams, const std::unordered_set<int> & availableActions, Random & random, MatchSetCache *pCache)
+        : MatchSet(pParams, availableActions)
     {
-        generateSet(population, situation, timeStamp, random);
+        generateSet(population, situation, timeStamp, random, pCache);
+    }
+
+    void MatchSet::collectMatchingClassifiers(const Population & population, const std::vector<double> & situation, MatchSetCache *pCache)
+    {
+        if (pCache != nullptr)
+        {
+            pCache->match(population, situation, m_matchedIndices);
+        }
+        else
+        {
+            population.match(situation, m_matchedIndices);
+        }
+        if (m_isPartitioned)
+        {
+            // Group [M] by action so that [A] and PA are taken from each partition
+            population.partitionByAction(m_matchedIndices, m_partitionBegins, m_partitionBuffer);
+        }
+
+        clear();
+        for (const auto & idx : m_matchedIndices)
+        {
+            pushBack(population.handle(idx));
+        }
     }
 
     // GENERATE MATCH SET
-    void MatchSet::generateSet(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random)
+    void MatchSet::generateSet(Population & population, const std::vector<double> & situation, std::uint64_t timeStamp, Random & random, MatchSetCache *pCache)
     {
         // Set theta_mna (the minimal number of actions) to the number of action choices if theta_mna is 0
         auto thetaMna = (m_pParams->thetaMna == 0) ? m_availableActions.size() : m_pParams->thetaMna;
 
-        auto unselectedActions = m_availableActions;
+        // The partitions of [P] are used only if they are made with the same actions
+        m_isPartitioned = m_pParams->partitionByAction && population.actionOrdinals().actions() == m_actionOrdinals.actions();
 
-        m_set.clear();
+        clear();
+        m_isCoveringPerformed = false;
 
+        // [M] is generated again only if the deletion after covering has removed all its members
         while (m_set.empty())
         {
-            for (const auto & cl : population)
+            collectMatchingClassifiers(population, situation, pCache);
+
+            // Count the actions in [M]
+            std::fill(m_isActionInSet.begin(), m_isActionInSet.end(), std::uint8_t{ 0 });
+            std::size_t actionCount = 0;
+            if (m_isPartitioned)
+            {
+                for (std::size_t i = 0; i < m_isActionInSet.size(); ++i)
+                {
+                    if (m_partitionBegins[i] < m_partitionBegins[i + 1])
+                    {
+                        m_isActionInSet[i] = 1;
+                        ++actionCount;
+                    }
+                }
+            }
+            else
             {
-                if (cl->condition.matches(situation, m_pParams->repr))
+                for (const auto & idx : m_matchedIndices)
                 {
-                    m_set.insert(cl);
-                    unselectedActions.erase(cl->action);
+                    const std::size_t ordinal = m_actionOrdinals.ordinalOf(std::as_const(population)[idx].action);
+                    if (ordinal < m_isActionInSet.size() && !m_isActionInSet[ordinal])
+                    {
+                        m_isActionInSet[ordinal] = 1;
+                        ++actionCount;
+                    }
                 }
             }
 
-            // Generate classifiers covering the unselected actions
-            if (m_availableActions.size() - unselectedActions.size() < thetaMna)
+            if (actionCount >= thetaMna)
             {
-                const auto coveringClassifier = GenerateCoveringClassifier(situation, unselectedActions, timeStamp, m_pParams, random);
+                break;
+            }
+
+            // Generate classifiers covering the unselected actions until theta_mna actions are in [M]
+            //   They are added to [M] directly instead of scanning [P] again for each of them.
+            std::size_t coveringCount = 0;
+            while (actionCount < thetaMna)
+            {
+                m_unselectedActions.clear();
+                for (std::size_t i = 0; i < m_isActionInSet.size(); ++i)
+                {
+                    if (!m_isActionInSet[i])
+                    {
+                        m_unselectedActions.push_back(m_actionOrdinals.action(i));
+                    }
+                }
+
+                GenerateCoveringClassifier(situation, m_unselectedActions, timeStamp, m_pParams, random, m_coveringClassifier);
 
                 // Make sure the generated covering classifier covers the given input
-                if (!coveringClassifier->condition.matches(situation, m_pParams->repr))
+                if (!m_coveringClassifier.condition.matches(situation, m_pParams->repr))
                 {
                     std::ostringstream oss;
                     oss <<
@@ -69,22 +153,63 @@ namespace xcspp::xcsr
                     {
                         oss << s << ' ';
                     }
-                    oss << "\n  - Covering classifier: " << *coveringClassifier << '\n' << std::endl;
+                    oss << "\n  - Covering classifier: " << m_coveringClassifier << '\n' << std::endl;
                     throw std::runtime_error(oss.str());
                 }
 
-                population.insert(coveringClassifier);
+                const std::size_t idx = population.insert(m_coveringClassifier);
+                pushBack(population.handle(idx));
+                m_isActionInSet[m_actionOrdinals.ordinalOf(m_coveringClassifier.action)] = 1;
+                ++actionCount;
+                ++coveringCount;
+            }
+            m_isCoveringPerformed = true;
+
+            // Delete the extra classifiers once all covering classifiers are in [P] (one deletion for each
+            // covering classifier as before)
+            //   A deleted member of [M] is dropped from [M]. This may be a covering classifier of this step,
+            //   whose action is then not covered again in this step.
+            for (std::size_t i = 0; i < coveringCount; ++i)
+            {
                 population.deleteExtraClassifiers(random);
-                m_set.clear();
-                m_isCoveringPerformed = true;
             }
-            else
+            removeStaleHandles(population);
+
+            // Put [M] in the order of the slot indices (and group it by action) as if [P] was scanned again
+            m_matchedIndices.clear();
+            for (const auto & handle : m_set)
+            {
+                m_matchedIndices.push_back(handle.index);
+            }
+            std::sort(m_matchedIndices.begin(), m_matchedIndices.end());
+            if (m_isPartitioned)
+            {
+                population.partitionByAction(m_matchedIndices, m_partitionBegins, m_partitionBuffer);
+            }
+            clear();
+            for (const auto & idx : m_matchedIndices)
             {
-                m_isCoveringPerformed = false;
+                pushBack(population.handle(idx));
             }
         }
     }
 
+    // GENERATE MATCH SET without covering
+    void MatchSet::generateSetWithoutCovering(const Population & population, const std::vector<double> & situation, MatchSetCache *pCache)
+    {
+        m_isPartitioned = m_pParams->partitionByAction && population.actionOrdinals().actions() == m_actionOrdinals.actions();
+        collectMatchingClassifiers(population, situation, pCache);
+        m_isCoveringPerformed = false;
+    }
+
+    void MatchSet::reserve(std::size_t capacity)
+    {
+        ClassifierHandleSet::reserve(capacity);
+        m_matchedIndices.reserve(capacity);
+        m_partitionBegins.reserve(m_actionOrdinals.size() + 2);
+        m_partitionBuffer.reserve(capacity);
+    }
+
     bool MatchSet::isCoveringPerformed() const
     {
         return m_isCoveringPerformed;
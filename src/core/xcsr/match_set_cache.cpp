@@ -0,0 +1,125 @@
+#include "xcspp/core/xcsr/match_set_cache.hpp"
+#include <algorithm> // std::lower_bound
+#include <cstring> // std::memcpy
+
+namespace xcspp::xcsr
+{
+
+    std::size_t MatchSetCache::SituationHash::operator() (const std::vector<double> & situation) const noexcept
+    {
+        // FNV-1a
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (const auto & value : situation)
+        {
+            // (0.0 and -0.0 are equal as keys)
+            const double normalizedValue = (value == 0.0) ? 0.0 : value;
+            std::uint64_t bits;
+            std::memcpy(&bits, &normalizedValue, sizeof(bits));
+            for (int i = 0; i < 8; ++i)
+            {
+                hash ^= (bits >> (i * 8)) & 0xFF;
+                hash *= 1099511628211ULL;
+            }
+        }
+        return static_cast<std::size_t>(hash);
+    }
+
+    std::size_t MatchSetCache::EstimateMemoryUsage(const std::vector<double> & situation, const Entry & entry)
+    {
+        // The key and the entry with rough estimates of the nodes of the hash map and the list
+        constexpr std::size_t kNodeOverhead = sizeof(std::vector<double>) + sizeof(Entry) + 6 * sizeof(void *);
+        return kNodeOverhead + situation.capacity() * sizeof(double) + entry.matchedIndices.capacity() * sizeof(std::uint32_t);
+    }
+
+    void MatchSetCache::evictLeastRecentlyUsed()
+    {
+        const auto it = m_entries.find(*m_recentlyUsedSituations.back());
+        m_memoryUsage -= it->second.memoryUsage;
+        m_recentlyUsedSituations.pop_back();
+        m_entries.erase(it);
+    }
+
+    MatchSetCache::MatchSetCache(const XCSRParams *pParams)
+        : m_pParams(pParams)
+        , m_memoryUsage(0)
+        , m_hitCount(0)
+        , m_missCount(0)
+    {
+    }
+
+    void MatchSetCache::match(const Population & population, const std::vector<double> & situation, std::vector<std::size_t> & matchedIndices)
+    {
+        if (!isEnabled())
+        {
+            population.match(situation, matchedIndices);
+            return;
+        }
+
+        auto it = m_entries.find(situation);
+        if (it == m_entries.end())
+        {
+            ++m_missCount;
+            population.match(situation, matchedIndices);
+
+            it = m_entries.emplace(situation, Entry()).first;
+            auto & entry = it->second;
+            entry.matchedIndices.assign(matchedIndices.begin(), matchedIndices.end());
+            entry.epoch = population.epoch();
+            m_recentlyUsedSituations.push_front(&it->first);
+            entry.recentlyUsedIterator = m_recentlyUsedSituations.begin();
+            entry.memoryUsage = EstimateMemoryUsage(it->first, entry);
+            m_memoryUsage += entry.memoryUsage;
+        }
+        else
+        {
+            ++m_hitCount;
+            auto & entry = it->second;
+            m_recentlyUsedSituations.splice(m_recentlyUsedSituations.begin(), m_recentlyUsedSituations, entry.recentlyUsedIterator);
+
+            if (entry.epoch != population.epoch())
+            {
+                // Test again only the slots modified since the entry was updated
+                auto & indices = entry.matchedIndices;
+                const bool isRepaired = population.forEachChangedSlotSince(entry.epoch, [&](std::size_t idx) {
+                    const bool isMatched = population.isOccupied(idx) && population[idx].condition.matches(situation, m_pParams->repr);
+                    const auto pos = std::lower_bound(indices.begin(), indices.end(), static_cast<std::uint32_t>(idx));
+                    const bool isCached = (pos != indices.end() && *pos == idx);
+                    if (isMatched && !isCached)
+                    {
+                        indices.insert(pos, static_cast<std::uint32_t>(idx));
+                    }
+                    else if (!isMatched && isCached)
+                    {
+                        indices.erase(pos);
+                    }
+                });
+
+                if (!isRepaired)
+                {
+                    population.match(situation, matchedIndices);
+                    indices.assign(matchedIndices.begin(), matchedIndices.end());
+                }
+                entry.epoch = population.epoch();
+
+                m_memoryUsage -= entry.memoryUsage;
+                entry.memoryUsage = EstimateMemoryUsage(it->first, entry);
+                m_memoryUsage += entry.memoryUsage;
+            }
+
+            matchedIndices.assign(entry.matchedIndices.begin(), entry.matchedIndices.end());
+        }
+
+        while (m_memoryUsage > m_pParams->matchSetCacheSize && !m_recentlyUsedSituations.empty())
+        {
+            evictLeastRecentlyUsed();
+        }
+    }
+
+    void MatchSetCache::clear()
+    {
+        m_entries.clear();
+        m_recentlyUsedSituations.clear();
+        m_memoryUsage = 0;
+    }
+
+}
@@ -0,0 +1,477 @@
+#include "xcspp/core/xcsr/spatial_match_index.hpp"
+#include <algorithm> // std::min, std::max, std::find, std::sort
+#include <limits> // std::numeric_limits
+#include <stdexcept>
+
+namespace xcspp::xcsr
+{
+
+    namespace
+    {
+        constexpr std::uint32_t kNoNode = std::numeric_limits<std::uint32_t>::max();
+
+        constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+        // The crossover with the scan of IntervalMatcher, which is several times faster with SIMD
+#if defined(__AVX512F__) || defined(__AVX2__)
+        constexpr std::size_t kMinPreferredColumnCount = 4000;
+        constexpr std::size_t kMaxPreferredConditionLength = 2;
+#else
+        constexpr std::size_t kMinPreferredColumnCount = 1000;
+        constexpr std::size_t kMaxPreferredConditionLength = 8;
+#endif
+
+        bool Contains(const double *lowerBounds, const double *upperBounds, const std::vector<double> & point)
+        {
+            for (std::size_t i = 0; i < point.size(); ++i)
+            {
+                if (!(lowerBounds[i] <= point[i] && point[i] < upperBounds[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    bool SpatialMatchIndex::IsPreferredOverScan(std::size_t columnCount, std::size_t conditionLength) noexcept
+    {
+        return columnCount >= kMinPreferredColumnCount && conditionLength <= kMaxPreferredConditionLength;
+    }
+
+    void SpatialMatchIndex::reset(std::size_t conditionLength)
+    {
+        m_conditionLength = conditionLength;
+        m_columnLowerBounds.clear();
+        m_columnUpperBounds.clear();
+        m_columnLeaves.clear();
+        m_nodeLowerBounds.clear();
+        m_nodeUpperBounds.clear();
+        m_nodeEntries.clear();
+        m_nodeEntryCounts.clear();
+        m_nodeParents.clear();
+        m_nodeIsLeaf.clear();
+        m_freeNodes.clear();
+        m_root = kNoNode;
+        m_size = 0;
+    }
+
+    std::uint32_t SpatialMatchIndex::allocateNode(bool isLeaf)
+    {
+        std::uint32_t node;
+        if (!m_freeNodes.empty())
+        {
+            node = m_freeNodes.back();
+            m_freeNodes.pop_back();
+            std::fill_n(m_nodeLowerBounds.begin() + node * m_conditionLength, m_conditionLength, kInfinity);
+            std::fill_n(m_nodeUpperBounds.begin() + node * m_conditionLength, m_conditionLength, -kInfinity);
+            m_nodeEntryCounts[node] = 0;
+            m_nodeParents[node] = kNoNode;
+            m_nodeIsLeaf[node] = isLeaf;
+        }
+        else
+        {
+            node = static_cast<std::uint32_t>(m_nodeEntryCounts.size());
+            m_nodeLowerBounds.resize(m_nodeLowerBounds.size() + m_conditionLength, kInfinity);
+            m_nodeUpperBounds.resize(m_nodeUpperBounds.size() + m_conditionLength, -kInfinity);
+            m_nodeEntries.resize(m_nodeEntries.size() + kNodeCapacity, 0);
+            m_nodeEntryCounts.push_back(0);
+            m_nodeParents.push_back(kNoNode);
+            m_nodeIsLeaf.push_back(isLeaf);
+        }
+        return node;
+    }
+
+    const double *SpatialMatchIndex::entryLowerBounds(std::uint32_t node, std::uint32_t entry) const
+    {
+        return (m_nodeIsLeaf[node] ? m_columnLowerBounds.data() : m_nodeLowerBounds.data()) + entry * m_conditionLength;
+    }
+
+    const double *SpatialMatchIndex::entryUpperBounds(std::uint32_t node, std::uint32_t entry) const
+    {
+        return (m_nodeIsLeaf[node] ? m_columnUpperBounds.data() : m_nodeUpperBounds.data()) + entry * m_conditionLength;
+    }
+
+    void SpatialMatchIndex::recalculateBounds(std::uint32_t node)
+    {
+        double *lowerBounds = m_nodeLowerBounds.data() + node * m_conditionLength;
+        double *upperBounds = m_nodeUpperBounds.data() + node * m_conditionLength;
+        std::fill_n(lowerBounds, m_conditionLength, kInfinity);
+        std::fill_n(upperBounds, m_conditionLength, -kInfinity);
+        for (std::size_t i = 0; i < m_nodeEntryCounts[node]; ++i)
+        {
+            const std::uint32_t entry = m_nodeEntries[node * kNodeCapacity + i];
+            const double *entryLower = entryLowerBounds(node, entry);
+            const double *entryUpper = entryUpperBounds(node, entry);
+            for (std::size_t d = 0; d < m_conditionLength; ++d)
+            {
+                lowerBounds[d] = std::min(lowerBounds[d], entryLower[d]);
+                upperBounds[d] = std::max(upperBounds[d], entryUpper[d]);
+            }
+        }
+    }
+
+    std::uint32_t SpatialMatchIndex::chooseLeaf(std::uint32_t column) const
+    {
+        const double *columnLower = m_columnLowerBounds.data() + column * m_conditionLength;
+        const double *columnUpper = m_columnUpperBounds.data() + column * m_conditionLength;
+
+        std::uint32_t node = m_root;
+        while (!m_nodeIsLeaf[node])
+        {
+            std::uint32_t bestChild = kNoNode;
+            double bestEnlargement = kInfinity;
+            double bestMargin = kInfinity;
+            for (std::size_t i = 0; i < m_nodeEntryCounts[node]; ++i)
+            {
+                const std::uint32_t child = m_nodeEntries[node * kNodeCapacity + i];
+                const double *childLower = m_nodeLowerBounds.data() + child * m_conditionLength;
+                const double *childUpper = m_nodeUpperBounds.data() + child * m_conditionLength;
+                double margin = 0.0;
+                double enlargedMargin = 0.0;
+                for (std::size_t d = 0; d < m_conditionLength; ++d)
+                {
+                    margin += childUpper[d] - childLower[d];
+                    enlargedMargin += std::max(childUpper[d], columnUpper[d]) - std::min(childLower[d], columnLower[d]);
+                }
+                const double enlargement = enlargedMargin - margin;
+                if (bestChild == kNoNode || enlargement < bestEnlargement || (enlargement == bestEnlargement && margin < bestMargin))
+                {
+                    bestChild = child;
+                    bestEnlargement = enlargement;
+                    bestMargin = margin;
+                }
+            }
+            node = bestChild;
+        }
+        return node;
+    }
+
+    void SpatialMatchIndex::addEntry(std::uint32_t node, std::uint32_t entry)
+    {
+        m_nodeEntries[node * kNodeCapacity + m_nodeEntryCounts[node]] = entry;
+        ++m_nodeEntryCounts[node];
+        if (m_nodeIsLeaf[node])
+        {
+            m_columnLeaves[entry] = node;
+        }
+        else
+        {
+            m_nodeParents[entry] = node;
+        }
+
+        if (m_nodeEntryCounts[node] > kMaxEntries)
+        {
+            split(node);
+        }
+    }
+
+    void SpatialMatchIndex::split(std::uint32_t node)
+    {
+        const std::size_t entryCount = m_nodeEntryCounts[node];
+        m_splitEntries.assign(m_nodeEntries.begin() + node * kNodeCapacity, m_nodeEntries.begin() + node * kNodeCapacity + entryCount);
+
+        // Choose the dimension where the centers of the entries spread most
+        std::size_t splitDimension = 0;
+        double maxSpread = -kInfinity;
+        for (std::size_t d = 0; d < m_conditionLength; ++d)
+        {
+            double minCenter = kInfinity;
+            double maxCenter = -kInfinity;
+            for (const auto & entry : m_splitEntries)
+            {
+                const double center = (entryLowerBounds(node, entry)[d] + entryUpperBounds(node, entry)[d]) / 2;
+                minCenter = std::min(minCenter, center);
+                maxCenter = std::max(maxCenter, center);
+            }
+            if (maxCenter - minCenter > maxSpread)
+            {
+                maxSpread = maxCenter - minCenter;
+                splitDimension = d;
+            }
+        }
+
+        // Sort the entries by the center and move the upper half to a new sibling
+        std::sort(m_splitEntries.begin(), m_splitEntries.end(), [this, node, splitDimension](std::uint32_t lhs, std::uint32_t rhs) {
+            const double lhsCenter = entryLowerBounds(node, lhs)[splitDimension] + entryUpperBounds(node, lhs)[splitDimension];
+            const double rhsCenter = entryLowerBounds(node, rhs)[splitDimension] + entryUpperBounds(node, rhs)[splitDimension];
+            return lhsCenter < rhsCenter || (lhsCenter == rhsCenter && lhs < rhs);
+        });
+
+        const std::uint32_t sibling = allocateNode(m_nodeIsLeaf[node]);
+        const std::size_t keptCount = entryCount / 2;
+        m_nodeEntryCounts[node] = 0;
+        for (std::size_t i = 0; i < entryCount; ++i)
+        {
+            const std::uint32_t target = (i < keptCount) ? node : sibling;
+            m_nodeEntries[target * kNodeCapacity + m_nodeEntryCounts[target]] = m_splitEntries[i];
+            ++m_nodeEntryCounts[target];
+            if (m_nodeIsLeaf[target])
+            {
+                m_columnLeaves[m_splitEntries[i]] = target;
+            }
+            else
+            {
+                m_nodeParents[m_splitEntries[i]] = target;
+            }
+        }
+        recalculateBounds(node);
+        recalculateBounds(sibling);
+
+        if (node == m_root)
+        {
+            const std::uint32_t newRoot = allocateNode(false);
+            m_root = newRoot;
+            addEntry(newRoot, node);
+            addEntry(newRoot, sibling);
+            recalculateBounds(newRoot);
+        }
+        else
+        {
+            // The box of the parent already contains both halves
+            addEntry(m_nodeParents[node], sibling);
+        }
+    }
+
+    void SpatialMatchIndex::insertColumn(std::uint32_t column)
+    {
+        if (m_root == kNoNode)
+        {
+            m_root = allocateNode(true);
+        }
+
+        const std::uint32_t leaf = chooseLeaf(column);
+
+        // Enlarge the boxes on the path to the leaf
+        const double *columnLower = m_columnLowerBounds.data() + column * m_conditionLength;
+        const double *columnUpper = m_columnUpperBounds.data() + column * m_conditionLength;
+        for (std::uint32_t node = leaf; node != kNoNode; node = m_nodeParents[node])
+        {
+            double *lowerBounds = m_nodeLowerBounds.data() + node * m_conditionLength;
+            double *upperBounds = m_nodeUpperBounds.data() + node * m_conditionLength;
+            for (std::size_t d = 0; d < m_conditionLength; ++d)
+            {
+                lowerBounds[d] = std::min(lowerBounds[d], columnLower[d]);
+                upperBounds[d] = std::max(upperBounds[d], columnUpper[d]);
+            }
+        }
+
+        addEntry(leaf, column);
+    }
+
+    void SpatialMatchIndex::dissolve(std::uint32_t node)
+    {
+        // Detach the node from its parent
+        const std::uint32_t parent = m_nodeParents[node];
+        auto parentEntries = m_nodeEntries.begin() + parent * kNodeCapacity;
+        const auto it = std::find(parentEntries, parentEntries + m_nodeEntryCounts[parent], node);
+        *it = *(parentEntries + (m_nodeEntryCounts[parent] - 1));
+        --m_nodeEntryCounts[parent];
+
+        // Release the nodes under it
+        m_nodeStack.clear();
+        m_nodeStack.push_back(node);
+        while (!m_nodeStack.empty())
+        {
+            const std::uint32_t current = m_nodeStack.back();
+            m_nodeStack.pop_back();
+            for (std::size_t i = 0; i < m_nodeEntryCounts[current]; ++i)
+            {
+                const std::uint32_t entry = m_nodeEntries[current * kNodeCapacity + i];
+                if (m_nodeIsLeaf[current])
+                {
+                    m_orphanColumns.push_back(entry);
+                    m_columnLeaves[entry] = kNoNode;
+                }
+                else
+                {
+                    m_nodeStack.push_back(entry);
+                }
+            }
+            m_nodeEntryCounts[current] = 0;
+            m_freeNodes.push_back(current);
+        }
+    }
+
+    SpatialMatchIndex::SpatialMatchIndex()
+        : m_conditionLength(0)
+        , m_root(kNoNode)
+        , m_size(0)
+    {
+    }
+
+    void SpatialMatchIndex::insert(std::size_t column, const Condition & condition, XCSRRepr repr)
+    {
+        if (m_size == 0 && condition.size() != m_conditionLength)
+        {
+            reset(condition.size());
+        }
+        else if (condition.size() != m_conditionLength)
+        {
+            throw std::invalid_argument("SpatialMatchIndex::insert() received a condition with a different length.");
+        }
+
+        if (column >= m_columnLeaves.size())
+        {
+            m_columnLowerBounds.resize((column + 1) * m_conditionLength, 0.0);
+            m_columnUpperBounds.resize((column + 1) * m_conditionLength, 0.0);
+            m_columnLeaves.resize(column + 1, kNoNode);
+        }
+        else if (m_columnLeaves[column] != kNoNode)
+        {
+            throw std::invalid_argument("SpatialMatchIndex::insert() received a column in use.");
+        }
+
+        VisitXCSRRepr(repr, [&](auto reprConstant) {
+            constexpr XCSRRepr kRepr = decltype(reprConstant)::value;
+            for (std::size_t i = 0; i < m_conditionLength; ++i)
+            {
+                m_columnLowerBounds[column * m_conditionLength + i] = GetLowerBound<kRepr>(condition[i]);
+                m_columnUpperBounds[column * m_conditionLength + i] = GetUpperBound<kRepr>(condition[i]);
+            }
+        });
+
+        insertColumn(static_cast<std::uint32_t>(column));
+        ++m_size;
+    }
+
+    void SpatialMatchIndex::erase(std::size_t column)
+    {
+        if (column >= m_columnLeaves.size() || m_columnLeaves[column] == kNoNode)
+        {
+            throw std::invalid_argument("SpatialMatchIndex::erase() received a column not in use.");
+        }
+
+        // Remove the column from its leaf
+        const std::uint32_t leaf = m_columnLeaves[column];
+        auto leafEntries = m_nodeEntries.begin() + leaf * kNodeCapacity;
+        const auto it = std::find(leafEntries, leafEntries + m_nodeEntryCounts[leaf], static_cast<std::uint32_t>(column));
+        *it = *(leafEntries + (m_nodeEntryCounts[leaf] - 1));
+        --m_nodeEntryCounts[leaf];
+        m_columnLeaves[column] = kNoNode;
+        --m_size;
+
+        // Dissolve the underfull nodes and shrink the boxes on the path to the root
+        m_orphanColumns.clear();
+        for (std::uint32_t node = leaf; node != m_root; )
+        {
+            const std::uint32_t parent = m_nodeParents[node];
+            if (m_nodeEntryCounts[node] < kMinEntries)
+            {
+                dissolve(node);
+            }
+            else
+            {
+                recalculateBounds(node);
+            }
+            node = parent;
+        }
+        recalculateBounds(m_root);
+
+        // Remove the root with a single child
+        while (!m_nodeIsLeaf[m_root] && m_nodeEntryCounts[m_root] == 1)
+        {
+            const std::uint32_t child = m_nodeEntries[m_root * kNodeCapacity];
+            m_nodeEntryCounts[m_root] = 0;
+            m_freeNodes.push_back(m_root);
+            m_root = child;
+            m_nodeParents[child] = kNoNode;
+        }
+        if (m_nodeEntryCounts[m_root] == 0)
+        {
+            m_nodeIsLeaf[m_root] = 1;
+        }
+
+        for (const auto & orphanColumn : m_orphanColumns)
+        {
+            insertColumn(orphanColumn);
+        }
+    }
+
+    void SpatialMatchIndex::clear()
+    {
+        reset(0);
+    }
+
+    void SpatialMatchIndex::reserve(std::size_t columnCount, std::size_t conditionLength)
+    {
+        // Nodes are at least a half full on average after splits, and the internal nodes are fewer than the leaves
+        const std::size_t nodeCount = columnCount / (kMaxEntries / 2) * 2 + 1;
+        m_columnLowerBounds.reserve(columnCount * conditionLength);
+        m_columnUpperBounds.reserve(columnCount * conditionLength);
+        m_columnLeaves.reserve(columnCount);
+        m_nodeLowerBounds.reserve(nodeCount * conditionLength);
+        m_nodeUpperBounds.reserve(nodeCount * conditionLength);
+        m_nodeEntries.reserve(nodeCount * kNodeCapacity);
+        m_nodeEntryCounts.reserve(nodeCount);
+        m_nodeParents.reserve(nodeCount);
+        m_nodeIsLeaf.reserve(nodeCount);
+        m_freeNodes.reserve(nodeCount);
+        m_nodeStack.reserve(nodeCount);
+        m_orphanColumns.reserve(columnCount);
+        m_splitEntries.reserve(kNodeCapacity);
+    }
+
+    void SpatialMatchIndex::match(const std::vector<double> & situation, std::vector<std::size_t> & matchedColumns) const
+    {
+        matchedColumns.clear();
+
+        if (m_size == 0)
+        {
+            return;
+        }
+
+        if (situation.size() != m_conditionLength)
+        {
+            throw std::invalid_argument("SpatialMatchIndex::match() could not process the situation with a different length.");
+        }
+
+        m_nodeStack.clear();
+        m_nodeStack.push_back(m_root);
+        while (!m_nodeStack.empty())
+        {
+            const std::uint32_t node = m_nodeStack.back();
+            m_nodeStack.pop_back();
+            if (!Contains(m_nodeLowerBounds.data() + node * m_conditionLength, m_nodeUpperBounds.data() + node * m_conditionLength, situation))
+            {
+                continue;
+            }
+
+            const std::uint32_t *entries = m_nodeEntries.data() + node * kNodeCapacity;
+            if (m_nodeIsLeaf[node])
+            {
+                for (std::size_t i = 0; i < m_nodeEntryCounts[node]; ++i)
+                {
+                    if (Contains(m_columnLowerBounds.data() + entries[i] * m_conditionLength, m_columnUpperBounds.data() + entries[i] * m_conditionLength, situation))
+                    {
+                        matchedColumns.push_back(entries[i]);
+                    }
+                }
+            }
+            else
+            {
+                m_nodeStack.insert(m_nodeStack.end(), entries, entries + m_nodeEntryCounts[node]);
+            }
+        }
+
+        std::sort(matchedColumns.begin(), matchedColumns.end());
+    }
+
+    std::size_t SpatialMatchIndex::height() const
+    {
+        std::size_t height = 0;
+        if (m_size > 0)
+        {
+            for (std::uint32_t node = m_root; ; node = m_nodeEntries[node * kNodeCapacity])
+            {
+                ++height;
+                if (m_nodeIsLeaf[node])
+                {
+                    break;
+                }
+            }
+        }
+        return height;
+    }
+
+}
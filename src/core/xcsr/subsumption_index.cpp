@@ -0,0 +1,156 @@
+#include "xcspp/core/xcsr/subsumption_index.hpp"
+#include <stdexcept>
+
+#include "xcspp/core/xcsr/interval_containment.hpp"
+
+namespace xcspp::xcsr
+{
+
+    SubsumptionIndex::SubsumptionIndex(const XCSRParams *pParams)
+        : m_pParams(pParams)
+        , m_thetaSub(pParams->thetaSub)
+        , m_epsilonZero(pParams->epsilonZero)
+        , m_conditionLength(0)
+    {
+    }
+
+    void SubsumptionIndex::update(std::size_t idx, const Condition & condition, int action, std::uint64_t experience, double epsilon)
+    {
+        // COULD SUBSUME
+        const bool isSubsumer = experience > m_thetaSub && epsilon < m_epsilonZero;
+
+        if (isSubsumer && !contains(idx))
+        {
+            if (m_subsumers.empty() && condition.size() != m_conditionLength)
+            {
+                setConditionLength(condition.size());
+            }
+            else if (condition.size() != m_conditionLength)
+            {
+                throw std::invalid_argument("SubsumptionIndex::update() received a condition with a different length.");
+            }
+
+            if (idx >= m_isIndexed.size())
+            {
+                m_isIndexed.resize(idx + 1, 0);
+                m_actions.resize(idx + 1, 0);
+                m_generalities.resize(idx + 1, 0.0);
+            }
+            if (m_isIndexed.size() * m_conditionLength > m_lowerBounds.size())
+            {
+                m_lowerBounds.resize(m_isIndexed.size() * m_conditionLength, 0.0);
+                m_upperBounds.resize(m_isIndexed.size() * m_conditionLength, 0.0);
+            }
+            m_isIndexed[idx] = 1;
+            m_actions[idx] = action;
+            m_generalities[idx] = condition.generality(m_pParams->repr);
+            GetConditionBounds(condition, m_pParams->repr, m_lowerBounds.data() + idx * m_conditionLength, m_upperBounds.data() + idx * m_conditionLength);
+            m_nodePool.insert(m_subsumers, { action, m_generalities[idx], static_cast<std::uint32_t>(idx) });
+        }
+        else if (!isSubsumer)
+        {
+            erase(idx);
+        }
+    }
+
+    void SubsumptionIndex::erase(std::size_t idx)
+    {
+        if (contains(idx))
+        {
+            m_nodePool.erase(m_subsumers, { m_actions[idx], m_generalities[idx], static_cast<std::uint32_t>(idx) });
+            m_isIndexed[idx] = 0;
+        }
+    }
+
+    void SubsumptionIndex::clear()
+    {
+        m_thetaSub = m_pParams->thetaSub;
+        m_epsilonZero = m_pParams->epsilonZero;
+        m_nodePool.clear(m_subsumers);
+        m_isIndexed.clear();
+        m_actions.clear();
+        m_generalities.clear();
+
+        // (The rows of the bounds are kept for the slots indexed again, since they are read only for the
+        //  slots in the index)
+    }
+
+    void SubsumptionIndex::setConditionLength(std::size_t conditionLength)
+    {
+        m_conditionLength = conditionLength;
+        m_lowerBounds.assign(m_isIndexed.size() * conditionLength, 0.0);
+        m_upperBounds.assign(m_isIndexed.size() * conditionLength, 0.0);
+        m_otherLowerBounds.assign(conditionLength, 0.0);
+        m_otherUpperBounds.assign(conditionLength, 0.0);
+    }
+
+    void SubsumptionIndex::reserve(std::size_t slotCount, std::size_t conditionLength)
+    {
+        if (m_subsumers.empty() && conditionLength != m_conditionLength)
+        {
+            setConditionLength(conditionLength);
+        }
+        if (slotCount > m_isIndexed.size())
+        {
+            m_isIndexed.resize(slotCount, 0);
+            m_actions.resize(slotCount, 0);
+            m_generalities.resize(slotCount, 0.0);
+        }
+        if (m_isIndexed.size() * m_conditionLength > m_lowerBounds.size())
+        {
+            m_lowerBounds.resize(m_isIndexed.size() * m_conditionLength, 0.0);
+            m_upperBounds.resize(m_isIndexed.size() * m_conditionLength, 0.0);
+        }
+        if (slotCount > m_subsumers.size() + m_nodePool.size())
+        {
+            m_nodePool.reserve(slotCount - m_subsumers.size());
+        }
+    }
+
+    bool SubsumptionIndex::isOutdated() const noexcept
+    {
+        return m_thetaSub != m_pParams->thetaSub || m_epsilonZero != m_pParams->epsilonZero;
+    }
+
+    void SubsumptionIndex::collectCandidates(const ConditionActionPair & cl, std::vector<std::size_t> & candidateIndices) const
+    {
+        candidateIndices.clear();
+
+        // A more general condition has a generality not less than the other
+        const std::tuple<int, double, std::uint32_t> lowerBound(cl.action, cl.condition.generality(m_pParams->repr), 0);
+        for (auto it = m_subsumers.lower_bound(lowerBound); it != m_subsumers.end() && std::get<0>(*it) == cl.action; ++it)
+        {
+            candidateIndices.push_back(std::get<2>(*it));
+        }
+    }
+
+    void SubsumptionIndex::collectSubsumers(const ConditionActionPair & cl, std::vector<std::size_t> & subsumerIndices) const
+    {
+        collectCandidates(cl, subsumerIndices);
+        if (subsumerIndices.empty())
+        {
+            return;
+        }
+
+        if (cl.condition.size() != m_conditionLength)
+        {
+            throw std::invalid_argument("In SubsumptionIndex::collectSubsumers(), both conditions must have the same length.");
+        }
+
+        // (The buffers of the bounds have been sized to L by setConditionLength())
+        GetConditionBounds(cl.condition, m_pParams->repr, m_otherLowerBounds.data(), m_otherUpperBounds.data());
+        KeepMoreGeneralRows(m_lowerBounds.data(), m_upperBounds.data(), m_otherLowerBounds.data(), m_otherUpperBounds.data(), m_conditionLength, subsumerIndices);
+    }
+
+    bool SubsumptionIndex::mayBeMoreGeneral(std::size_t idx, std::size_t otherIdx) const
+    {
+        return m_generalities[idx] >= m_generalities[otherIdx];
+    }
+
+    bool SubsumptionIndex::isMoreGeneral(std::size_t idx, std::size_t otherIdx) const
+    {
+        return mayBeMoreGeneral(idx, otherIdx) &&
+            IsMoreGeneral(lowerBounds(idx), upperBounds(idx), lowerBounds(otherIdx), upperBounds(otherIdx), m_conditionLength);
+    }
+
+}
@@ -0,0 +1,92 @@
+#include "xcspp/core/xcsr/xcsr_precision.hpp"
+#include <cmath> // std::floor, std::ceil, std::nearbyint, std::nextafter
+#include <limits>
+
+namespace xcspp::xcsr
+{
+
+    SymbolQuantizer::SymbolQuantizer(XCSRPrecision precision, double minValue, double maxValue)
+        : m_precision(precision)
+        , m_minValue(minValue)
+        , m_step((maxValue - minValue) / kMaxLevel)
+    {
+    }
+
+    double SymbolQuantizer::roundOnGrid(double value, double origin, SymbolRounding rounding) const
+    {
+        const double level = (value - origin) / m_step;
+        switch (rounding)
+        {
+        case SymbolRounding::kNearest:
+            return origin + std::nearbyint(level) * m_step;
+
+        case SymbolRounding::kDown:
+            return origin + std::floor(level) * m_step;
+
+        case SymbolRounding::kUp:
+            return origin + std::ceil(level) * m_step;
+        };
+
+        return value;
+    }
+
+    double SymbolQuantizer::roundValue(double value, SymbolRounding rounding) const
+    {
+        switch (m_precision)
+        {
+        case XCSRPrecision::kDouble:
+            return value;
+
+        case XCSRPrecision::kFloat:
+            switch (rounding)
+            {
+            case SymbolRounding::kNearest:
+                return static_cast<float>(value);
+
+            case SymbolRounding::kDown:
+                return FloatDown(value);
+
+            case SymbolRounding::kUp:
+                return FloatUp(value);
+            };
+            return value;
+
+        case XCSRPrecision::kUInt16:
+            return roundOnGrid(value, m_minValue, rounding);
+        };
+
+        return value;
+    }
+
+    double SymbolQuantizer::roundSpread(double spread, SymbolRounding rounding) const
+    {
+        if (m_precision == XCSRPrecision::kUInt16)
+        {
+            return roundOnGrid(spread, 0.0, rounding);
+        }
+        return roundValue(spread, rounding);
+    }
+
+    std::uint16_t SymbolQuantizer::levelOf(double value) const noexcept
+    {
+        const double level = std::floor((value - m_minValue) / m_step);
+        if (!(level > 0.0)) // (including NaN)
+        {
+            return 0;
+        }
+        return (level < kMaxLevel) ? static_cast<std::uint16_t>(level) : static_cast<std::uint16_t>(kMaxLevel);
+    }
+
+    float SymbolQuantizer::FloatDown(double value) noexcept
+    {
+        const float f = static_cast<float>(value);
+        return (static_cast<double>(f) > value) ? std::nextafter(f, -std::numeric_limits<float>::infinity()) : f;
+    }
+
+    float SymbolQuantizer::FloatUp(double value) noexcept
+    {
+        const float f = static_cast<float>(value);
+        return (static_cast<double>(f) < value) ? std::nextafter(f, std::numeric_limits<float>::infinity()) : f;
+    }
+
+}
@@ -1,5 +1,7 @@
 #include "xcspp/core/xcsr/xcsr_repr.hpp"
 #include <algorithm>
+#include <cmath> // std::abs
+#include <utility> // std::swap
 
 #include "xcspp/core/xcsr/symbol.hpp"
 #include "xcspp/core/xcsr/xcsr_params.hpp"
@@ -12,13 +14,13 @@ namespace xcspp::xcsr
         switch (repr)
         {
         case XCSRRepr::kCSR:
-            return s.v1 - s.v2;
+            return GetLowerBound<XCSRRepr::kCSR>(s);
 
         case XCSRRepr::kOBR:
-            return s.v1;
+            return GetLowerBound<XCSRRepr::kOBR>(s);
 
         case XCSRRepr::kUBR:
-            return std::min(s.v1, s.v2);
+            return GetLowerBound<XCSRRepr::kUBR>(s);
         };
 
         return 0.0;
@@ -29,13 +31,13 @@ namespace xcspp::xcsr
         switch (repr)
         {
         case XCSRRepr::kCSR:
-            return s.v1 + s.v2;
+            return GetUpperBound<XCSRRepr::kCSR>(s);
 
         case XCSRRepr::kOBR:
-            return s.v2;
+            return GetUpperBound<XCSRRepr::kOBR>(s);
 
         case XCSRRepr::kUBR:
-            return std::max(s.v1, s.v2);
+            return GetUpperBound<XCSRRepr::kUBR>(s);
         };
 
         return 0.0;
@@ -45,20 +47,12 @@ namespace xcspp::xcsr
     {
         if (repr == XCSRRepr::kCSR)
         {
-            // CSR
-            return std::clamp(v1, minValue, maxValue);
+            return ClampSymbolValue1<XCSRRepr::kCSR>(v1, minValue, maxValue, doRangeRestriction);
         }
         else
         {
             // OBR and UBR
-            if (doRangeRestriction)
-            {
-                return std::clamp(v1, minValue, maxValue);
-            }
-            else
-            {
-                return v1;
-            }
+            return ClampSymbolValue1<XCSRRepr::kOBR>(v1, minValue, maxValue, doRangeRestriction);
         }
     }
 
@@ -66,66 +60,72 @@ namespace xcspp::xcsr
     {
         if (repr == XCSRRepr::kCSR)
         {
-            // CSR
-            return std::max(v2, 0.0);
+            return ClampSymbolValue2<XCSRRepr::kCSR>(v2, minValue, maxValue, doRangeRestriction);
         }
         else
         {
             // OBR and UBR
-            if (doRangeRestriction)
-            {
-                return std::clamp(v2, minValue, maxValue);
-            }
-            else
-            {
-                return v2;
-            }
+            return ClampSymbolValue2<XCSRRepr::kOBR>(v2, minValue, maxValue, doRangeRestriction);
         }
     }
 
+    Symbol MakeCoveringSymbol(double inputValue, const XCSRParams *pParams, Random & random)
+    {
+        return VisitXCSRRepr(pParams->repr, [&](auto reprConstant) {
+            return MakeCoveringSymbol<decltype(reprConstant)::value>(inputValue, pParams, random);
+        });
+    }
+
+    template <XCSRRepr Repr>
     Symbol MakeCoveringSymbol(double inputValue, const XCSRParams *pParams, Random & random)
     {
         double v1;
         double v2;
 
-        switch (pParams->repr)
+        if constexpr (Repr == XCSRRepr::kCSR)
         {
-        case XCSRRepr::kCSR:
             v1 = inputValue; // Center
             v2 = random.nextDouble(0.0, pParams->s0); // Spread
-            break;
 
-        case XCSRRepr::kOBR:
-        case XCSRRepr::kUBR:
+            // Round the center, and widen the spread by the error of the rounding so that the interval still contains the input
+            const SymbolQuantizer quantizer(pParams->precision, pParams->minValue, pParams->maxValue);
+            v1 = quantizer.roundValue(v1, SymbolRounding::kNearest);
+            v2 = quantizer.roundSpread(v2 + std::abs(v1 - inputValue), SymbolRounding::kUp);
+        }
+        else
+        {
+            // OBR and UBR
+            double lowerMin = inputValue - pParams->s0;
+            double upperMax = inputValue + pParams->s0;
+            if (pParams->doCoveringRandomRangeTruncation)
             {
-                double lowerMin = inputValue - pParams->s0;
-                double upperMax = inputValue + pParams->s0;
-                if (pParams->doCoveringRandomRangeTruncation)
-                {
-                    lowerMin = std::max(lowerMin, pParams->minValue);
-                    upperMax = std::min(upperMax, pParams->maxValue);
-                }
-
-                v1 = random.nextDouble(lowerMin, inputValue);
-                v2 = random.nextDouble(inputValue, upperMax);
-
-                if (pParams->repr == XCSRRepr::kUBR && random.nextDouble() < 0.5)
-                {
-                    std::swap(v1, v2);
-                }
-
-                v1 = ClampSymbolValue1(v1, pParams->repr, pParams->minValue, pParams->maxValue, pParams->doRangeRestriction);
-                v2 = ClampSymbolValue2(v2, pParams->repr, pParams->minValue, pParams->maxValue, pParams->doRangeRestriction);
+                lowerMin = std::max(lowerMin, pParams->minValue);
+                upperMax = std::min(upperMax, pParams->maxValue);
             }
-            break;
-        
-        default:
-            // Zero assignment for avoiding maybe-uninitialized warning
-            v1 = 0.0;
-            v2 = 0.0;
-        };
+
+            v1 = random.nextDouble(lowerMin, inputValue);
+            v2 = random.nextDouble(inputValue, upperMax);
+
+            if (Repr == XCSRRepr::kUBR && random.nextDouble() < 0.5)
+            {
+                std::swap(v1, v2);
+            }
+
+            v1 = ClampSymbolValue1<Repr>(v1, pParams->minValue, pParams->maxValue, pParams->doRangeRestriction);
+            v2 = ClampSymbolValue2<Repr>(v2, pParams->minValue, pParams->maxValue, pParams->doRangeRestriction);
+
+            // Round the lower bound down and the upper bound up so that the interval still contains the input
+            const SymbolQuantizer quantizer(pParams->precision, pParams->minValue, pParams->maxValue);
+            const bool isV1Lower = (v1 <= v2);
+            v1 = quantizer.roundValue(v1, isV1Lower ? SymbolRounding::kDown : SymbolRounding::kUp);
+            v2 = quantizer.roundValue(v2, isV1Lower ? SymbolRounding::kUp : SymbolRounding::kDown);
+        }
 
         return Symbol(v1, v2);
     }
 
+    template Symbol MakeCoveringSymbol<XCSRRepr::kCSR>(double inputValue, const XCSRParams *pParams, Random & random);
+    template Symbol MakeCoveringSymbol<XCSRRepr::kOBR>(double inputValue, const XCSRParams *pParams, Random & random);
+    template Symbol MakeCoveringSymbol<XCSRRepr::kUBR>(double inputValue, const XCSRParams *pParams, Random & random);
+
 }
@@ -69,13 +69,14 @@ namespace xcspp
         }
     }
 
-    BlockWorldEnvironment::BlockWorldEnvironment(const std::string & mapFilename, std::size_t maxStep, bool threeBitMode, bool allowsDiagonalAction)
+    BlockWorldEnvironment::BlockWorldEnvironment(const std::string & mapFilename, std::size_t maxStep, bool threeBitMode, bool allowsDiagonalAction, std::optional<std::uint64_t> seed)
         : m_worldWidth(0)
         , m_worldHeight(0)
         , m_maxStep(maxStep)
         , m_lastStep(0)
         , m_currentStep(0)
         , m_isEndOfProblem(false)
+        , m_random(seed)
         , m_allowsDiagonalAction(allowsDiagonalAction)
         , m_threeBitMode(threeBitMode)
     {
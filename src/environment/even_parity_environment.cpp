@@ -25,10 +25,11 @@ namespace xcspp
         }
     }
 
-    EvenParityEnvironment::EvenParityEnvironment(std::size_t length)
+    EvenParityEnvironment::EvenParityEnvironment(std::size_t length, std::optional<std::uint64_t> seed)
         : m_length(length)
         , m_situation(length)
         , m_isEndOfProblem(false)
+        , m_random(seed)
     {
         SetRandomSituation(m_situation, m_random);
     }
@@ -25,10 +25,11 @@ namespace xcspp
         }
     }
 
-    MajorityOnEnvironment::MajorityOnEnvironment(std::size_t length)
+    MajorityOnEnvironment::MajorityOnEnvironment(std::size_t length, std::optional<std::uint64_t> seed)
         : m_length(length)
         , m_situation(length)
         , m_isEndOfProblem(false)
+        , m_random(seed)
     {
         if ((m_length % 2) == 0)
         {
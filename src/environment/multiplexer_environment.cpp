@@ -49,10 +49,11 @@ namespace xcspp
         }
     }
 
-    MultiplexerEnvironment::MultiplexerEnvironment(std::size_t length, unsigned int imbalanceLevel)
+    MultiplexerEnvironment::MultiplexerEnvironment(std::size_t length, unsigned int imbalanceLevel, std::optional<std::uint64_t> seed)
         : m_minorityAcceptanceProbability(1.0 / std::pow(2, imbalanceLevel))
         , m_situation(length)
         , m_isEndOfProblem(false)
+        , m_random(seed)
     {
         // Total length must be n + 2^n (n > 0)
         const auto addressBitLength = AddressBitLength(length);
@@ -49,11 +49,12 @@ namespace xcspp
         }
     }
 
-    RealMultiplexerEnvironment::RealMultiplexerEnvironment(std::size_t length, unsigned int imbalanceLevel, double binaryThreshold)
+    RealMultiplexerEnvironment::RealMultiplexerEnvironment(std::size_t length, unsigned int imbalanceLevel, double binaryThreshold, std::optional<std::uint64_t> seed)
         : m_minorityAcceptanceProbability(1.0 / std::pow(2, imbalanceLevel))
         , m_binaryThreshold(binaryThreshold)
         , m_situation(length)
         , m_isEndOfProblem(false)
+        , m_random(seed)
     {
         // Total length must be n + 2^n (n > 0)
         const auto addressBitLength = AddressBitLength(length);
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <cmath>
+
+using namespace xcspp;
+
+namespace
+{
+    // Update of a classifier in [A] calculated one by one (as described in the algorithmic description of XCS)
+    void UpdateReference(xcs::Classifier & cl, double p, double numerositySum, const xcs::XCSParams & params)
+    {
+        ++cl.experience;
+        if (params.useMAM && cl.experience < 1.0 / params.beta)
+        {
+            cl.epsilon += (std::abs(p - cl.prediction) - cl.epsilon) / cl.experience;
+            cl.prediction += (p - cl.prediction) / cl.experience;
+        }
+        else
+        {
+            cl.epsilon += params.beta * (std::abs(p - cl.prediction) - cl.epsilon);
+            cl.prediction += params.beta * (p - cl.prediction);
+        }
+        if (cl.experience < 1.0 / params.beta)
+        {
+            cl.actionSetSize += (numerositySum - cl.actionSetSize) / cl.experience;
+        }
+        else
+        {
+            cl.actionSetSize += params.beta * (numerositySum - cl.actionSetSize);
+        }
+    }
+
+    double AccuracyReference(const xcs::Classifier & cl, const xcs::XCSParams & params)
+    {
+        return (cl.epsilon < params.epsilonZero) ? 1.0 : params.alpha * std::pow(cl.epsilon / params.epsilonZero, -params.nu);
+    }
+
+    void ExpectUpdateMatchesReference(const xcs::XCSParams & params)
+    {
+        const std::unordered_set<int> availableActions = { 0, 1 };
+        std::vector<xcs::Classifier> classifiers;
+        for (int i = 0; i < 12; ++i)
+        {
+            // Distinct conditions matching "0 1 0 1"
+            std::string condition;
+            for (int j = 0; j < 4; ++j)
+            {
+                condition += ((i >> j) & 1) ? "# " : ((j % 2 == 0) ? "0 " : "1 ");
+            }
+            xcs::Classifier cl(condition, 0, 100.0 * i, 3.0 * i, 0.05 * (i + 1), 0);
+            cl.experience = static_cast<std::uint64_t>(i * 2);
+            cl.actionSetSize = 1.0 + i;
+            cl.numerosity = static_cast<std::uint64_t>(1 + i % 4);
+            classifiers.push_back(cl);
+        }
+        classifiers.emplace_back(std::string("# # # #"), 1, 0.0, 0.0, 0.01, 0);
+
+        xcs::Population population(classifiers, &params, availableActions);
+        Random random;
+        const xcs::MatchSet matchSet(population, { 0, 1, 0, 1 }, 0, &params, availableActions, random);
+        xcs::ActionSet actionSet(matchSet, 0, population, &params, availableActions);
+        ASSERT_EQ(actionSet.size(), 12);
+
+        // Reference
+        const double p = 700.0;
+        std::uint64_t numerositySum = 0;
+        for (const auto & handle : actionSet)
+        {
+            numerositySum += population[handle].numerosity;
+        }
+        std::vector<xcs::Classifier> expected;
+        double accuracySum = 0.0;
+        for (const auto & handle : actionSet)
+        {
+            xcs::Classifier cl = classifiers[handle.index];
+            UpdateReference(cl, p, static_cast<double>(numerositySum), params);
+            accuracySum += AccuracyReference(cl, params) * cl.numerosity;
+            expected.push_back(cl);
+        }
+        for (auto & cl : expected)
+        {
+            cl.fitness += params.beta * (AccuracyReference(cl, params) * cl.numerosity / accuracySum - cl.fitness);
+        }
+
+        actionSet.update(p, population);
+        std::size_t i = 0;
+        for (const auto & handle : actionSet)
+        {
+            const auto cl = population[handle];
+            const auto & expectedCl = expected[i++];
+            EXPECT_EQ(cl.experience, expectedCl.experience);
+            EXPECT_DOUBLE_EQ(cl.prediction, expectedCl.prediction);
+            EXPECT_DOUBLE_EQ(cl.epsilon, expectedCl.epsilon);
+            EXPECT_DOUBLE_EQ(cl.actionSetSize, expectedCl.actionSetSize);
+            EXPECT_NEAR(cl.fitness, expectedCl.fitness, 1e-12);
+            EXPECT_NEAR(population.accuracy(handle.index), AccuracyReference(expectedCl, params), 1e-12);
+        }
+    }
+}
+
+TEST(XCS_ActionSetTest, FastPow)
+{
+    for (const double base : { 0.0, 0.3, 1.0, 1.7, 25.0 })
+    {
+        for (const double exponent : { 0.0, 1.0, 5.0, 12.0, 2.5 })
+        {
+            EXPECT_NEAR(FastPow(base, exponent), std::pow(base, exponent), std::pow(base, exponent) * 1e-14);
+        }
+    }
+    EXPECT_TRUE(IsFastPowExponent(5.0));
+    EXPECT_FALSE(IsFastPowExponent(2.5));
+    EXPECT_FALSE(IsFastPowExponent(-1.0));
+}
+
+TEST(XCS_ActionSetTest, Update)
+{
+    xcs::XCSParams params;
+    params.doActionSetSubsumption = false;
+    params.epsilonZero = 5.0;
+    ExpectUpdateMatchesReference(params);
+
+    params.useMAM = false;
+    ExpectUpdateMatchesReference(params);
+
+    // Non-integer nu
+    params.nu = 4.5;
+    ExpectUpdateMatchesReference(params);
+}
+
+TEST(XCS_ActionSetTest, CachedAccuracy)
+{
+    xcs::XCSParams params;
+    params.epsilonZero = 10.0;
+    xcs::Population population({ xcs::Classifier(std::string("0 #"), 0, 100.0, 20.0, 0.1, 0) }, &params, { 0, 1 });
+    EXPECT_DOUBLE_EQ(population.accuracy(0), params.alpha * std::pow(2.0, -params.nu));
+
+    // The accuracy is recalculated when epsilon or the parameters change
+    population[0].epsilon = 40.0;
+    EXPECT_DOUBLE_EQ(population.accuracy(0), params.alpha * std::pow(4.0, -params.nu));
+    params.nu = 2.0;
+    EXPECT_DOUBLE_EQ(population.accuracy(0), params.alpha * std::pow(4.0, -2.0));
+    population[0].epsilon = 5.0;
+    EXPECT_DOUBLE_EQ(population.accuracy(0), 1.0);
+}
+
+TEST(XCS_ActionSetTest, NicheStatistics)
+{
+    xcs::XCSParams params;
+    params.epsilonZero = 10.0;
+    params.thetaGA = 1000;
+    const std::unordered_set<int> availableActions = { 0, 1 };
+
+    // "0 #" subsumes "0 1" but not "# 1"
+    xcs::Classifier subsumer(std::string("0 #"), 0, 1000.0, 0.0, 0.5, 3);
+    subsumer.experience = 100;
+    subsumer.numerosity = 2;
+    xcs::Classifier subsumed(std::string("0 1"), 0, 300.0, 50.0, 0.2, 7);
+    subsumed.numerosity = 3;
+    const xcs::Classifier other(std::string("# 1"), 0, 400.0, 30.0, 0.3, 5);
+    xcs::Population population({ subsumer, subsumed, other }, &params, availableActions);
+
+    Random random;
+    const xcs::MatchSet matchSet(population, { 0, 1 }, 10, &params, availableActions, random);
+    xcs::ActionSet actionSet(matchSet, 0, population, &params, availableActions);
+    ASSERT_EQ(actionSet.size(), 3);
+    EXPECT_FALSE(actionSet.hasNicheStatistics());
+
+    actionSet.update(1000.0, population);
+    ASSERT_EQ(actionSet.size(), 2);
+    ASSERT_TRUE(actionSet.hasNicheStatistics());
+
+    // The statistics kept through the subsumption agree with the ones calculated from the remaining members
+    const auto & statistics = actionSet.nicheStatistics();
+    std::uint64_t numerositySum = 0;
+    std::uint64_t timeStampSum = 0;
+    double fitnessSum = 0.0;
+    double accuracySum = 0.0;
+    for (const auto & handle : actionSet)
+    {
+        const auto cl = population[handle];
+        numerositySum += cl.numerosity;
+        timeStampSum += cl.numerosity * cl.timeStamp;
+        fitnessSum += cl.fitness;
+        accuracySum += population.accuracy(handle.index) * cl.numerosity;
+    }
+    EXPECT_EQ(statistics.numerositySum, 6u);
+    EXPECT_EQ(statistics.numerositySum, numerositySum);
+    EXPECT_EQ(statistics.timeStampSum, timeStampSum);
+    EXPECT_NEAR(statistics.fitnessSum, fitnessSum, 1e-12);
+    EXPECT_NEAR(statistics.accuracySum, accuracySum, 1e-12);
+
+    // The GA is not run (theta_GA is not reached), so the statistics are kept
+    actionSet.runGA({ 0, 1 }, population, 10, random);
+    EXPECT_TRUE(actionSet.hasNicheStatistics());
+
+    actionSet.generateSet(matchSet, 0, population);
+    EXPECT_FALSE(actionSet.hasNicheStatistics());
+}
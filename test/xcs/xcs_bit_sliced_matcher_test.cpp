@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include "xcs_test_helper.hpp"
+#include <algorithm>
+#include <random>
+
+using namespace xcspp;
+
+TEST(XCS_BitSlicedMatcherTest, MatchesSameAsCondition)
+{
+    std::mt19937 engine(1);
+    for (const std::size_t length : { 1, 6, 64, 70, 135 })
+    {
+        xcs::BitSlicedMatcher matcher;
+        std::vector<xcs::Condition> conditions;
+        for (std::size_t i = 0; i < 1100; ++i)
+        {
+            conditions.push_back(RandomCondition(length, 0.5, engine));
+            matcher.insert(i, conditions.back());
+        }
+
+        std::vector<std::size_t> matchedColumns;
+        for (int t = 0; t < 50; ++t)
+        {
+            const auto situation = RandomSituation(length, engine);
+            matcher.match(xcs::PackedSituation(situation), matchedColumns);
+
+            std::vector<std::size_t> expected;
+            for (std::size_t i = 0; i < conditions.size(); ++i)
+            {
+                if (conditions[i].matches(situation))
+                {
+                    expected.push_back(i);
+                }
+            }
+            EXPECT_EQ(matchedColumns, expected);
+        }
+    }
+}
+
+TEST(XCS_BitSlicedMatcherTest, EraseAndReuseColumn)
+{
+    xcs::BitSlicedMatcher matcher;
+    matcher.insert(0, xcs::Condition("0 1 #"));
+    matcher.insert(1, xcs::Condition("# 1 #"));
+    matcher.insert(2, xcs::Condition("1 # #"));
+
+    std::vector<std::size_t> matchedColumns;
+    matcher.match(xcs::PackedSituation({ 0, 1, 1 }), matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 0, 1 }));
+
+    matcher.erase(1);
+    EXPECT_EQ(matcher.size(), 2);
+    matcher.match(xcs::PackedSituation({ 0, 1, 1 }), matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 0 }));
+
+    // The old bits of the reused column are gone
+    matcher.insert(1, xcs::Condition("# 0 1"));
+    matcher.match(xcs::PackedSituation({ 0, 1, 1 }), matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 0 }));
+    matcher.match(xcs::PackedSituation({ 1, 0, 1 }), matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 1, 2 }));
+
+    // Columns beyond the first block
+    matcher.insert(1000, xcs::Condition("# # #"));
+    matcher.match(xcs::PackedSituation({ 1, 0, 1 }), matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 1, 2, 1000 }));
+
+    EXPECT_THROW(matcher.erase(3), std::invalid_argument);
+    EXPECT_THROW(matcher.insert(3, xcs::Condition("0 1")), std::invalid_argument);
+    EXPECT_THROW(matcher.match(xcs::PackedSituation({ 0, 1 }), matchedColumns), std::invalid_argument);
+}
+
+TEST(XCS_BitSlicedMatcherTest, NonBinarySymbols)
+{
+    xcs::BitSlicedMatcher matcher;
+    matcher.insert(0, xcs::Condition("0 # #"));
+    matcher.insert(1, xcs::Condition("# 2 #"));
+    EXPECT_EQ(matcher.unslicedColumns(), std::vector<std::size_t>({ 1 }));
+
+    // Non-binary input values match "#" only
+    std::vector<std::size_t> matchedColumns;
+    matcher.match(xcs::PackedSituation({ 0, 2, 1 }), matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 0 }));
+    matcher.match(xcs::PackedSituation({ 3, 2, 1 }), matchedColumns);
+    EXPECT_TRUE(matchedColumns.empty());
+
+    matcher.erase(1);
+    EXPECT_TRUE(matcher.unslicedColumns().empty());
+}
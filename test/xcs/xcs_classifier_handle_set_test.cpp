@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include "xcs_test_helper.hpp"
+
+using namespace xcspp;
+
+namespace
+{
+    std::vector<std::uint32_t> MemberIndices(const xcs::ClassifierHandleSet & set)
+    {
+        std::vector<std::uint32_t> indices;
+        for (const auto & handle : set)
+        {
+            indices.push_back(handle.index);
+        }
+        return indices;
+    }
+}
+
+TEST(XCS_ClassifierHandleSetTest, Membership)
+{
+    const xcs::XCSParams params;
+    xcs::Population population(&params, { 0, 1 });
+    for (const auto & condition : { "0 0", "0 1", "1 0", "1 1" })
+    {
+        population.insert(MakeClassifier(condition, 0));
+    }
+
+    xcs::ClassifierHandleSet set(&params, { 0, 1 });
+    set.insert(population.handle(3));
+    set.insert(population.handle(1));
+    set.insert(population.handle(3));
+    EXPECT_EQ(MemberIndices(set), std::vector<std::uint32_t>({ 3, 1 }));
+    EXPECT_EQ(set.count(population.handle(1)), 1);
+    EXPECT_EQ(set.count(population.handle(0)), 0);
+
+    set.erase(population.handle(3));
+    EXPECT_EQ(MemberIndices(set), std::vector<std::uint32_t>({ 1 }));
+    EXPECT_EQ(set.count(population.handle(3)), 0);
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.count(population.handle(1)), 0);
+}
+
+TEST(XCS_ClassifierHandleSetTest, StaleMembers)
+{
+    const xcs::XCSParams params;
+    xcs::Population population(&params, { 0, 1 });
+    for (const auto & condition : { "0 0", "0 1", "1 0" })
+    {
+        population.insert(MakeClassifier(condition, 0));
+    }
+
+    xcs::ClassifierHandleSet set(&params, { 0, 1 });
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        set.insert(population.handle(i));
+    }
+
+    // The slot of the removed member is reused by another classifier
+    const auto staleHandle = population.handle(1);
+    population.erase(1);
+    EXPECT_EQ(population.insert(MakeClassifier("1 1", 1)), 1);
+    EXPECT_EQ(set.count(staleHandle), 1);
+    EXPECT_EQ(set.count(population.handle(1)), 0);
+
+    // Inserting the new classifier replaces the stale member
+    xcs::ClassifierHandleSet otherSet = set;
+    otherSet.insert(population.handle(1));
+    EXPECT_EQ(MemberIndices(otherSet), std::vector<std::uint32_t>({ 0, 2, 1 }));
+    EXPECT_EQ(otherSet.count(staleHandle), 0);
+    EXPECT_EQ(otherSet.count(population.handle(1)), 1);
+
+    set.removeStaleHandles(population);
+    EXPECT_EQ(MemberIndices(set), std::vector<std::uint32_t>({ 0, 2 }));
+    EXPECT_EQ(set.count(staleHandle), 0);
+}
@@ -112,3 +112,158 @@ TEST(XCS_ConditionTest, ToStringAndConstructor)
     EXPECT_EQ(condStr2, condStrRec2);
     EXPECT_EQ(condStr3, condStrRec3);
 }
+
+TEST(XCS_ConditionTest, NonBinaryAlphabet)
+{
+    const xcs::Condition cond("0 2 # 1");
+    EXPECT_FALSE(cond.isPacked());
+    EXPECT_TRUE(cond.matches({ 0, 2, 5, 1 }));
+    EXPECT_FALSE(cond.matches({ 0, 1, 5, 1 }));
+    EXPECT_TRUE(cond.matches(xcs::PackedSituation({ 0, 2, 5, 1 })));
+    EXPECT_FALSE(cond.matches(xcs::PackedSituation({ 0, 1, 5, 1 })));
+    EXPECT_EQ(cond.dontCareCount(), 1);
+    EXPECT_EQ(cond.toString(), "0 2 # 1");
+
+    // Binary conditions never match non-binary input values at specified positions
+    const xcs::Condition binaryCond("0 1 # 1");
+    EXPECT_TRUE(binaryCond.isPacked());
+    EXPECT_TRUE(binaryCond.matches({ 0, 1, 2, 1 }));
+    EXPECT_FALSE(binaryCond.matches({ 0, 2, 2, 1 }));
+    EXPECT_TRUE(binaryCond.matches(xcs::PackedSituation({ 0, 1, 2, 1 })));
+    EXPECT_FALSE(binaryCond.matches(xcs::PackedSituation({ 0, 2, 2, 1 })));
+
+    // Comparison between bit-packed and non-binary conditions
+    EXPECT_TRUE(xcs::Condition("# 2 # #").isMoreGeneral(cond));
+    EXPECT_FALSE(binaryCond.isMoreGeneral(cond));
+    EXPECT_NE(binaryCond, cond);
+
+    xcs::Condition cond2(binaryCond);
+    cond2.setValue(1, 2);
+    EXPECT_FALSE(cond2.isPacked());
+    EXPECT_EQ(cond2, xcs::Condition("0 2 # 1"));
+}
+
+TEST(XCS_ConditionTest, LongCondition)
+{
+    // 135 symbols (spanning three 64-bit words)
+    std::string condStr;
+    std::string generalCondStr;
+    std::vector<int> situation;
+    for (int i = 0; i < 135; ++i)
+    {
+        const bool isSpecified = (i % 3 == 0);
+        condStr += isSpecified ? std::to_string(i % 2) : "#";
+        condStr += ' ';
+        generalCondStr += (isSpecified && i < 100) ? std::to_string(i % 2) : "#";
+        generalCondStr += ' ';
+        situation.push_back(i % 2);
+    }
+    const xcs::Condition cond(condStr);
+    const xcs::Condition generalCond(generalCondStr);
+    EXPECT_EQ(cond.size(), 135);
+    EXPECT_EQ(cond.dontCareCount(), 90);
+    EXPECT_TRUE(cond.matches(situation));
+    EXPECT_TRUE(cond.matches(xcs::PackedSituation(situation)));
+    EXPECT_TRUE(generalCond.isMoreGeneral(cond));
+    EXPECT_FALSE(cond.isMoreGeneral(generalCond));
+
+    // Flip an input value in the last word
+    situation[132] = 1 - situation[132];
+    EXPECT_FALSE(cond.matches(situation));
+    EXPECT_FALSE(cond.matches(xcs::PackedSituation(situation)));
+    EXPECT_TRUE(generalCond.matches(situation));
+    EXPECT_TRUE(generalCond.matches(xcs::PackedSituation(situation)));
+}
+
+TEST(XCS_ConditionTest, SwapSymbols)
+{
+    xcs::Condition cond1("0 0 0 0 0 0");
+    xcs::Condition cond2("1 1 # # 1 1");
+
+    cond1.swapSymbols(cond2, 1, 4);
+    EXPECT_EQ(cond1, xcs::Condition("0 1 # # 0 0"));
+    EXPECT_EQ(cond2, xcs::Condition("1 0 0 0 1 1"));
+
+    cond1.swapSymbol(cond2, 5);
+    EXPECT_EQ(cond1, xcs::Condition("0 1 # # 0 1"));
+    EXPECT_EQ(cond2, xcs::Condition("1 0 0 0 1 0"));
+
+    // Swapping with a non-binary condition
+    xcs::Condition cond3("2 2 2 2 2 2");
+    cond1.swapSymbols(cond3, 0, 2);
+    EXPECT_EQ(cond1, xcs::Condition("2 2 # # 0 1"));
+    EXPECT_EQ(cond3, xcs::Condition("0 1 2 2 2 2"));
+}
+
+TEST(XCS_ConditionTest, SwapMaskedSymbols)
+{
+    // The mask swaps the same symbols as swapSymbol() for each bit, and the hashes follow
+    std::string symbols1;
+    std::string symbols2;
+    for (int i = 0; i < 70; ++i)
+    {
+        symbols1 += "01#"[i % 3];
+        symbols1 += ' ';
+        symbols2 += "#10"[i % 3];
+        symbols2 += ' ';
+    }
+    for (const bool isPacked : { true, false })
+    {
+        xcs::Condition cond1(symbols1);
+        xcs::Condition cond2(symbols2);
+        if (!isPacked)
+        {
+            cond2.setValue(69, 2);
+        }
+        xcs::Condition expected1(cond1);
+        xcs::Condition expected2(cond2);
+        ASSERT_EQ(cond2.isPacked(), isPacked);
+
+        const std::uint64_t masks[] = { 0xF0F0F0F0F0F0F0F1ULL, 0xFFFFFFFFFFFFFFFFULL };
+        for (std::size_t w = 0; w < 2; ++w)
+        {
+            cond1.swapMaskedSymbols(cond2, w * 64, masks[w]);
+            for (std::size_t i = 0; i < 64 && w * 64 + i < 70; ++i)
+            {
+                if ((masks[w] >> i) & 1)
+                {
+                    expected1.swapSymbol(expected2, w * 64 + i);
+                }
+            }
+        }
+        EXPECT_EQ(cond1, expected1);
+        EXPECT_EQ(cond2, expected2);
+        EXPECT_EQ(cond1.hash(), expected1.hash());
+        EXPECT_EQ(cond2.hash(), expected2.hash());
+    }
+}
+
+TEST(XCS_ConditionTest, Hash)
+{
+    xcs::Condition cond1("0 1 # # 0 0");
+    xcs::Condition cond2("1 1 # # 1 1");
+    EXPECT_NE(cond1.hash(), cond2.hash());
+
+    // The hash follows the modifications
+    cond1.setValue(0, 1);
+    cond1.setValue(4, 1);
+    cond1.setValue(5, 1);
+    EXPECT_EQ(cond1, cond2);
+    EXPECT_EQ(cond1.hash(), cond2.hash());
+
+    cond1.setToDontCare(1);
+    EXPECT_EQ(cond1.hash(), xcs::Condition("1 # # # 1 1").hash());
+
+    xcs::Condition cond3("0 0 0 0 0 0");
+    cond1.swapSymbols(cond3, 1, 4);
+    EXPECT_EQ(cond1.hash(), xcs::Condition("1 0 0 0 1 1").hash());
+    EXPECT_EQ(cond3.hash(), xcs::Condition("0 # # # 0 0").hash());
+
+    // Packed and non-binary conditions have the same hash for the same symbols
+    xcs::Condition cond4("2 2 2 2 2 2");
+    cond1.swapSymbols(cond4, 0, 2);
+    EXPECT_EQ(cond1.hash(), xcs::Condition("2 2 0 0 1 1").hash());
+    cond1.swapSymbols(cond4, 0, 2);
+    EXPECT_EQ(cond1.hash(), xcs::Condition("1 0 0 0 1 1").hash());
+    EXPECT_EQ(cond4.hash(), xcs::Condition("2 2 2 2 2 2").hash());
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <vector>
+
+using namespace xcspp;
+
+namespace
+{
+    std::vector<double> SelectionFrequencies(xcs::DeletionWheel & wheel, std::size_t slotCount, Random & random)
+    {
+        constexpr int kTrialCount = 100000;
+        std::vector<double> frequencies(slotCount, 0.0);
+        for (int i = 0; i < kTrialCount; ++i)
+        {
+            frequencies[wheel.select(random)] += 1.0 / kTrialCount;
+        }
+        return frequencies;
+    }
+}
+
+TEST(XCS_DeletionWheelTest, FenwickTree)
+{
+    FenwickTree<double> tree;
+    tree.resize(3);
+    tree.set(0, 1.0);
+    tree.set(2, 2.0);
+    tree.resize(6);
+    tree.set(4, 3.0);
+    EXPECT_DOUBLE_EQ(tree.sum(), 6.0);
+
+    // Zero weights are never found
+    EXPECT_EQ(tree.find(0.0), 0);
+    EXPECT_EQ(tree.find(1.0), 2);
+    EXPECT_EQ(tree.find(2.5), 2);
+    EXPECT_EQ(tree.find(3.0), 4);
+    EXPECT_EQ(tree.find(6.0), 6);
+
+    tree.set(2, 0.0);
+    tree.rebuild();
+    EXPECT_DOUBLE_EQ(tree.sum(), 4.0);
+    EXPECT_EQ(tree.find(1.0), 4);
+}
+
+TEST(XCS_DeletionWheelTest, Sums)
+{
+    const xcs::XCSParams params;
+    xcs::DeletionWheel wheel(&params);
+    wheel.update(0, 10.0, 2, 0.5, 0);
+    wheel.update(3, 10.0, 1, 0.25, 0);
+    EXPECT_EQ(wheel.numerositySum(), 3);
+    EXPECT_DOUBLE_EQ(wheel.fitnessSum(), 0.75);
+
+    // Empty slot
+    wheel.update(0, 0.0, 0, 0.0, 0);
+    EXPECT_EQ(wheel.numerositySum(), 1);
+    EXPECT_DOUBLE_EQ(wheel.fitnessSum(), 0.25);
+
+    Random random(1);
+    EXPECT_EQ(wheel.select(random), 3);
+
+    wheel.clear();
+    EXPECT_EQ(wheel.numerositySum(), 0);
+    EXPECT_THROW(wheel.select(random), std::runtime_error);
+}
+
+TEST(XCS_DeletionWheelTest, SelectByVote)
+{
+    xcs::XCSParams params;
+    params.thetaDel = 20;
+    params.delta = 0.1;
+    xcs::DeletionWheel wheel(&params);
+    Random random(1);
+
+    // Votes: 10, 0 (empty), 20, 10
+    wheel.update(0, 10.0, 1, 1.0, 100);
+    wheel.update(2, 10.0, 2, 2.0, 100);
+    wheel.update(3, 10.0, 1, 1.0, 100);
+    auto frequencies = SelectionFrequencies(wheel, 4, random);
+    EXPECT_NEAR(frequencies[0], 0.25, 0.01);
+    EXPECT_EQ(frequencies[1], 0.0);
+    EXPECT_NEAR(frequencies[2], 0.5, 0.01);
+    EXPECT_NEAR(frequencies[3], 0.25, 0.01);
+
+    // The fitness of slot 3 falls below delta * averageFitness (= 0.1 * 3.05 / 4)
+    //   Its vote is 10 * averageFitness / 0.05 = 152.5.
+    wheel.update(3, 10.0, 1, 0.05, 100);
+    frequencies = SelectionFrequencies(wheel, 4, random);
+    EXPECT_NEAR(frequencies[3], 152.5 / 182.5, 0.01);
+
+    // The threshold (delta * 1.45 / 4) moves down below slot 3 as the average fitness decreases
+    wheel.update(2, 10.0, 2, 0.4, 100);
+    frequencies = SelectionFrequencies(wheel, 4, random);
+    EXPECT_NEAR(frequencies[3], 0.25, 0.01);
+
+    // Inexperienced classifiers are not penalized
+    wheel.update(3, 10.0, 1, 0.01, 10);
+    frequencies = SelectionFrequencies(wheel, 4, random);
+    EXPECT_NEAR(frequencies[3], 0.25, 0.01);
+
+    // The buckets are rebuilt when the parameters change
+    params.thetaDel = 5;
+    frequencies = SelectionFrequencies(wheel, 4, random);
+    const double averageFitness = 1.41 / 4;
+    const double vote = 10.0 * averageFitness / 0.01;
+    EXPECT_NEAR(frequencies[3], vote / (30.0 + vote), 0.01);
+}
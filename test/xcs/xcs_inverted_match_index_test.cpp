@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include "xcs_test_helper.hpp"
+#include <algorithm>
+#include <random>
+
+using namespace xcspp;
+
+TEST(XCS_InvertedMatchIndexTest, MatchesSameAsCondition)
+{
+    std::mt19937 engine(1);
+    for (const std::size_t length : { 1, 6, 64, 70, 135 })
+    {
+        for (const double dontCareProbability : { 0.1, 0.5, 0.9 })
+        {
+            xcs::InvertedMatchIndex index;
+            std::vector<xcs::Condition> conditions;
+            std::vector<bool> isInUse;
+            for (std::size_t i = 0; i < 600; ++i)
+            {
+                conditions.push_back(RandomCondition(length, dontCareProbability, engine));
+                isInUse.push_back(true);
+                index.insert(i, conditions.back());
+            }
+
+            // Remove and reinsert some columns so that the posting lists are reordered
+            std::uniform_int_distribution<std::size_t> columnDist(0, conditions.size() - 1);
+            for (int i = 0; i < 400; ++i)
+            {
+                const std::size_t column = columnDist(engine);
+                if (isInUse[column])
+                {
+                    index.erase(column);
+                }
+                else
+                {
+                    conditions[column] = RandomCondition(length, dontCareProbability, engine);
+                    index.insert(column, conditions[column]);
+                }
+                isInUse[column] = !isInUse[column];
+            }
+
+            std::vector<std::size_t> matchedColumns;
+            for (int t = 0; t < 50; ++t)
+            {
+                // Make some situations from conditions to have non-empty match sets
+                auto situation = RandomSituation(length, engine);
+                if (t % 2 == 0)
+                {
+                    const auto & condition = conditions[columnDist(engine)];
+                    for (std::size_t i = 0; i < length; ++i)
+                    {
+                        if (!condition.isDontCare(i))
+                        {
+                            situation[i] = condition[i].value();
+                        }
+                    }
+                }
+                index.match(xcs::PackedSituation(situation), matchedColumns);
+
+                std::vector<std::size_t> expected;
+                for (std::size_t i = 0; i < conditions.size(); ++i)
+                {
+                    if (isInUse[i] && conditions[i].matches(situation))
+                    {
+                        expected.push_back(i);
+                    }
+                }
+                EXPECT_EQ(matchedColumns, expected);
+                EXPECT_GE(index.candidateCount(xcs::PackedSituation(situation)), expected.size());
+            }
+        }
+    }
+}
+
+TEST(XCS_InvertedMatchIndexTest, EraseAndReuseColumn)
+{
+    xcs::InvertedMatchIndex index;
+    index.insert(0, xcs::Condition("0 1 #"));
+    index.insert(1, xcs::Condition("# 1 #"));
+    index.insert(2, xcs::Condition("1 # #"));
+
+    std::vector<std::size_t> matchedColumns;
+    index.match(xcs::PackedSituation({ 0, 1, 1 }), matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 0, 1 }));
+    EXPECT_EQ(index.candidateCount(xcs::PackedSituation({ 0, 1, 1 })), 2);
+
+    index.erase(1);
+    EXPECT_EQ(index.size(), 2);
+    index.match(xcs::PackedSituation({ 0, 1, 1 }), matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 0 }));
+
+    // The old postings of the reused column are gone
+    index.insert(1, xcs::Condition("# 0 1"));
+    index.match(xcs::PackedSituation({ 0, 1, 1 }), matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 0 }));
+    index.match(xcs::PackedSituation({ 1, 0, 1 }), matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 1, 2 }));
+
+    // Sparse columns
+    index.insert(1000, xcs::Condition("# # #"));
+    index.match(xcs::PackedSituation({ 1, 0, 1 }), matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 1, 2, 1000 }));
+
+    EXPECT_THROW(index.erase(3), std::invalid_argument);
+    EXPECT_THROW(index.insert(2, xcs::Condition("# # #")), std::invalid_argument);
+    EXPECT_THROW(index.insert(3, xcs::Condition("0 1")), std::invalid_argument);
+    EXPECT_THROW(index.match(xcs::PackedSituation({ 0, 1 }), matchedColumns), std::invalid_argument);
+}
+
+TEST(XCS_InvertedMatchIndexTest, NonBinarySymbols)
+{
+    xcs::InvertedMatchIndex index;
+    index.insert(0, xcs::Condition("0 # #"));
+    index.insert(1, xcs::Condition("# 2 #"));
+    EXPECT_EQ(index.unindexedColumns(), std::vector<std::size_t>({ 1 }));
+
+    // Non-binary input values match "#" only
+    std::vector<std::size_t> matchedColumns;
+    index.match(xcs::PackedSituation({ 0, 2, 1 }), matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 0 }));
+    index.match(xcs::PackedSituation({ 3, 2, 1 }), matchedColumns);
+    EXPECT_TRUE(matchedColumns.empty());
+
+    index.erase(1);
+    EXPECT_TRUE(index.unindexedColumns().empty());
+}
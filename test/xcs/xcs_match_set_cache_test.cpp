@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include "xcs_test_helper.hpp"
+#include <random>
+
+using namespace xcspp;
+
+namespace
+{
+    std::vector<std::size_t> CachedMatchedIndices(xcs::MatchSetCache & cache, const xcs::Population & population, const std::vector<int> & situation)
+    {
+        std::vector<std::size_t> matchedIndices;
+        cache.match(population, situation, xcs::PackedSituation(situation), matchedIndices);
+        return matchedIndices;
+    }
+
+    std::vector<std::size_t> MatchedIndices(const xcs::Population & population, const std::vector<int> & situation)
+    {
+        std::vector<std::size_t> matchedIndices;
+        population.match(xcs::PackedSituation(situation), matchedIndices);
+        return matchedIndices;
+    }
+}
+
+TEST(XCS_MatchSetCacheTest, RepairAfterModification)
+{
+    xcs::XCSParams params;
+    params.matchSetCacheSize = 1 << 20;
+    xcs::Population population({ MakeClassifier("0 #", 0), MakeClassifier("# 1", 1), MakeClassifier("1 1", 1) }, &params, { 0, 1 });
+    xcs::MatchSetCache cache(&params);
+
+    EXPECT_EQ(CachedMatchedIndices(cache, population, { 0, 1 }), std::vector<std::size_t>({ 0, 1 }));
+    EXPECT_EQ(cache.missCount(), 1);
+    EXPECT_EQ(CachedMatchedIndices(cache, population, { 0, 1 }), std::vector<std::size_t>({ 0, 1 }));
+    EXPECT_EQ(cache.hitCount(), 1);
+
+    // Insertion
+    population.insert(MakeClassifier("# #", 0));
+    EXPECT_EQ(CachedMatchedIndices(cache, population, { 0, 1 }), std::vector<std::size_t>({ 0, 1, 3 }));
+
+    // Removal and reuse of the slot by a classifier not matching the situation
+    population.erase(0);
+    population.insert(MakeClassifier("1 0", 0));
+    EXPECT_EQ(CachedMatchedIndices(cache, population, { 0, 1 }), std::vector<std::size_t>({ 1, 3 }));
+
+    // Non-binary conditions
+    population.insert(MakeClassifier("0 2", 1));
+    EXPECT_EQ(CachedMatchedIndices(cache, population, { 0, 2 }), std::vector<std::size_t>({ 3, 4 }));
+    population.erase(3);
+    EXPECT_EQ(CachedMatchedIndices(cache, population, { 0, 2 }), std::vector<std::size_t>({ 4 }));
+
+    // Replaced population
+    population.setClassifiers({ MakeClassifier("# 1", 1) });
+    EXPECT_EQ(CachedMatchedIndices(cache, population, { 0, 1 }), std::vector<std::size_t>({ 0 }));
+
+    EXPECT_EQ(cache.hitCount(), 5);
+    EXPECT_EQ(cache.missCount(), 2);
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(XCS_MatchSetCacheTest, MatchesSameAsPopulation)
+{
+    xcs::XCSParams params;
+    params.matchSetCacheSize = 1 << 20;
+    xcs::Population population(&params, { 0, 1 });
+    xcs::MatchSetCache cache(&params);
+
+    std::mt19937 engine(1);
+    std::uniform_int_distribution<int> symbolDist(0, 2);
+    std::uniform_int_distribution<int> situationDist(0, 15);
+    for (int t = 0; t < 2000; ++t)
+    {
+        // Modify [P] randomly
+        if (population.size() > 30 || (t % 3 == 0 && !population.empty()))
+        {
+            std::size_t idx = std::uniform_int_distribution<std::size_t>(0, population.slotCount() - 1)(engine);
+            while (!population.isOccupied(idx))
+            {
+                idx = (idx + 1) % population.slotCount();
+            }
+            population.erase(idx);
+        }
+        else
+        {
+            std::string condition;
+            for (int i = 0; i < 4; ++i)
+            {
+                const int symbol = symbolDist(engine);
+                condition += (symbol == 2) ? "# " : std::to_string(symbol) + " ";
+            }
+            population.insert(MakeClassifier(condition, 0));
+        }
+
+        // Only 16 distinct situations
+        const int bits = situationDist(engine);
+        const std::vector<int> situation = { bits & 1, (bits >> 1) & 1, (bits >> 2) & 1, (bits >> 3) & 1 };
+        EXPECT_EQ(CachedMatchedIndices(cache, population, situation), MatchedIndices(population, situation));
+    }
+    EXPECT_EQ(cache.missCount(), 16);
+}
+
+TEST(XCS_MatchSetCacheTest, LeastRecentlyUsedEviction)
+{
+    xcs::XCSParams params;
+    params.matchSetCacheSize = 1 << 20;
+    xcs::Population population({ MakeClassifier("0 0", 0), MakeClassifier("0 1", 0), MakeClassifier("1 0", 0) }, &params, { 0, 1 });
+    xcs::MatchSetCache cache(&params);
+
+    // Limit the memory to two entries
+    CachedMatchedIndices(cache, population, { 0, 0 });
+    CachedMatchedIndices(cache, population, { 0, 1 });
+    params.matchSetCacheSize = cache.memoryUsage();
+
+    // { 0, 1 } is evicted since { 0, 0 } is used more recently
+    CachedMatchedIndices(cache, population, { 0, 0 });
+    EXPECT_EQ(CachedMatchedIndices(cache, population, { 1, 0 }), std::vector<std::size_t>({ 2 }));
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_LE(cache.memoryUsage(), params.matchSetCacheSize);
+    EXPECT_EQ(cache.hitCount(), 1);
+    EXPECT_EQ(cache.missCount(), 3);
+
+    CachedMatchedIndices(cache, population, { 0, 0 });
+    EXPECT_EQ(cache.hitCount(), 2);
+    CachedMatchedIndices(cache, population, { 0, 1 });
+    EXPECT_EQ(cache.missCount(), 4);
+}
+
+TEST(XCS_MatchSetCacheTest, Disabled)
+{
+    const xcs::XCSParams params;
+    xcs::Population population({ MakeClassifier("0 #", 0) }, &params, { 0, 1 });
+    xcs::MatchSetCache cache(&params);
+    EXPECT_FALSE(cache.isEnabled());
+    EXPECT_EQ(CachedMatchedIndices(cache, population, { 0, 1 }), std::vector<std::size_t>({ 0 }));
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(cache.missCount(), 0);
+}
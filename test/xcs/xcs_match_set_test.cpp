@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <set>
+
+using namespace xcspp;
+
+namespace
+{
+    std::unordered_set<int> MakeActions(int count)
+    {
+        std::unordered_set<int> actions;
+        for (int i = 0; i < count; ++i)
+        {
+            actions.insert(i * 10);
+        }
+        return actions;
+    }
+
+    std::uint64_t NumerositySum(const xcs::Population & population)
+    {
+        std::uint64_t numerositySum = 0;
+        for (const auto & cl : population)
+        {
+            numerositySum += cl.numerosity;
+        }
+        return numerositySum;
+    }
+
+    // Every member of [M] is in [P], the members are in ascending order of the slot indices, and their
+    // actions are distinct
+    void ExpectValidCoveringMatchSet(const xcs::MatchSet & matchSet, const xcs::Population & population)
+    {
+        std::set<int> actions;
+        std::size_t prevIdx = 0;
+        for (const auto & handle : matchSet)
+        {
+            ASSERT_TRUE(population.contains(handle));
+            EXPECT_TRUE(actions.empty() || prevIdx < handle.index);
+            EXPECT_TRUE(actions.insert(population[handle].action).second);
+            prevIdx = handle.index;
+        }
+    }
+}
+
+TEST(XCS_MatchSetTest, CoverAllActionsAtOnce)
+{
+    const xcs::XCSParams params;
+    const auto availableActions = MakeActions(100);
+    xcs::Population population(&params, availableActions);
+    Random random(1);
+
+    // All actions are covered in one round
+    xcs::MatchSet matchSet(&params, availableActions);
+    matchSet.generateSet(population, { 0, 1, 1, 0 }, 0, random);
+    EXPECT_TRUE(matchSet.isCoveringPerformed());
+    EXPECT_EQ(matchSet.size(), 100);
+    EXPECT_EQ(population.size(), 100);
+    ExpectValidCoveringMatchSet(matchSet, population);
+
+    // The same [M] is found without covering
+    std::vector<xcs::ClassifierHandle> coveredHandles(matchSet.begin(), matchSet.end());
+    matchSet.generateSet(population, { 0, 1, 1, 0 }, 1, random);
+    EXPECT_FALSE(matchSet.isCoveringPerformed());
+    EXPECT_TRUE(std::equal(matchSet.begin(), matchSet.end(), coveredHandles.begin(), coveredHandles.end()));
+}
+
+TEST(XCS_MatchSetTest, CoverOnlyMissingActions)
+{
+    xcs::XCSParams params;
+    params.partitionByAction = true;
+    const auto availableActions = MakeActions(5);
+    xcs::Population population({
+        xcs::Classifier(std::string("# #"), 20, 10.0, 0.0, 0.01, 0),
+        xcs::Classifier(std::string("1 #"), 40, 10.0, 0.0, 0.01, 0),
+        xcs::Classifier(std::string("0 #"), 0, 10.0, 0.0, 0.01, 0),
+    }, &params, availableActions);
+    Random random(2);
+
+    // Actions 10, 30 and 40 are covered ("1 #" does not match)
+    xcs::MatchSet matchSet(&params, availableActions);
+    matchSet.generateSet(population, { 0, 1 }, 0, random);
+    EXPECT_TRUE(matchSet.isCoveringPerformed());
+    EXPECT_EQ(population.size(), 6);
+    ASSERT_TRUE(matchSet.isPartitioned());
+    for (std::size_t i = 0; i < availableActions.size(); ++i)
+    {
+        ASSERT_EQ(std::distance(matchSet.partitionBegin(i), matchSet.partitionEnd(i)), 1);
+        EXPECT_EQ(population[*matchSet.partitionBegin(i)].action, matchSet.actionOrdinals().action(i));
+    }
+}
+
+TEST(XCS_MatchSetTest, DeletionAfterCovering)
+{
+    // [P] overflows while covering, so that the deletion after covering may remove members of [M],
+    // including covering classifiers generated in the same step
+    xcs::XCSParams params;
+    params.n = 3;
+    const auto availableActions = MakeActions(10);
+    xcs::Population population(&params, availableActions);
+    Random random(3);
+
+    xcs::MatchSet matchSet(&params, availableActions);
+    matchSet.generateSet(population, { 1, 0, 1 }, 0, random);
+    EXPECT_TRUE(matchSet.isCoveringPerformed());
+
+    // One deletion for each covering classifier, and the deleted classifiers are not in [M]
+    EXPECT_EQ(NumerositySum(population), params.n);
+    EXPECT_EQ(matchSet.size(), population.size());
+    ExpectValidCoveringMatchSet(matchSet, population);
+
+    // The actions of the deleted covering classifiers are not covered again in this step, so [M] lacks
+    // them (unlike the old rescan of [P] after each covering, which covered such an action again)
+    EXPECT_EQ(matchSet.size(), params.n);
+    std::set<int> actionsInSet;
+    for (const auto & handle : matchSet)
+    {
+        actionsInSet.insert(population[handle].action);
+    }
+    for (const auto & action : availableActions)
+    {
+        if (actionsInSet.count(action) == 0)
+        {
+            EXPECT_TRUE(std::none_of(population.begin(), population.end(),
+                [action](const auto & cl) { return cl.action == action; }));
+        }
+    }
+    EXPECT_EQ(availableActions.size() - actionsInSet.size(), 7);
+}
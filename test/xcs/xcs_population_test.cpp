@@ -0,0 +1,308 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include "xcs_test_helper.hpp"
+#include <sstream>
+
+using namespace xcspp;
+
+namespace
+{
+    std::vector<std::size_t> MatchedIndices(const xcs::Population & population, const std::vector<int> & situation)
+    {
+        std::vector<std::size_t> matchedIndices;
+        population.match(xcs::PackedSituation(situation), matchedIndices);
+        return matchedIndices;
+    }
+}
+
+TEST(XCS_PopulationTest, InsertAndErase)
+{
+    const xcs::XCSParams params;
+    xcs::Population population(&params, { 0, 1 });
+    EXPECT_EQ(population.insert(MakeClassifier("0 #", 0)), 0);
+    EXPECT_EQ(population.insert(MakeClassifier("# 2", 1)), 1);
+    EXPECT_EQ(population.insert(MakeClassifier("1 1", 1)), 2);
+    EXPECT_EQ(population.size(), 3);
+    EXPECT_EQ(population[1].condition, xcs::Condition("# 2"));
+    EXPECT_EQ(population[1].action, 1);
+
+    EXPECT_EQ(MatchedIndices(population, { 0, 2 }), std::vector<std::size_t>({ 0, 1 }));
+
+    const auto handle = population.handle(1);
+    EXPECT_TRUE(population.contains(handle));
+    population.erase(1);
+    EXPECT_FALSE(population.contains(handle));
+    EXPECT_FALSE(population.isOccupied(1));
+    EXPECT_EQ(population.size(), 2);
+    EXPECT_EQ(MatchedIndices(population, { 0, 2 }), std::vector<std::size_t>({ 0 }));
+    EXPECT_THROW(population.erase(1), std::invalid_argument);
+
+    // The released slot is reused with a new generation
+    EXPECT_EQ(population.insert(MakeClassifier("# 1", 0)), 1);
+    EXPECT_FALSE(population.contains(handle));
+    EXPECT_TRUE(population.contains(population.handle(1)));
+    EXPECT_EQ(MatchedIndices(population, { 1, 1 }), std::vector<std::size_t>({ 1, 2 }));
+}
+
+TEST(XCS_PopulationTest, IterationOrder)
+{
+    const xcs::XCSParams params;
+    xcs::Population population({ MakeClassifier("0 0", 0), MakeClassifier("0 1", 0), MakeClassifier("1 0", 0) }, &params, { 0, 1 });
+    population.erase(1);
+
+    std::vector<xcs::Condition> conditions;
+    for (const auto & cl : population)
+    {
+        conditions.push_back(cl.condition);
+    }
+    EXPECT_EQ(conditions, std::vector<xcs::Condition>({ xcs::Condition("0 0"), xcs::Condition("1 0") }));
+}
+
+TEST(XCS_PopulationTest, InsertOrIncrementNumerosity)
+{
+    const xcs::XCSParams params;
+    xcs::Population population(&params, { 0, 1 });
+    population.insertOrIncrementNumerosity(MakeClassifier("0 #", 0));
+    population.insertOrIncrementNumerosity(MakeClassifier("0 #", 1));
+    population.insertOrIncrementNumerosity(MakeClassifier("0 #", 0));
+    EXPECT_EQ(population.size(), 2);
+    EXPECT_EQ(population[0].numerosity, 2);
+    EXPECT_EQ(population[1].numerosity, 1);
+}
+
+TEST(XCS_PopulationTest, InsertByMove)
+{
+    const xcs::XCSParams params;
+    xcs::Population population(&params, { 0, 1 });
+    population.insert(MakeClassifier("0 0 1", 0));
+    population.insert(MakeClassifier("1 # 1", 1));
+    population.erase(0);
+
+    // The condition moves into the released slot
+    xcs::Classifier cl = MakeClassifier("# 0 1", 0);
+    EXPECT_EQ(population.insert(std::move(cl)), 0);
+    EXPECT_EQ(population[0].condition, xcs::Condition("# 0 1"));
+    EXPECT_EQ(population.find(MakeClassifier("# 0 1", 0)), 0);
+
+    // An identical classifier only increments the numerosity and keeps its condition
+    xcs::Classifier duplicate = MakeClassifier("# 0 1", 0);
+    population.insertOrIncrementNumerosity(std::move(duplicate));
+    EXPECT_EQ(population.size(), 2);
+    EXPECT_EQ(population[0].numerosity, 2);
+    EXPECT_EQ(duplicate.condition, xcs::Condition("# 0 1"));
+
+    EXPECT_EQ(MatchedIndices(population, { 1, 0, 1 }), std::vector<std::size_t>({ 0, 1 }));
+}
+
+TEST(XCS_PopulationTest, DeleteExtraClassifiers)
+{
+    xcs::XCSParams params;
+    params.n = 5;
+    xcs::Population population(&params, { 0, 1 });
+    for (int i = 0; i < 8; ++i)
+    {
+        population.insert(MakeClassifier((i % 2 == 0) ? "0 #" : "1 #", i % 2));
+    }
+
+    Random random(1);
+    while (population.deleteExtraClassifiers(random)) {}
+
+    std::uint64_t numerositySum = 0;
+    for (const auto & cl : population)
+    {
+        numerositySum += cl.numerosity;
+    }
+    EXPECT_EQ(numerositySum, 5);
+    EXPECT_EQ(population.size(), 5);
+}
+
+TEST(XCS_PopulationTest, CSV)
+{
+    const xcs::XCSParams params;
+    xcs::Population population({ MakeClassifier("0 #", 0), MakeClassifier("1 1", 1) }, &params, { 0, 1 });
+    population[1].numerosity = 3;
+
+    std::stringstream ss;
+    population.outputCSV(ss);
+
+    xcs::Population loadedPopulation(&params, { 0, 1 });
+    loadedPopulation.inputCSV(ss);
+    ASSERT_EQ(loadedPopulation.size(), 2);
+    EXPECT_EQ(loadedPopulation[1].condition, xcs::Condition("1 1"));
+    EXPECT_EQ(loadedPopulation[1].numerosity, 3);
+    EXPECT_EQ(MatchedIndices(loadedPopulation, { 1, 1 }), std::vector<std::size_t>({ 1 }));
+}
+
+TEST(XCS_PopulationTest, RemoveStaleHandles)
+{
+    const xcs::XCSParams params;
+    xcs::Population population({ MakeClassifier("0 #", 0), MakeClassifier("# #", 0), MakeClassifier("# 0", 0) }, &params, { 0, 1 });
+
+    xcs::ActionSet actionSet(&params, { 0, 1 });
+    for (std::size_t i = 0; i < population.slotCount(); ++i)
+    {
+        actionSet.insert(population.handle(i));
+    }
+
+    // Remove a member and reuse its slot for another classifier
+    population.erase(1);
+    population.insert(MakeClassifier("1 1", 0));
+    actionSet.removeStaleHandles(population);
+    EXPECT_EQ(actionSet.size(), 2);
+    EXPECT_EQ(actionSet.count(population.handle(1)), 0);
+}
+
+TEST(XCS_PopulationTest, InvertedIndexMatchingMethod)
+{
+    const xcs::XCSParams bitSlicedParams;
+    xcs::XCSParams invertedIndexParams;
+    invertedIndexParams.matchingMethod = xcs::XCSParams::MatchingMethod::kInvertedIndex;
+    xcs::Population bitSlicedPopulation(&bitSlicedParams, { 0, 1 });
+    xcs::Population invertedIndexPopulation(&invertedIndexParams, { 0, 1 });
+
+    // Apply the same operations to both populations
+    const auto insert = [&](const std::string & condition, int action) {
+        bitSlicedPopulation.insertOrIncrementNumerosity(MakeClassifier(condition, action));
+        invertedIndexPopulation.insertOrIncrementNumerosity(MakeClassifier(condition, action));
+    };
+    insert("0 1 #", 0);
+    insert("# 1 #", 1);
+    insert("1 # 2", 0);
+    insert("# # #", 1);
+    insert("0 1 #", 0);
+    bitSlicedPopulation.erase(1);
+    invertedIndexPopulation.erase(1);
+    insert("# 1 1", 0);
+
+    for (const auto & situation : std::vector<std::vector<int>>{ { 0, 1, 1 }, { 1, 0, 2 }, { 0, 1, 0 }, { 1, 1, 1 } })
+    {
+        EXPECT_EQ(MatchedIndices(invertedIndexPopulation, situation), MatchedIndices(bitSlicedPopulation, situation));
+    }
+    EXPECT_EQ(MatchedIndices(invertedIndexPopulation, { 1, 0, 2 }), std::vector<std::size_t>({ 2, 3 }));
+}
+
+TEST(XCS_PopulationTest, FindDuplicate)
+{
+    const xcs::XCSParams params;
+    xcs::Population population(&params, { 0, 1 });
+    population.insert(MakeClassifier("0 #", 0));
+    population.insert(MakeClassifier("0 #", 1));
+    population.insert(MakeClassifier("1 2", 1));
+    EXPECT_EQ(population.find(MakeClassifier("0 #", 1)), 1);
+    EXPECT_EQ(population.find(MakeClassifier("1 2", 1)), 2);
+    EXPECT_EQ(population.find(MakeClassifier("1 #", 1)), population.slotCount());
+
+    // Released slots are not found
+    population.erase(1);
+    EXPECT_EQ(population.find(MakeClassifier("0 #", 1)), population.slotCount());
+    population.insertOrIncrementNumerosity(MakeClassifier("0 #", 1));
+    EXPECT_EQ(population.find(MakeClassifier("0 #", 1)), 1);
+    population.insertOrIncrementNumerosity(MakeClassifier("1 2", 1));
+    EXPECT_EQ(population[2].numerosity, 2);
+}
+
+TEST(XCS_PopulationTest, MergeDuplicatesOnLoad)
+{
+    const xcs::XCSParams params;
+    std::stringstream ss;
+    ss << "Condition,Action,prediction,epsilon,F,exp,ts,as,n,acc\n"
+       << "0 #,0,10,0,0.01,0,0,1,2,1\n"
+       << "1 1,1,10,0,0.01,0,0,1,1,1\n"
+       << "0 #,0,10,0,0.01,0,0,1,3,1\n";
+
+    xcs::Population population(&params, { 0, 1 });
+    population.inputCSV(ss);
+    ASSERT_EQ(population.size(), 2);
+    EXPECT_EQ(population[0].condition, xcs::Condition("0 #"));
+    EXPECT_EQ(population[0].numerosity, 5);
+    EXPECT_EQ(population[1].numerosity, 1);
+}
+
+TEST(XCS_PopulationTest, CollectSubsumers)
+{
+    xcs::XCSParams params;
+    params.thetaSub = 20;
+    params.epsilonZero = 10.0;
+    xcs::Population population(&params, { 0, 1 });
+    population.insert(MakeClassifier("# # 1", 0));
+    population.insert(MakeClassifier("# # #", 0));
+    population.insert(MakeClassifier("0 # #", 1));
+    population.insert(MakeClassifier("0 # #", 0));
+    population.insert(MakeClassifier("0 1 1", 0));
+
+    // Inexperienced classifiers cannot subsume
+    std::vector<std::size_t> subsumerIndices;
+    population.collectSubsumers(MakeClassifier("0 1 1", 0), subsumerIndices);
+    EXPECT_TRUE(subsumerIndices.empty());
+
+    for (std::size_t i = 0; i < population.slotCount(); ++i)
+    {
+        population[i].experience = 30;
+    }
+    population.collectSubsumers(MakeClassifier("0 1 1", 0), subsumerIndices);
+    EXPECT_EQ(subsumerIndices, std::vector<std::size_t>({ 0, 1, 3 }));
+    population.collectSubsumers(MakeClassifier("0 # #", 0), subsumerIndices);
+    EXPECT_EQ(subsumerIndices, std::vector<std::size_t>({ 1 }));
+    EXPECT_TRUE(population.mayBeMoreGeneral(1, 3));
+    EXPECT_FALSE(population.mayBeMoreGeneral(3, 1));
+
+    // Inaccurate classifiers cannot subsume
+    population[1].epsilon = 20.0;
+    population.collectSubsumers(MakeClassifier("0 1 1", 0), subsumerIndices);
+    EXPECT_EQ(subsumerIndices, std::vector<std::size_t>({ 0, 3 }));
+
+    // Reused slots
+    population.erase(0);
+    population.insert(MakeClassifier("# 1 #", 0));
+    population.collectSubsumers(MakeClassifier("0 1 1", 0), subsumerIndices);
+    EXPECT_EQ(subsumerIndices, std::vector<std::size_t>({ 3 }));
+    population[0].experience = 30;
+    population.collectSubsumers(MakeClassifier("0 1 1", 0), subsumerIndices);
+    EXPECT_EQ(subsumerIndices, std::vector<std::size_t>({ 0, 3 }));
+
+    // Parameters changed
+    params.thetaSub = 50;
+    population.collectSubsumers(MakeClassifier("0 1 1", 0), subsumerIndices);
+    EXPECT_TRUE(subsumerIndices.empty());
+}
+
+TEST(XCS_PopulationTest, ChunkedSlots)
+{
+    xcs::XCSParams params;
+    params.populationChunkSize = 100;
+    params.useHugePages = true;
+    xcs::Population population(&params, { 0, 1 });
+    population.insert(MakeClassifier("0 #", 0));
+    EXPECT_EQ(population.slotCapacity(), 100);
+
+    // Large enough to be backed by huge pages
+    for (int i = 1; i < 30000; ++i)
+    {
+        population.insert(MakeClassifier((i % 2 == 0) ? "0 #" : "1 #", i % 2));
+    }
+    EXPECT_EQ(population.slotCapacity(), 30000);
+    EXPECT_EQ(population.size(), 30000);
+    EXPECT_EQ(population[29999].condition, xcs::Condition("1 #"));
+    EXPECT_EQ(MatchedIndices(population, { 1, 1 }).size(), 15000);
+}
+
+TEST(XCS_PopulationTest, PartitionByAction)
+{
+    const xcs::XCSParams params;
+    xcs::Population population(&params, { 2, 0, 1 });
+    population.insert(MakeClassifier("0 #", 2));
+    population.insert(MakeClassifier("# #", 0));
+    population.insert(MakeClassifier("0 0", 2));
+    population.insert(MakeClassifier("# 0", 5)); // not available
+    population.insert(MakeClassifier("0 1", 0));
+    population.insert(MakeClassifier("0 0", 0));
+
+    std::vector<std::size_t> indices = MatchedIndices(population, { 0, 0 });
+    EXPECT_EQ(indices, std::vector<std::size_t>({ 0, 1, 2, 3, 5 }));
+
+    std::vector<std::size_t> partitionBegins;
+    std::vector<std::size_t> buffer;
+    population.partitionByAction(indices, partitionBegins, buffer);
+    EXPECT_EQ(indices, std::vector<std::size_t>({ 1, 5, 0, 2, 3 }));
+    EXPECT_EQ(partitionBegins, std::vector<std::size_t>({ 0, 2, 2, 4, 5 }));
+}
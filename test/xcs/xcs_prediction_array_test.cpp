@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include "xcs_test_helper.hpp"
+
+using namespace xcspp;
+
+TEST(XCS_PredictionArrayTest, ActionOrdinals)
+{
+    // Narrow range (looked up in the table)
+    const ActionOrdinals narrow({ 3, 1, 2, 0 });
+    EXPECT_EQ(narrow.actions(), std::vector<int>({ 0, 1, 2, 3 }));
+    EXPECT_EQ(narrow.ordinalOf(2), 2);
+    EXPECT_EQ(narrow.ordinalOf(4), 4);
+    EXPECT_EQ(narrow.ordinalOf(-1), 4);
+
+    // Wide range (looked up by binary search)
+    const ActionOrdinals wide({ 100000, -5, 7 });
+    EXPECT_EQ(wide.actions(), std::vector<int>({ -5, 7, 100000 }));
+    EXPECT_EQ(wide.ordinalOf(100000), 2);
+    EXPECT_EQ(wide.ordinalOf(-5), 0);
+    EXPECT_EQ(wide.ordinalOf(8), 3);
+    EXPECT_EQ(wide.action(1), 7);
+}
+
+TEST(XCS_PredictionArrayTest, Generate)
+{
+    const xcs::XCSParams params;
+    const std::unordered_set<int> availableActions = { -5, 7, 100000 };
+    xcs::Population population({
+        MakeClassifier("# #", 100000, 300.0, 0.5),
+        MakeClassifier("# #", -5, 100.0, 0.1),
+        MakeClassifier("# 1", -5, 400.0, 0.3),
+        MakeClassifier("0 #", 7, 300.0, 0.2),
+        MakeClassifier("1 #", 7, 900.0, 0.2),
+        MakeClassifier("# 0", 100000, 900.0, 0.5),
+    }, &params, availableActions);
+
+    Random random;
+    const xcs::MatchSet matchSet(population, { 0, 1 }, 0, &params, availableActions, random);
+    EXPECT_FALSE(matchSet.isCoveringPerformed());
+
+    xcs::PredictionArray predictionArray(availableActions, &params);
+    predictionArray.generate(matchSet, population);
+    EXPECT_DOUBLE_EQ(predictionArray.predictionFor(-5), (100.0 * 0.1 + 400.0 * 0.3) / 0.4);
+    EXPECT_DOUBLE_EQ(predictionArray.predictionFor(7), 300.0);
+    EXPECT_DOUBLE_EQ(predictionArray.predictionFor(100000), 300.0);
+    EXPECT_DOUBLE_EQ(predictionArray.predictionFor(8), 0.0);
+    EXPECT_DOUBLE_EQ(predictionArray.max(), 325.0);
+    EXPECT_EQ(predictionArray.predictions().size(), 3);
+    EXPECT_EQ(predictionArray.selectAction(0.0, random), -5);
+
+    // The arrays are reused for another match set
+    const xcs::MatchSet otherMatchSet(population, { 1, 0 }, 0, &params, availableActions, random);
+    predictionArray.generate(otherMatchSet, population);
+    EXPECT_DOUBLE_EQ(predictionArray.predictionFor(-5), 100.0);
+    EXPECT_DOUBLE_EQ(predictionArray.predictionFor(7), 900.0);
+    EXPECT_DOUBLE_EQ(predictionArray.predictionFor(100000), 600.0);
+    EXPECT_EQ(predictionArray.selectAction(0.0, random), 7);
+}
+
+TEST(XCS_PredictionArrayTest, Ties)
+{
+    const xcs::XCSParams params;
+    const std::unordered_set<int> availableActions = { 0, 1, 2 };
+    xcs::Population population({
+        MakeClassifier("#", 2, 500.0, 0.1),
+        MakeClassifier("#", 0, 200.0, 0.1),
+        MakeClassifier("#", 1, 500.0, 0.1),
+    }, &params, availableActions);
+
+    Random random;
+    const xcs::PredictionArray predictionArray(xcs::MatchSet(population, { 0 }, 0, &params, availableActions, random), population, &params);
+    EXPECT_DOUBLE_EQ(predictionArray.max(), 500.0);
+
+    std::unordered_set<int> selectedActions;
+    for (int i = 0; i < 100; ++i)
+    {
+        selectedActions.insert(predictionArray.selectAction(0.0, random));
+    }
+    EXPECT_EQ(selectedActions, std::unordered_set<int>({ 1, 2 }));
+}
+
+TEST(XCS_PredictionArrayTest, PartitionedMatchSet)
+{
+    xcs::XCSParams params;
+    const std::unordered_set<int> availableActions = { 0, 1, 2, 3 };
+    const std::vector<xcs::Classifier> classifiers = {
+        MakeClassifier("# 1", 3, 100.0, 0.1),
+        MakeClassifier("# #", 1, 200.0, 0.2),
+        MakeClassifier("0 #", 3, 300.0, 0.3),
+        MakeClassifier("# #", 2, 400.0, 0.4),
+        MakeClassifier("0 1", 1, 500.0, 0.5),
+        MakeClassifier("1 1", 0, 600.0, 0.6),
+        MakeClassifier("0 #", 0, 700.0, 0.7),
+    };
+
+    Random random;
+    xcs::Population population(classifiers, &params, availableActions);
+    const xcs::MatchSet matchSet(population, { 0, 1 }, 0, &params, availableActions, random);
+    EXPECT_FALSE(matchSet.isPartitioned());
+
+    params.partitionByAction = true;
+    xcs::Population partitionedPopulation(classifiers, &params, availableActions);
+    const xcs::MatchSet partitionedMatchSet(partitionedPopulation, { 0, 1 }, 0, &params, availableActions, random);
+    ASSERT_TRUE(partitionedMatchSet.isPartitioned());
+    EXPECT_EQ(partitionedMatchSet.size(), matchSet.size());
+    EXPECT_EQ(std::distance(partitionedMatchSet.partitionBegin(3), partitionedMatchSet.partitionEnd(3)), 2);
+
+    // The results do not depend on the partitions
+    const xcs::PredictionArray predictionArray(matchSet, population, &params);
+    const xcs::PredictionArray partitionedPredictionArray(partitionedMatchSet, partitionedPopulation, &params);
+    EXPECT_EQ(partitionedPredictionArray.predictions(), predictionArray.predictions());
+    for (const auto & action : availableActions)
+    {
+        const xcs::ActionSet actionSet(matchSet, action, population, &params, availableActions);
+        const xcs::ActionSet partitionedActionSet(partitionedMatchSet, action, partitionedPopulation, &params, availableActions);
+        ASSERT_EQ(partitionedActionSet.size(), actionSet.size());
+        EXPECT_TRUE(std::equal(actionSet.begin(), actionSet.end(), partitionedActionSet.begin()));
+    }
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+using namespace xcspp;
+
+TEST(RandomTest, SplitMix64)
+{
+    // Reference output for the seed 1234567
+    std::uint64_t state = 1234567;
+    for (const std::uint64_t expected : { 6457827717110365317ULL, 3203168211198807973ULL, 9817491932198370423ULL, 4593380528125082431ULL, 16408922859458223821ULL })
+    {
+        EXPECT_EQ(RandomEngineDetail::SplitMix64(state), expected);
+    }
+}
+
+TEST(RandomTest, Xoshiro256PlusPlus)
+{
+    // Reference output for the state { 1, 2, 3, 4 }
+    Xoshiro256PlusPlus engine({ 1, 2, 3, 4 });
+    for (const std::uint64_t expected : {
+        41943041ULL, 58720359ULL, 3588806011781223ULL, 3591011842654386ULL, 9228616714210784205ULL,
+        9973669472204895162ULL, 14011001112246962877ULL, 12406186145184390807ULL, 15849039046786891736ULL, 10450023813501588000ULL })
+    {
+        EXPECT_EQ(engine(), expected);
+    }
+}
+
+TEST(RandomTest, PCG64)
+{
+    // Reference output for the initial state 42 and the sequence 54
+    PCG64 engine(0, 42, 0, 54);
+    for (const std::uint64_t expected : {
+        0x86b1da1d72062b68ULL, 0x1304aa46c9853d39ULL, 0xa3670e9e0dd50358ULL,
+        0xf9090e529a7dae00ULL, 0xc85b9fd837996f2cULL, 0x606121f8e3919196ULL })
+    {
+        EXPECT_EQ(engine(), expected);
+    }
+}
+
+TEST(RandomTest, Engines)
+{
+    for (const auto engineType : { RandomEngineType::kMT19937, RandomEngineType::kXoshiro256PlusPlus, RandomEngineType::kPCG64 })
+    {
+        // The same seed gives the same sequence
+        Random random1(7, engineType);
+        Random random2(7, engineType);
+        Random random3(std::optional<std::uint64_t>(7), engineType);
+        for (int i = 0; i < 1000; ++i)
+        {
+            const std::uint64_t bits = random1.nextBits();
+            EXPECT_EQ(bits, random2.nextBits());
+            EXPECT_EQ(bits, random3.nextBits());
+        }
+
+        // The values are in the range and uniformly distributed
+        constexpr int kTrialCount = 60000;
+        std::vector<int> counts(6, 0);
+        for (int i = 0; i < kTrialCount; ++i)
+        {
+            const int value = random1.nextInt(-2, 3);
+            ASSERT_GE(value, -2);
+            ASSERT_LE(value, 3);
+            ++counts[value + 2];
+
+            const double realValue = random1.nextDouble(0.5, 1.5);
+            ASSERT_GE(realValue, 0.5);
+            ASSERT_LT(realValue, 1.5);
+        }
+        for (const int count : counts)
+        {
+            EXPECT_NEAR(count, kTrialCount / 6, 5.0 * std::sqrt(kTrialCount / 6.0));
+        }
+
+        const std::unordered_set<int> actions = { 3, 5, 8 };
+        for (int i = 0; i < 100; ++i)
+        {
+            EXPECT_EQ(actions.count(random1.chooseFrom(actions)), 1u);
+        }
+    }
+
+    // The engines give different sequences for the same seed
+    Random mt19937(7, RandomEngineType::kMT19937);
+    Random xoshiro256PlusPlus(7, RandomEngineType::kXoshiro256PlusPlus);
+    Random pcg64(7, RandomEngineType::kPCG64);
+    const std::uint64_t bits = mt19937.nextBits();
+    EXPECT_NE(bits, xoshiro256PlusPlus.nextBits());
+    EXPECT_NE(bits, pcg64.nextBits());
+}
+
+TEST(RandomTest, SeededEnvironments)
+{
+    // The environments constructed with the same seed give the same situations
+    MultiplexerEnvironment env1(11, 0, 3);
+    MultiplexerEnvironment env2(11, 0, 3);
+    RealMultiplexerEnvironment realEnv1(6, 0, 0.5, 3);
+    RealMultiplexerEnvironment realEnv2(6, 0, 0.5, 3);
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(env1.situation(), env2.situation());
+        EXPECT_EQ(realEnv1.situation(), realEnv2.situation());
+        env1.executeAction(0);
+        env2.executeAction(0);
+        realEnv1.executeAction(0);
+        realEnv2.executeAction(0);
+    }
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace xcspp;
+
+namespace
+{
+    // Tournament selection drawing for each micro-classifier
+    std::size_t TournamentSelectionReference(const std::vector<std::pair<double, std::uint64_t>> & fitnesses, double tau, Random & random)
+    {
+        double best = 0.0;
+        std::size_t selectedIdx = fitnesses.size();
+        for (std::size_t i = 0; i < fitnesses.size(); ++i)
+        {
+            const auto & [weight, numerosity] = fitnesses[i];
+            if (best < weight / numerosity)
+            {
+                for (std::uint64_t j = 0; j < numerosity; ++j)
+                {
+                    if (random.nextDouble() < tau)
+                    {
+                        best = weight / numerosity;
+                        selectedIdx = i;
+                        break;
+                    }
+                }
+            }
+        }
+        return (selectedIdx == fitnesses.size()) ? random.nextInt<std::size_t>(0, fitnesses.size() - 1) : selectedIdx;
+    }
+}
+
+TEST(SelectionTest, RouletteWheel)
+{
+    const std::vector<double> weights = { 0.5, 0.0, 2.0, 1.0, 0.25 };
+
+    RouletteWheel<double> rouletteWheel;
+    for (const double weight : weights)
+    {
+        rouletteWheel.push_back(weight);
+    }
+    EXPECT_EQ(rouletteWheel.size(), weights.size());
+    EXPECT_DOUBLE_EQ(rouletteWheel.sum(), 3.75);
+
+    // The same item is selected as rouletteWheelSelection() for the same random numbers
+    Random random1(1);
+    Random random2(1);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const std::size_t selectedIdx = rouletteWheel.spin(random1);
+        EXPECT_EQ(selectedIdx, random2.rouletteWheelSelection(weights));
+        EXPECT_NE(selectedIdx, 1u);
+    }
+
+    rouletteWheel.clear();
+    EXPECT_TRUE(rouletteWheel.empty());
+    EXPECT_THROW(rouletteWheel.spin(random1), std::runtime_error);
+}
+
+TEST(SelectionTest, TournamentSelectionDistribution)
+{
+    const std::vector<std::pair<double, std::uint64_t>> fitnesses = {
+        { 0.9, 3 }, { 0.2, 1 }, { 2.0, 5 }, { 0.05, 1 }, { 0.6, 2 }, { 0.3, 1 },
+    };
+    constexpr int kTrialCount = 200000;
+
+    for (const double tau : { 0.1, 0.4, 1.0 })
+    {
+        Random random1(2);
+        Random random2(3);
+        std::vector<int> counts(fitnesses.size(), 0);
+        std::vector<int> referenceCounts(fitnesses.size(), 0);
+        for (int i = 0; i < kTrialCount; ++i)
+        {
+            ++counts[random1.tournamentSelectionMicroClassifier(fitnesses, tau)];
+            ++referenceCounts[TournamentSelectionReference(fitnesses, tau, random2)];
+        }
+
+        // The frequencies agree within a few standard deviations
+        for (std::size_t i = 0; i < fitnesses.size(); ++i)
+        {
+            const double p = static_cast<double>(referenceCounts[i]) / kTrialCount;
+            const double tolerance = 5.0 * std::sqrt(2.0 * p * (1.0 - p) / kTrialCount) + 1e-4;
+            EXPECT_NEAR(static_cast<double>(counts[i]) / kTrialCount, p, tolerance) << "tau = " << tau << ", i = " << i;
+        }
+    }
+
+    // With tau = 1, the classifier with the highest fitness per micro-classifier always wins
+    Random random(4);
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(random.tournamentSelectionMicroClassifier(fitnesses, 1.0), 2u);
+    }
+}
+
+TEST(SelectionTest, BernoulliSuccesses)
+{
+    Random random(5);
+
+    // Each trial succeeds with the probability independently of the others
+    constexpr std::size_t kTrialCount = 40;
+    constexpr int kRepeatCount = 100000;
+    for (const double probability : { 0.04, 0.5 })
+    {
+        std::vector<int> counts(kTrialCount, 0);
+        int adjacentPairCount = 0;
+        for (int i = 0; i < kRepeatCount; ++i)
+        {
+            std::size_t prevIdx = kTrialCount;
+            random.forEachBernoulliSuccess(kTrialCount, probability, [&](std::size_t idx) {
+                ASSERT_LT(idx, kTrialCount);
+                ASSERT_TRUE(prevIdx == kTrialCount || prevIdx < idx);
+                if (prevIdx + 1 == idx && idx == 1)
+                {
+                    ++adjacentPairCount;
+                }
+                prevIdx = idx;
+                ++counts[idx];
+            });
+        }
+
+        const double tolerance = 5.0 * std::sqrt(probability * (1.0 - probability) / kRepeatCount);
+        for (std::size_t idx = 0; idx < kTrialCount; ++idx)
+        {
+            EXPECT_NEAR(static_cast<double>(counts[idx]) / kRepeatCount, probability, tolerance) << "idx = " << idx;
+        }
+        EXPECT_NEAR(static_cast<double>(adjacentPairCount) / kRepeatCount, probability * probability, tolerance);
+    }
+
+    // No trial succeeds with the probability 0, and all trials succeed with the probability 1
+    std::size_t successCount = 0;
+    random.forEachBernoulliSuccess(kTrialCount, 0.0, [&](std::size_t) { ++successCount; });
+    EXPECT_EQ(successCount, 0u);
+    random.forEachBernoulliSuccess(kTrialCount, 1.0, [&](std::size_t) { ++successCount; });
+    EXPECT_EQ(successCount, kTrialCount);
+}
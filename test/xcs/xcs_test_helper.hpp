@@ -0,0 +1,37 @@
+#pragma once
+#include <random>
+#include <string>
+#include <vector>
+#include <xcspp/xcspp.hpp>
+
+// Helpers shared by the XCS tests
+
+// Classifier with the given condition and action (the other parameters are the initial values used in the tests)
+inline xcspp::xcs::Classifier MakeClassifier(const std::string & condition, int action, double prediction = 10.0, double fitness = 0.01)
+{
+    return xcspp::xcs::Classifier(condition, action, prediction, 0.0, fitness, 0);
+}
+
+// Returns a condition with don't care symbols at random positions and random values (0 or 1) elsewhere
+inline xcspp::xcs::Condition RandomCondition(std::size_t length, double dontCareProbability, std::mt19937 & engine)
+{
+    std::bernoulli_distribution dontCareDist(dontCareProbability);
+    std::uniform_int_distribution<int> valueDist(0, 1);
+    std::vector<xcspp::xcs::Symbol> symbols;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        symbols.push_back(dontCareDist(engine) ? xcspp::xcs::Symbol() : xcspp::xcs::Symbol(valueDist(engine)));
+    }
+    return xcspp::xcs::Condition(symbols);
+}
+
+inline std::vector<int> RandomSituation(std::size_t length, std::mt19937 & engine)
+{
+    std::uniform_int_distribution<int> dist(0, 1);
+    std::vector<int> situation;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        situation.push_back(dist(engine));
+    }
+    return situation;
+}
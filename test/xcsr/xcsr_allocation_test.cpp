@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include <cstdlib> // std::malloc, std::free
+#include <new> // std::bad_alloc
+
+using namespace xcspp;
+
+namespace
+{
+    // The number of calls of operator new while g_isCounting is true
+    std::size_t g_allocationCount = 0;
+    bool g_isCounting = false;
+
+    // Run explore() and reward() and returns the number of allocations in them
+    // (The allocations in the environment are not counted.)
+    std::size_t CountAllocationsInSteps(xcsr::XCSR & xcsr, IRealEnvironment & environment, int stepCount)
+    {
+        std::size_t allocationCount = 0;
+        for (int i = 0; i < stepCount; ++i)
+        {
+            const auto situation = environment.situation();
+
+            g_allocationCount = 0;
+            g_isCounting = true;
+            const int action = xcsr.explore(situation);
+            g_isCounting = false;
+            allocationCount += g_allocationCount;
+
+            const double reward = environment.executeAction(action);
+
+            g_allocationCount = 0;
+            g_isCounting = true;
+            xcsr.reward(reward, environment.isEndOfProblem());
+            g_isCounting = false;
+            allocationCount += g_allocationCount;
+        }
+        return allocationCount;
+    }
+}
+
+void *operator new(std::size_t size)
+{
+    if (g_isCounting)
+    {
+        ++g_allocationCount;
+    }
+
+    if (void *p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+TEST(XCSR_AllocationTest, NoAllocationInSteadyState)
+{
+    RealMultiplexerEnvironment environment(6, 0, 0.5, 1);
+
+    xcsr::XCSRParams params;
+    params.n = 400;
+    params.preallocate = true;
+    params.seed = 1;
+    xcsr::XCSR xcsr(environment.availableActions(), params);
+
+    // Warm up (the buffers of the prediction array and the logging values are made here)
+    CountAllocationsInSteps(xcsr, environment, 5000);
+
+    // The steps include covering, GA, subsumption and deletion, but none of them allocates memory
+    EXPECT_EQ(CountAllocationsInSteps(xcsr, environment, 20000), 0);
+}
+
+TEST(XCSR_AllocationTest, NoAllocationWithManyActions)
+{
+    // 16 actions (the 4 address bits of each situation), so that covering inserts up to 16 classifiers
+    // into the full [P] before the deletions
+    RealDataset dataset;
+    for (int i = 0; i < 256; ++i)
+    {
+        std::vector<double> situation;
+        for (int bit = 7; bit >= 0; --bit)
+        {
+            situation.push_back(static_cast<double>((i >> bit) & 1));
+        }
+        dataset.situations.push_back(situation);
+        dataset.actions.push_back(i >> 4);
+    }
+    RealDatasetEnvironment environment(dataset, true, 1);
+
+    xcsr::XCSRParams params;
+    params.n = 20;
+    params.thetaGA = 1000000; // No GA (its buffers are made at its first run)
+    params.preallocate = true;
+    params.seed = 1;
+    xcsr::XCSR xcsr(environment.availableActions(), params);
+
+    // Warm up with a single step (the first covering fills [P] with 16 classifiers)
+    CountAllocationsInSteps(xcsr, environment, 1);
+
+    // Each following step with a new situation holds up to N + 16 classifiers before the deletions
+    EXPECT_EQ(CountAllocationsInSteps(xcsr, environment, 2000), 0);
+}
@@ -1,8 +1,38 @@
 #include <gtest/gtest.h>
 #include <xcspp/xcspp.hpp>
+#include <cmath> // std::nextafter
+#include <limits>
+#include <vector>
 
 using namespace xcspp;
 
+namespace
+{
+    // Symbols and their bounds [lower, upper) calculated by hand
+    struct BoundsCase
+    {
+        XCSRRepr repr;
+        std::vector<xcsr::Symbol> symbols;
+        std::vector<double> lowerBounds;
+        std::vector<double> upperBounds;
+    };
+
+    const std::vector<BoundsCase> & BoundsCases()
+    {
+        static const std::vector<BoundsCase> cases = {
+            // CSR (center, spread)
+            { XCSRRepr::kCSR, { { 0.5, 0.25 }, { 0.375, 0.125 }, { 0.75, 0.5 } }, { 0.25, 0.25, 0.25 }, { 0.75, 0.5, 1.25 } },
+
+            // OBR (lower, upper)
+            { XCSRRepr::kOBR, { { 0.25, 0.5 }, { 0.0, 1.0 }, { -0.5, 0.125 } }, { 0.25, 0.0, -0.5 }, { 0.5, 1.0, 0.125 } },
+
+            // UBR (unordered bounds, including v1 > v2)
+            { XCSRRepr::kUBR, { { 0.75, 0.25 }, { 0.125, 0.625 }, { 1.0, 0.0 } }, { 0.25, 0.125, 0.0 }, { 0.75, 0.625, 1.0 } },
+        };
+        return cases;
+    }
+}
+
 TEST(XCSR_ConditionTest, Comparison)
 {
     const xcsr::Symbol zero(0.25, 0.25);
@@ -209,3 +239,172 @@ TEST(XCSR_ConditionTest, IsMoreGeneral_UBR)
     EXPECT_FALSE(cond2.isMoreGeneral(allDontCare, XCSRRepr::kUBR));
     EXPECT_FALSE(cond3.isMoreGeneral(allDontCare, XCSRRepr::kUBR));
 }
+
+TEST(XCSR_ConditionTest, Hash)
+{
+    const xcsr::Symbol zero(0.25, 0.25);
+    const xcsr::Symbol one(0.75, 0.25);
+    const xcsr::Symbol dontCare(0.5, 0.5);
+
+    xcsr::Condition cond1({ zero, one, dontCare });
+    const xcsr::Condition cond2({ zero, one, one });
+    EXPECT_NE(cond1.hash(), cond2.hash());
+
+    // The hash follows the modifications
+    cond1[2] = one;
+    EXPECT_EQ(cond1.hash(), cond2.hash());
+
+    // Zeros of both signs are equal
+    EXPECT_EQ(xcsr::Condition({ xcsr::Symbol(0.0, 0.5) }).hash(), xcsr::Condition({ xcsr::Symbol(-0.0, 0.5) }).hash());
+}
+
+TEST(XCSR_ConditionTest, Generality)
+{
+    const xcsr::Condition general({ xcsr::Symbol(0.5, 0.5), xcsr::Symbol(0.5, 0.25) });
+    const xcsr::Condition specific({ xcsr::Symbol(0.25, 0.25), xcsr::Symbol(0.5, 0.25) });
+    EXPECT_DOUBLE_EQ(general.generality(xcsr::XCSRRepr::kCSR), 1.5);
+    EXPECT_DOUBLE_EQ(specific.generality(xcsr::XCSRRepr::kCSR), 1.0);
+    EXPECT_TRUE(general.isMoreGeneral(specific, xcsr::XCSRRepr::kCSR));
+
+    // OBR (lower, upper) and UBR (unordered bounds)
+    EXPECT_DOUBLE_EQ(xcsr::Condition({ xcsr::Symbol(0.25, 0.75) }).generality(xcsr::XCSRRepr::kOBR), 0.5);
+    EXPECT_DOUBLE_EQ(xcsr::Condition({ xcsr::Symbol(0.75, 0.25) }).generality(xcsr::XCSRRepr::kUBR), 0.5);
+}
+
+TEST(XCSR_ConditionTest, BoundsOfRepresentations)
+{
+    for (const auto & c : BoundsCases())
+    {
+        for (std::size_t i = 0; i < c.symbols.size(); ++i)
+        {
+            EXPECT_EQ(xcsr::GetLowerBound(c.symbols[i], c.repr), c.lowerBounds[i]);
+            EXPECT_EQ(xcsr::GetUpperBound(c.symbols[i], c.repr), c.upperBounds[i]);
+
+            // The representation given at compile time
+            xcsr::VisitXCSRRepr(c.repr, [&](auto reprConstant) {
+                constexpr XCSRRepr kRepr = decltype(reprConstant)::value;
+                EXPECT_EQ(kRepr, c.repr);
+                EXPECT_EQ(xcsr::GetLowerBound<kRepr>(c.symbols[i]), c.lowerBounds[i]);
+                EXPECT_EQ(xcsr::GetUpperBound<kRepr>(c.symbols[i]), c.upperBounds[i]);
+            });
+        }
+    }
+}
+
+TEST(XCSR_ConditionTest, MatchesByBounds)
+{
+    constexpr double kInfinity = std::numeric_limits<double>::infinity();
+    for (const auto & c : BoundsCases())
+    {
+        const xcsr::Condition cond(c.symbols);
+        for (std::size_t i = 0; i < c.symbols.size(); ++i)
+        {
+            // The other values are at their lower bounds
+            std::vector<double> situation = c.lowerBounds;
+            EXPECT_TRUE(cond.matches(situation, c.repr));
+
+            situation[i] = std::nextafter(c.lowerBounds[i], -kInfinity);
+            EXPECT_FALSE(cond.matches(situation, c.repr));
+
+            situation[i] = std::nextafter(c.upperBounds[i], -kInfinity);
+            EXPECT_TRUE(cond.matches(situation, c.repr));
+
+            situation[i] = c.upperBounds[i];
+            EXPECT_FALSE(cond.matches(situation, c.repr));
+        }
+    }
+
+    // An empty interval matches nothing
+    EXPECT_FALSE(xcsr::Condition({ xcsr::Symbol(0.5, 0.0) }).matches({ 0.5 }, XCSRRepr::kCSR));
+    EXPECT_FALSE(xcsr::Condition({ xcsr::Symbol(0.5, 0.5) }).matches({ 0.5 }, XCSRRepr::kOBR));
+    EXPECT_FALSE(xcsr::Condition({ xcsr::Symbol(0.5, 0.5) }).matches({ 0.5 }, XCSRRepr::kUBR));
+}
+
+TEST(XCSR_ConditionTest, GeneralityByBounds)
+{
+    for (const auto & c : BoundsCases())
+    {
+        double expected = 0.0;
+        for (std::size_t i = 0; i < c.symbols.size(); ++i)
+        {
+            expected += c.upperBounds[i] - c.lowerBounds[i];
+        }
+        EXPECT_DOUBLE_EQ(xcsr::Condition(c.symbols).generality(c.repr), expected);
+    }
+}
+
+TEST(XCSR_ConditionTest, IsMoreGeneralByBounds)
+{
+    // CSR: [0.25, 0.75) [0.0, 1.0) contains [0.25, 0.75) [0.25, 0.5), and neither of them contains [0.5, 1.0) [0.5, 0.75)
+    const xcsr::Condition csrGeneral({ { 0.5, 0.25 }, { 0.5, 0.5 } });
+    const xcsr::Condition csrSpecific({ { 0.5, 0.25 }, { 0.375, 0.125 } });
+    const xcsr::Condition csrOther({ { 0.75, 0.25 }, { 0.625, 0.125 } });
+    EXPECT_TRUE(csrGeneral.isMoreGeneral(csrSpecific, XCSRRepr::kCSR));
+    EXPECT_FALSE(csrSpecific.isMoreGeneral(csrGeneral, XCSRRepr::kCSR));
+    EXPECT_FALSE(csrGeneral.isMoreGeneral(csrOther, XCSRRepr::kCSR));
+    EXPECT_FALSE(csrSpecific.isMoreGeneral(csrOther, XCSRRepr::kCSR));
+    EXPECT_FALSE(csrOther.isMoreGeneral(csrSpecific, XCSRRepr::kCSR));
+
+    // OBR: the same intervals
+    const xcsr::Condition obrGeneral({ { 0.25, 0.75 }, { 0.0, 1.0 } });
+    const xcsr::Condition obrSpecific({ { 0.25, 0.75 }, { 0.25, 0.5 } });
+    const xcsr::Condition obrOther({ { 0.5, 1.0 }, { 0.5, 0.75 } });
+    EXPECT_TRUE(obrGeneral.isMoreGeneral(obrSpecific, XCSRRepr::kOBR));
+    EXPECT_FALSE(obrSpecific.isMoreGeneral(obrGeneral, XCSRRepr::kOBR));
+    EXPECT_FALSE(obrGeneral.isMoreGeneral(obrOther, XCSRRepr::kOBR));
+    EXPECT_FALSE(obrSpecific.isMoreGeneral(obrOther, XCSRRepr::kOBR));
+
+    // UBR: the same intervals with the bounds in either order
+    const xcsr::Condition ubrGeneral({ { 0.75, 0.25 }, { 1.0, 0.0 } });
+    const xcsr::Condition ubrSpecific({ { 0.25, 0.75 }, { 0.5, 0.25 } });
+    const xcsr::Condition ubrOther({ { 1.0, 0.5 }, { 0.5, 0.75 } });
+    EXPECT_TRUE(ubrGeneral.isMoreGeneral(ubrSpecific, XCSRRepr::kUBR));
+    EXPECT_FALSE(ubrSpecific.isMoreGeneral(ubrGeneral, XCSRRepr::kUBR));
+    EXPECT_FALSE(ubrGeneral.isMoreGeneral(ubrOther, XCSRRepr::kUBR));
+    EXPECT_FALSE(ubrSpecific.isMoreGeneral(ubrOther, XCSRRepr::kUBR));
+
+    // Equal bounds are not more general (even if the symbols differ)
+    const xcsr::Condition ubrSwapped({ { 0.25, 0.75 }, { 0.0, 1.0 } });
+    EXPECT_FALSE(ubrGeneral.isMoreGeneral(ubrSwapped, XCSRRepr::kUBR));
+    EXPECT_FALSE(ubrSwapped.isMoreGeneral(ubrGeneral, XCSRRepr::kUBR));
+    EXPECT_TRUE(ubrSwapped.isMoreGeneral(ubrSpecific, XCSRRepr::kUBR));
+    EXPECT_FALSE(csrGeneral.isMoreGeneral(csrGeneral, XCSRRepr::kCSR));
+    EXPECT_FALSE(obrGeneral.isMoreGeneral(xcsr::Condition({ { 0.25, 0.75 }, { 0.0, 1.0 } }), XCSRRepr::kOBR));
+
+    // A single dimension which is wider is enough
+    EXPECT_TRUE(xcsr::Condition({ { 0.25, 0.75 }, { 0.0, 1.0 } }).isMoreGeneral(xcsr::Condition({ { 0.25, 0.75 }, { 0.0, 0.875 } }), XCSRRepr::kOBR));
+}
+
+TEST(XCSR_ConditionTest, ClampSymbolValues)
+{
+    // CSR clamps the center into the range and the spread to non-negative values
+    EXPECT_EQ(xcsr::ClampSymbolValue1(1.5, XCSRRepr::kCSR, 0.0, 1.0, false), 1.0);
+    EXPECT_EQ(xcsr::ClampSymbolValue1(-0.5, XCSRRepr::kCSR, 0.0, 1.0, false), 0.0);
+    EXPECT_EQ(xcsr::ClampSymbolValue2(-0.25, XCSRRepr::kCSR, 0.0, 1.0, false), 0.0);
+    EXPECT_EQ(xcsr::ClampSymbolValue2(1.5, XCSRRepr::kCSR, 0.0, 1.0, false), 1.5);
+
+    // OBR and UBR clamp the bounds into the range only with the range restriction
+    for (const auto repr : { XCSRRepr::kOBR, XCSRRepr::kUBR })
+    {
+        EXPECT_EQ(xcsr::ClampSymbolValue1(1.5, repr, 0.0, 1.0, false), 1.5);
+        EXPECT_EQ(xcsr::ClampSymbolValue1(1.5, repr, 0.0, 1.0, true), 1.0);
+        EXPECT_EQ(xcsr::ClampSymbolValue2(-0.25, repr, 0.0, 1.0, false), -0.25);
+        EXPECT_EQ(xcsr::ClampSymbolValue2(-0.25, repr, 0.0, 1.0, true), 0.0);
+    }
+
+    // The representation given at compile time
+    for (const auto repr : { XCSRRepr::kCSR, XCSRRepr::kOBR, XCSRRepr::kUBR })
+    {
+        for (const double value : { -0.5, 0.25, 1.5 })
+        {
+            for (const bool doRangeRestriction : { false, true })
+            {
+                xcsr::VisitXCSRRepr(repr, [&](auto reprConstant) {
+                    constexpr XCSRRepr kRepr = decltype(reprConstant)::value;
+                    EXPECT_EQ(xcsr::ClampSymbolValue1<kRepr>(value, 0.0, 1.0, doRangeRestriction), xcsr::ClampSymbolValue1(value, repr, 0.0, 1.0, doRangeRestriction));
+                    EXPECT_EQ(xcsr::ClampSymbolValue2<kRepr>(value, 0.0, 1.0, doRangeRestriction), xcsr::ClampSymbolValue2(value, repr, 0.0, 1.0, doRangeRestriction));
+                });
+            }
+        }
+    }
+}
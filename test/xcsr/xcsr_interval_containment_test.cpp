@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include "xcsr_test_helper.hpp"
+#include <random>
+
+using namespace xcspp;
+
+namespace
+{
+    // Returns a condition whose intervals are those of the base condition, widened at some positions
+    xcsr::Condition RandomWidening(const xcsr::Condition & base, xcsr::XCSRRepr repr, std::mt19937 & engine)
+    {
+        std::uniform_real_distribution<double> dist(-0.02, 0.1);
+        std::bernoulli_distribution keepDist(0.8);
+        std::vector<xcsr::Symbol> symbols;
+        for (std::size_t i = 0; i < base.size(); ++i)
+        {
+            double lower = xcsr::GetLowerBound(base[i], repr);
+            double upper = xcsr::GetUpperBound(base[i], repr);
+            if (!keepDist(engine))
+            {
+                lower -= dist(engine);
+                upper += dist(engine);
+            }
+            switch (repr)
+            {
+            case xcsr::XCSRRepr::kCSR:
+                symbols.emplace_back((lower + upper) / 2, (upper - lower) / 2);
+                break;
+
+            case xcsr::XCSRRepr::kOBR:
+                symbols.emplace_back(lower, upper);
+                break;
+
+            case xcsr::XCSRRepr::kUBR:
+                symbols.push_back(keepDist(engine) ? xcsr::Symbol(lower, upper) : xcsr::Symbol(upper, lower));
+                break;
+            }
+        }
+        return xcsr::Condition(symbols);
+    }
+}
+
+TEST(XCSR_IntervalContainmentTest, SameAsCondition)
+{
+    std::mt19937 engine(1);
+    for (const auto repr : { xcsr::XCSRRepr::kCSR, xcsr::XCSRRepr::kOBR, xcsr::XCSRRepr::kUBR })
+    {
+        for (const std::size_t length : { 1, 3, 4, 8, 9, 17, 30 })
+        {
+            std::size_t moreGeneralCount = 0;
+            for (int t = 0; t < 300; ++t)
+            {
+                // Pairs of a condition and its widening (and the reverse, and equal conditions)
+                const auto base = RandomWidening(RandomCondition(length, repr, 0.0, engine), repr, engine);
+                const auto widened = RandomWidening(base, repr, engine);
+                for (const auto & [first, second] : { std::make_pair(&widened, &base), std::make_pair(&base, &widened), std::make_pair(&base, &base) })
+                {
+                    std::vector<double> lowerBounds(length), upperBounds(length), otherLowerBounds(length), otherUpperBounds(length);
+                    xcsr::GetConditionBounds(*first, repr, lowerBounds.data(), upperBounds.data());
+                    xcsr::GetConditionBounds(*second, repr, otherLowerBounds.data(), otherUpperBounds.data());
+
+                    const bool expected = first->isMoreGeneral(*second, repr);
+                    EXPECT_EQ(xcsr::IsMoreGeneral(lowerBounds.data(), upperBounds.data(), otherLowerBounds.data(), otherUpperBounds.data(), length), expected);
+                    const bool actual = xcsr::VisitXCSRRepr(repr, [&](auto reprConstant) {
+                        return xcsr::IsMoreGeneral<decltype(reprConstant)::value>(lowerBounds.data(), upperBounds.data(), *second);
+                    });
+                    EXPECT_EQ(actual, expected);
+                    moreGeneralCount += expected ? 1 : 0;
+                }
+            }
+            EXPECT_GT(moreGeneralCount, 0);
+        }
+    }
+}
+
+TEST(XCSR_IntervalContainmentTest, KeepMoreGeneralRows)
+{
+    const auto repr = xcsr::XCSRRepr::kOBR;
+    const std::vector<xcsr::Condition> conditions = {
+        xcsr::Condition(std::vector<xcsr::Symbol>({ { 0.0, 1.0 }, { 0.0, 1.0 } })), // More general
+        xcsr::Condition(std::vector<xcsr::Symbol>({ { 0.2, 0.6 }, { 0.3, 0.7 } })), // Equal
+        xcsr::Condition(std::vector<xcsr::Symbol>({ { 0.2, 0.6 }, { 0.3, 0.69 } })), // Not containing
+        xcsr::Condition(std::vector<xcsr::Symbol>({ { 0.1, 0.6 }, { 0.3, 0.7 } })), // More general
+    };
+    const std::size_t length = 2;
+    std::vector<double> lowerBounds(conditions.size() * length), upperBounds(conditions.size() * length);
+    for (std::size_t row = 0; row < conditions.size(); ++row)
+    {
+        xcsr::GetConditionBounds(conditions[row], repr, lowerBounds.data() + row * length, upperBounds.data() + row * length);
+    }
+
+    std::vector<std::size_t> rows = { 3, 2, 1, 0 };
+    xcsr::KeepMoreGeneralRows(lowerBounds.data(), upperBounds.data(), lowerBounds.data() + length, upperBounds.data() + length, length, rows);
+    EXPECT_EQ(rows, std::vector<std::size_t>({ 3, 0 }));
+}
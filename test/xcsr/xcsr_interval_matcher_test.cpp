@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include "xcsr_test_helper.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace xcspp;
+
+TEST(XCSR_IntervalMatcherTest, MatchesSameAsCondition)
+{
+    std::mt19937 engine(1);
+    for (const auto repr : { xcsr::XCSRRepr::kCSR, xcsr::XCSRRepr::kOBR, xcsr::XCSRRepr::kUBR })
+    {
+        for (const std::size_t length : { 1, 3, 8, 30 })
+        {
+            xcsr::IntervalMatcher matcher;
+            std::vector<xcsr::Condition> conditions;
+            for (std::size_t i = 0; i < 1003; ++i)
+            {
+                conditions.push_back(RandomCondition(length, repr, 0.9, engine));
+                matcher.insert(i, conditions.back(), repr);
+            }
+
+            std::vector<std::size_t> matchedColumns;
+            std::size_t matchedCount = 0;
+            for (int t = 0; t < 50; ++t)
+            {
+                const auto situation = RandomSituation(length, engine);
+                matcher.match(situation, matchedColumns);
+
+                std::vector<std::size_t> expected;
+                for (std::size_t i = 0; i < conditions.size(); ++i)
+                {
+                    if (conditions[i].matches(situation, repr))
+                    {
+                        expected.push_back(i);
+                    }
+                }
+                EXPECT_EQ(matchedColumns, expected);
+                matchedCount += expected.size();
+            }
+            EXPECT_GT(matchedCount, 0);
+        }
+    }
+}
+
+TEST(XCSR_IntervalMatcherTest, HalfOpenInterval)
+{
+    xcsr::IntervalMatcher matcher;
+    matcher.insert(0, xcsr::Condition(std::vector<xcsr::Symbol>({ { 0.5, 0.25 } })), xcsr::XCSRRepr::kCSR);
+    matcher.insert(1, xcsr::Condition(std::vector<xcsr::Symbol>({ { 0.75, 0.25 } })), xcsr::XCSRRepr::kCSR);
+
+    std::vector<std::size_t> matchedColumns;
+    matcher.match({ 0.25 }, matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 0 }));
+    matcher.match({ 0.5 }, matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 0, 1 }));
+    matcher.match({ 0.75 }, matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 1 }));
+    matcher.match({ 1.0 }, matchedColumns);
+    EXPECT_TRUE(matchedColumns.empty());
+}
+
+TEST(XCSR_IntervalMatcherTest, EraseAndReuseColumn)
+{
+    const auto repr = xcsr::XCSRRepr::kOBR;
+    xcsr::IntervalMatcher matcher;
+    matcher.insert(0, xcsr::Condition(std::vector<xcsr::Symbol>({ { 0.0, 0.5 }, { 0.0, 1.0 } })), repr);
+    matcher.insert(1, xcsr::Condition(std::vector<xcsr::Symbol>({ { 0.0, 1.0 }, { 0.5, 1.0 } })), repr);
+    matcher.insert(9, xcsr::Condition(std::vector<xcsr::Symbol>({ { 0.0, 1.0 }, { 0.0, 1.0 } })), repr);
+
+    std::vector<std::size_t> matchedColumns;
+    matcher.match({ 0.25, 0.75 }, matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 0, 1, 9 }));
+
+    matcher.erase(1);
+    EXPECT_EQ(matcher.size(), 2);
+    matcher.match({ 0.25, 0.75 }, matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 0, 9 }));
+    EXPECT_THROW(matcher.erase(1), std::invalid_argument);
+
+    matcher.insert(1, xcsr::Condition(std::vector<xcsr::Symbol>({ { 0.5, 1.0 }, { 0.0, 1.0 } })), repr);
+    matcher.match({ 0.25, 0.75 }, matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 0, 9 }));
+    matcher.match({ 0.75, 0.75 }, matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 1, 9 }));
+
+    EXPECT_THROW(matcher.insert(2, xcsr::Condition(std::vector<xcsr::Symbol>({ { 0.0, 1.0 } })), repr), std::invalid_argument);
+    EXPECT_THROW(matcher.match({ 0.5 }, matchedColumns), std::invalid_argument);
+
+    matcher.clear();
+    EXPECT_TRUE(matcher.empty());
+    matcher.match({ 0.25, 0.75 }, matchedColumns);
+    EXPECT_TRUE(matchedColumns.empty());
+}
+
+TEST(XCSR_IntervalMatcherTest, ReducedPrecisionKeepsAllMatches)
+{
+    std::mt19937 engine(2);
+    for (const auto precision : { xcsr::XCSRPrecision::kFloat, xcsr::XCSRPrecision::kUInt16 })
+    {
+        for (const auto repr : { xcsr::XCSRRepr::kCSR, xcsr::XCSRRepr::kOBR })
+        {
+            const std::size_t length = 3;
+            xcsr::IntervalMatcher matcher(precision, 0.0, 1.0);
+            std::vector<xcsr::Condition> conditions;
+            for (std::size_t i = 0; i < 203; ++i)
+            {
+                conditions.push_back(RandomCondition(length, repr, 0.9, engine));
+                matcher.insert(i, conditions.back(), repr);
+            }
+
+            // Random situations and the bounds of the conditions themselves
+            std::vector<std::vector<double>> situations;
+            for (int t = 0; t < 50; ++t)
+            {
+                situations.push_back(RandomSituation(length, engine));
+            }
+            for (const auto & condition : conditions)
+            {
+                situations.push_back({ xcsr::GetLowerBound(condition[0], repr), 0.5, 0.5 });
+                situations.push_back({ 0.5, xcsr::GetUpperBound(condition[1], repr), 0.5 });
+            }
+
+            std::vector<std::size_t> matchedColumns;
+            for (const auto & situation : situations)
+            {
+                matcher.match(situation, matchedColumns);
+                EXPECT_TRUE(std::is_sorted(matchedColumns.begin(), matchedColumns.end()));
+                for (std::size_t i = 0; i < conditions.size(); ++i)
+                {
+                    if (conditions[i].matches(situation, repr))
+                    {
+                        EXPECT_TRUE(std::binary_search(matchedColumns.begin(), matchedColumns.end(), i));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(XCSR_IntervalMatcherTest, QuantizedCoveringContainsInput)
+{
+    Random random(4);
+    std::mt19937 engine(3);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    for (const auto repr : { xcsr::XCSRRepr::kCSR, xcsr::XCSRRepr::kOBR, xcsr::XCSRRepr::kUBR })
+    {
+        xcsr::XCSRParams params;
+        params.repr = repr;
+        params.precision = xcsr::XCSRPrecision::kUInt16;
+        params.s0 = 0.001;
+        for (int t = 0; t < 1000; ++t)
+        {
+            const double x = dist(engine);
+            const auto symbol = xcsr::MakeCoveringSymbol(x, &params, random);
+            EXPECT_LE(xcsr::GetLowerBound(symbol, repr), x);
+            EXPECT_GT(xcsr::GetUpperBound(symbol, repr), x);
+
+            // On the grid of 65536 levels
+            const double v1Level = symbol.v1 * 65535.0;
+            const double v2Level = symbol.v2 * 65535.0;
+            EXPECT_NEAR(v1Level, std::round(v1Level), 1e-6);
+            EXPECT_NEAR(v2Level, std::round(v2Level), 1e-6);
+        }
+    }
+}
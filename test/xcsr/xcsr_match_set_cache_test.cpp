@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include "xcsr_test_helper.hpp"
+
+using namespace xcspp;
+
+namespace
+{
+    std::vector<std::size_t> CachedMatchedIndices(xcsr::MatchSetCache & cache, const xcsr::Population & population, const std::vector<double> & situation)
+    {
+        std::vector<std::size_t> matchedIndices;
+        cache.match(population, situation, matchedIndices);
+        return matchedIndices;
+    }
+}
+
+TEST(XCSR_MatchSetCacheTest, RepairAfterModification)
+{
+    // CSR (center, spread)
+    const xcsr::Symbol low(0.25, 0.25);
+    const xcsr::Symbol high(0.75, 0.25);
+    const xcsr::Symbol dontCare(0.5, 0.5);
+
+    xcsr::XCSRParams params;
+    params.matchSetCacheSize = 1 << 20;
+    xcsr::Population population({ MakeClassifier({ low, dontCare }, 0), MakeClassifier({ dontCare, high }, 1) }, &params, { 0, 1 });
+    xcsr::MatchSetCache cache(&params);
+
+    EXPECT_EQ(CachedMatchedIndices(cache, population, { 0.1, 0.9 }), std::vector<std::size_t>({ 0, 1 }));
+    EXPECT_EQ(CachedMatchedIndices(cache, population, { 0.1, 0.9 }), std::vector<std::size_t>({ 0, 1 }));
+    EXPECT_EQ(cache.hitCount(), 1);
+    EXPECT_EQ(cache.missCount(), 1);
+
+    population.erase(0);
+    population.insert(MakeClassifier({ high, high }, 0));
+    population.insert(MakeClassifier({ low, high }, 1));
+    EXPECT_EQ(CachedMatchedIndices(cache, population, { 0.1, 0.9 }), std::vector<std::size_t>({ 1, 2 }));
+
+    // 0.0 and -0.0 are the same situation
+    EXPECT_EQ(CachedMatchedIndices(cache, population, { 0.0, 0.9 }), std::vector<std::size_t>({ 1, 2 }));
+    EXPECT_EQ(CachedMatchedIndices(cache, population, { -0.0, 0.9 }), std::vector<std::size_t>({ 1, 2 }));
+    EXPECT_EQ(cache.hitCount(), 3);
+    EXPECT_EQ(cache.missCount(), 2);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <xcspp/xcspp.hpp>
+#include "xcsr_test_helper.hpp"
+#include <random>
+
+using namespace xcspp;
+
+TEST(XCSR_SpatialMatchIndexTest, MatchesSameAsConditionUnderChanges)
+{
+    std::mt19937 engine(1);
+    for (const auto repr : { xcsr::XCSRRepr::kCSR, xcsr::XCSRRepr::kOBR, xcsr::XCSRRepr::kUBR })
+    {
+        for (const std::size_t length : { 1, 2, 5 })
+        {
+            constexpr std::size_t kColumnCount = 1000;
+            xcsr::SpatialMatchIndex index;
+            std::vector<xcsr::Condition> conditions(kColumnCount);
+            std::vector<bool> isUsed(kColumnCount, false);
+            std::uniform_int_distribution<std::size_t> columnDist(0, kColumnCount - 1);
+
+            std::vector<std::size_t> matchedColumns;
+            for (int t = 0; t < 6000; ++t)
+            {
+                // Insert into or erase a random column
+                const std::size_t column = columnDist(engine);
+                if (isUsed[column])
+                {
+                    index.erase(column);
+                }
+                else
+                {
+                    conditions[column] = RandomCondition(length, repr, 0.0, engine);
+                    index.insert(column, conditions[column], repr);
+                }
+                isUsed[column] = !isUsed[column];
+
+                if (t % 50 == 0)
+                {
+                    const auto situation = RandomSituation(length, engine);
+                    index.match(situation, matchedColumns);
+
+                    std::vector<std::size_t> expected;
+                    for (std::size_t i = 0; i < kColumnCount; ++i)
+                    {
+                        if (isUsed[i] && conditions[i].matches(situation, repr))
+                        {
+                            expected.push_back(i);
+                        }
+                    }
+                    EXPECT_EQ(matchedColumns, expected);
+                }
+            }
+
+            // The tree of about 500 columns keeps the height of a balanced tree
+            EXPECT_LE(index.height(), 5);
+        }
+    }
+}
+
+TEST(XCSR_SpatialMatchIndexTest, EraseAll)
+{
+    std::mt19937 engine(2);
+    xcsr::SpatialMatchIndex index;
+    for (std::size_t i = 0; i < 300; ++i)
+    {
+        index.insert(i, RandomCondition(2, xcsr::XCSRRepr::kOBR, 0.0, engine), xcsr::XCSRRepr::kOBR);
+    }
+    EXPECT_EQ(index.size(), 300);
+    EXPECT_GE(index.height(), 2);
+    EXPECT_THROW(index.insert(5, RandomCondition(2, xcsr::XCSRRepr::kOBR, 0.0, engine), xcsr::XCSRRepr::kOBR), std::invalid_argument);
+
+    for (std::size_t i = 0; i < 300; ++i)
+    {
+        index.erase(i);
+    }
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.height(), 0);
+    EXPECT_THROW(index.erase(0), std::invalid_argument);
+
+    std::vector<std::size_t> matchedColumns;
+    index.match({ 0.5, 0.5 }, matchedColumns);
+    EXPECT_TRUE(matchedColumns.empty());
+
+    // A condition with another length can be inserted after the index becomes empty
+    index.insert(7, xcsr::Condition(std::vector<xcsr::Symbol>({ { 0.0, 0.5 } })), xcsr::XCSRRepr::kOBR);
+    index.match({ 0.25 }, matchedColumns);
+    EXPECT_EQ(matchedColumns, std::vector<std::size_t>({ 7 }));
+    index.match({ 0.5 }, matchedColumns);
+    EXPECT_TRUE(matchedColumns.empty());
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <random>
+#include <vector>
+#include <xcspp/xcspp.hpp>
+
+// Helpers shared by the XCSR tests
+
+// Classifier with the given symbols and action (the other parameters are the initial values used in the tests)
+inline xcspp::xcsr::Classifier MakeClassifier(const std::vector<xcspp::xcsr::Symbol> & symbols, int action, double prediction = 10.0, double fitness = 0.01)
+{
+    return xcspp::xcsr::Classifier(xcspp::xcsr::Condition(symbols), action, prediction, 0.0, fitness, 0);
+}
+
+// Returns a condition of random intervals in the representation
+//   Each bound is outside the input range [0, 1) with the given probability, so that the intervals
+//   cover the whole range at most positions if the probability is high. (UBR symbols have their
+//   bounds in either order.)
+inline xcspp::xcsr::Condition RandomCondition(std::size_t length, xcspp::xcsr::XCSRRepr repr, double generalProbability, std::mt19937 & engine)
+{
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::bernoulli_distribution generalDist(generalProbability);
+    std::bernoulli_distribution swapDist(0.5);
+    std::vector<xcspp::xcsr::Symbol> symbols;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        const double lower = generalDist(engine) ? -0.1 : dist(engine) * 0.8;
+        const double upper = generalDist(engine) ? 1.1 : lower + dist(engine) * 0.5;
+        switch (repr)
+        {
+        case xcspp::xcsr::XCSRRepr::kCSR:
+            symbols.emplace_back((lower + upper) / 2, (upper - lower) / 2);
+            break;
+
+        case xcspp::xcsr::XCSRRepr::kOBR:
+            symbols.emplace_back(lower, upper);
+            break;
+
+        case xcspp::xcsr::XCSRRepr::kUBR:
+            symbols.push_back(swapDist(engine) ? xcspp::xcsr::Symbol(upper, lower) : xcspp::xcsr::Symbol(lower, upper));
+            break;
+        }
+    }
+    return xcspp::xcsr::Condition(symbols);
+}
+
+inline std::vector<double> RandomSituation(std::size_t length, std::mt19937 & engine)
+{
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<double> situation;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        situation.push_back(dist(engine));
+    }
+    return situation;
+}
@@ -92,4 +92,21 @@ namespace xcspp::tool
         }
     }
 
+    std::optional<std::uint64_t> DeriveEnvironmentSeed(const std::optional<std::uint64_t> & seed, std::uint64_t stream)
+    {
+        if (!seed.has_value())
+        {
+            return std::nullopt;
+        }
+
+        // The stream-th output of SplitMix64 from the seed
+        std::uint64_t state = *seed;
+        std::uint64_t derivedSeed = 0;
+        for (std::uint64_t i = 0; i < stream; ++i)
+        {
+            derivedSeed = RandomEngineDetail::SplitMix64(state);
+        }
+        return derivedSeed;
+    }
+
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include <optional>
 #include <cstdint> // std::uint64_t
 #include <cxxopts.hpp>
 #include <xcspp/xcspp.hpp>
@@ -14,4 +15,8 @@ namespace xcspp::tool
 
     void RunExperiment(IExperimentHelper & experimentHelper, std::uint64_t iterationCount, std::uint64_t condensationIterationCount);
 
+    // Returns the seed of an environment derived from the seed of the system (std::nullopt if the seed is not specified)
+    //   Each stream (e.g., 1 for the training environment and 2 for the test environment) gets a different seed.
+    std::optional<std::uint64_t> DeriveEnvironmentSeed(const std::optional<std::uint64_t> & seed, std::uint64_t stream);
+
 }
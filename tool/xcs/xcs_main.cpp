@@ -31,6 +31,10 @@ int main(int argc, char *argv[])
     const XCSParams params = tool::xcs::ParseXCSParams(parsedOptions);
     tool::xcs::OutputXCSParams(params);
 
+    // Seeds of the training and test environments (derived from the seed of XCS, so that a seeded run is reproducible)
+    const auto trainEnvSeed = tool::DeriveEnvironmentSeed(params.seed, 1);
+    const auto testEnvSeed = tool::DeriveEnvironmentSeed(params.seed, 2);
+
     // Initialize experiment helper
     const ExperimentSettings settings = tool::ParseExperimentSettings(parsedOptions);
     ExperimentHelper experimentHelper(settings);
@@ -38,8 +42,8 @@ int main(int argc, char *argv[])
     if (parsedOptions.count("mux"))
     {
         // Multiplexer problem
-        const auto & env = experimentHelper.constructTrainEnv<MultiplexerEnvironment>(parsedOptions["mux"].as<int>(), parsedOptions["mux-i"].as<unsigned int>());
-        experimentHelper.constructTestEnv<MultiplexerEnvironment>(parsedOptions["mux"].as<int>());
+        const auto & env = experimentHelper.constructTrainEnv<MultiplexerEnvironment>(parsedOptions["mux"].as<int>(), parsedOptions["mux-i"].as<unsigned int>(), trainEnvSeed);
+        experimentHelper.constructTestEnv<MultiplexerEnvironment>(parsedOptions["mux"].as<int>(), 0, testEnvSeed);
 
         experimentHelper.constructSystem<XCS>(env.availableActions(), params);
 
@@ -48,8 +52,8 @@ int main(int argc, char *argv[])
     else if (parsedOptions.count("parity"))
     {
         // Even-parity problem
-        const auto & env = experimentHelper.constructTrainEnv<EvenParityEnvironment>(parsedOptions["parity"].as<int>());
-        experimentHelper.constructTestEnv<EvenParityEnvironment>(parsedOptions["parity"].as<int>());
+        const auto & env = experimentHelper.constructTrainEnv<EvenParityEnvironment>(parsedOptions["parity"].as<int>(), trainEnvSeed);
+        experimentHelper.constructTestEnv<EvenParityEnvironment>(parsedOptions["parity"].as<int>(), testEnvSeed);
 
         experimentHelper.constructSystem<XCS>(env.availableActions(), params);
 
@@ -58,8 +62,8 @@ int main(int argc, char *argv[])
     else if (parsedOptions.count("majority"))
     {
         // Majority-on problem
-        const auto & env = experimentHelper.constructTrainEnv<MajorityOnEnvironment>(parsedOptions["majority"].as<int>());
-        experimentHelper.constructTestEnv<MajorityOnEnvironment>(parsedOptions["majority"].as<int>());
+        const auto & env = experimentHelper.constructTrainEnv<MajorityOnEnvironment>(parsedOptions["majority"].as<int>(), trainEnvSeed);
+        experimentHelper.constructTestEnv<MajorityOnEnvironment>(parsedOptions["majority"].as<int>(), testEnvSeed);
 
         experimentHelper.constructSystem<XCS>(env.availableActions(), params);
 
@@ -68,8 +72,8 @@ int main(int argc, char *argv[])
     else if (parsedOptions.count("blc"))
     {
         // Block world problem
-        const auto & trainEnv = experimentHelper.constructTrainEnv<BlockWorldEnvironment>(parsedOptions["blc"].as<std::string>(), parsedOptions["max-step"].as<uint64_t>(), parsedOptions["blc-3bit"].as<bool>(), parsedOptions["blc-diag"].as<bool>());
-        const auto & testEnv = experimentHelper.constructTestEnv<BlockWorldEnvironment>(parsedOptions["blc"].as<std::string>(), parsedOptions["max-step"].as<uint64_t>(), parsedOptions["blc-3bit"].as<bool>(), parsedOptions["blc-diag"].as<bool>());
+        const auto & trainEnv = experimentHelper.constructTrainEnv<BlockWorldEnvironment>(parsedOptions["blc"].as<std::string>(), parsedOptions["max-step"].as<uint64_t>(), parsedOptions["blc-3bit"].as<bool>(), parsedOptions["blc-diag"].as<bool>(), trainEnvSeed);
+        const auto & testEnv = experimentHelper.constructTestEnv<BlockWorldEnvironment>(parsedOptions["blc"].as<std::string>(), parsedOptions["max-step"].as<uint64_t>(), parsedOptions["blc-3bit"].as<bool>(), parsedOptions["blc-diag"].as<bool>(), testEnvSeed);
 
         auto & xcs = experimentHelper.constructSystem<XCS>(trainEnv.availableActions(), params);
 
@@ -212,8 +216,8 @@ int main(int argc, char *argv[])
         const std::string trainFilename = parsedOptions["csv"].as<std::string>();
         const std::string testFilename = parsedOptions.count("csv-test") ? parsedOptions["csv-test"].as<std::string>() : trainFilename;
 
-        const auto & env = experimentHelper.constructTrainEnv<DatasetEnvironment>(CSV::ReadDatasetFromFile<int>(trainFilename), parsedOptions["csv-random"].as<bool>());
-        experimentHelper.constructTestEnv<DatasetEnvironment>(CSV::ReadDatasetFromFile<int>(testFilename), parsedOptions["csv-random"].as<bool>());
+        const auto & env = experimentHelper.constructTrainEnv<DatasetEnvironment>(CSV::ReadDatasetFromFile<int>(trainFilename), parsedOptions["csv-random"].as<bool>(), trainEnvSeed);
+        experimentHelper.constructTestEnv<DatasetEnvironment>(CSV::ReadDatasetFromFile<int>(testFilename), parsedOptions["csv-random"].as<bool>(), testEnvSeed);
 
         experimentHelper.constructSystem<XCS>(env.availableActions(), params);
 
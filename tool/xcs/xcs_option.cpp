@@ -56,7 +56,15 @@ namespace xcspp::tool::xcs
             ("do-ga-subsumption", "Whether offspring are to be tested for possible logical subsumption by parents", cxxopts::value<bool>()->default_value(defaultParams.doGASubsumption ? "true" : "false"), "true/false")
             ("do-as-subsumption", "Whether action sets are to be tested for subsuming classifiers", cxxopts::value<bool>()->default_value(defaultParams.doActionSetSubsumption ? "true" : "false"), "true/false")
             ("do-action-mutation", "Whether to apply mutation to the action", cxxopts::value<bool>()->default_value(defaultParams.doActionMutation ? "true" : "false"), "true/false")
-            ("mam", "Whether to use the moyenne adaptive modifee (MAM) for updating the prediction and the prediction error of classifiers", cxxopts::value<bool>()->default_value(defaultParams.useMAM ? "true" : "false"), "true/false");
+            ("mam", "Whether to use the moyenne adaptive modifee (MAM) for updating the prediction and the prediction error of classifiers", cxxopts::value<bool>()->default_value(defaultParams.useMAM ? "true" : "false"), "true/false")
+            ("matching", "The data structure to find the classifiers matching the situation (\"inverted-index\" is faster when most conditions are specific)", cxxopts::value<std::string>()->default_value("bit-sliced"), "bit-sliced/inverted-index")
+            ("match-set-cache", "The memory limit in bytes of the cache of the classifiers matching each situation (set \"0\" to disable the cache)", cxxopts::value<std::uint64_t>()->default_value(std::to_string(defaultParams.matchSetCacheSize)), "BYTES")
+            ("population-chunk", "The number of slots of the population allocated at once (set \"0\" to grow the capacity geometrically)", cxxopts::value<std::uint64_t>()->default_value(std::to_string(defaultParams.populationChunkSize)), "SLOTS")
+            ("huge-pages", "Whether to back the population arrays with transparent huge pages (Linux only)", cxxopts::value<bool>()->default_value(defaultParams.useHugePages ? "true" : "false"), "true/false")
+            ("preallocate", "Whether to allocate the population and the working buffers for N + max(2, the number of actions) classifiers in advance", cxxopts::value<bool>()->default_value(defaultParams.preallocate ? "true" : "false"), "true/false")
+            ("partition-by-action", "Whether to group the match set by action to make the action set and the prediction array", cxxopts::value<bool>()->default_value(defaultParams.partitionByAction ? "true" : "false"), "true/false")
+            ("rng", "The pseudo-random number engine", cxxopts::value<std::string>()->default_value("mt19937"), "mt19937/xoshiro256pp/pcg64")
+            ("seed", "The seed of the pseudo-random number engines of the system and the environments (nondeterministic seeds are used if not specified)", cxxopts::value<std::uint64_t>(), "SEED");
     }
 
     void AddOptions(cxxopts::Options & options)
@@ -94,6 +102,15 @@ namespace xcspp::tool::xcs
         params.doActionSetSubsumption = parsedOptions["do-as-subsumption"].as<bool>();
         params.doActionMutation = parsedOptions["do-action-mutation"].as<bool>();
         params.useMAM = parsedOptions["mam"].as<bool>();
+        params.matchSetCacheSize = static_cast<std::size_t>(parsedOptions["match-set-cache"].as<std::uint64_t>());
+        params.populationChunkSize = static_cast<std::size_t>(parsedOptions["population-chunk"].as<std::uint64_t>());
+        params.useHugePages = parsedOptions["huge-pages"].as<bool>();
+        params.preallocate = parsedOptions["preallocate"].as<bool>();
+        params.partitionByAction = parsedOptions["partition-by-action"].as<bool>();
+        if (parsedOptions.count("seed"))
+        {
+            params.seed = parsedOptions["seed"].as<std::uint64_t>();
+        }
 
         // Determine crossover method
         if (parsedOptions["x-method"].as<std::string>() == "uniform")
@@ -114,6 +131,40 @@ namespace xcspp::tool::xcs
             std::exit(1);
         }
 
+        // Determine matching method
+        if (parsedOptions["matching"].as<std::string>() == "bit-sliced")
+        {
+            params.matchingMethod = XCSParams::MatchingMethod::kBitSliced;
+        }
+        else if (parsedOptions["matching"].as<std::string>() == "inverted-index")
+        {
+            params.matchingMethod = XCSParams::MatchingMethod::kInvertedIndex;
+        }
+        else
+        {
+            std::cerr << "Error: Unknown value for --matching (" << parsedOptions["matching"].as<std::string>() << ")" << std::endl;
+            std::exit(1);
+        }
+
+        // Determine pseudo-random number engine
+        if (parsedOptions["rng"].as<std::string>() == "mt19937")
+        {
+            params.randomEngine = RandomEngineType::kMT19937;
+        }
+        else if (parsedOptions["rng"].as<std::string>() == "xoshiro256pp")
+        {
+            params.randomEngine = RandomEngineType::kXoshiro256PlusPlus;
+        }
+        else if (parsedOptions["rng"].as<std::string>() == "pcg64")
+        {
+            params.randomEngine = RandomEngineType::kPCG64;
+        }
+        else
+        {
+            std::cerr << "Error: Unknown value for --rng (" << parsedOptions["rng"].as<std::string>() << ")" << std::endl;
+            std::exit(1);
+        }
+
         return params;
     }
 
@@ -166,6 +217,24 @@ namespace xcspp::tool::xcs
             ss << "doActionMutation = false\n";
         if (!params.useMAM)
             ss << "             MAM = false\n";
+        if (params.matchingMethod == XCSParams::MatchingMethod::kInvertedIndex)
+            ss << "        matching = inverted-index\n";
+        if (params.matchSetCacheSize > 0)
+            ss << "   matchSetCache = " << params.matchSetCacheSize << " bytes\n";
+        if (params.populationChunkSize > 0)
+            ss << " populationChunk = " << params.populationChunkSize << " slots\n";
+        if (params.useHugePages)
+            ss << "       hugePages = true\n";
+        if (params.preallocate)
+            ss << "     preallocate = true\n";
+        if (params.partitionByAction)
+            ss << "partitionByAction = true\n";
+        if (params.randomEngine == RandomEngineType::kXoshiro256PlusPlus)
+            ss << "    randomEngine = xoshiro256pp\n";
+        else if (params.randomEngine == RandomEngineType::kPCG64)
+            ss << "    randomEngine = pcg64\n";
+        if (params.seed.has_value())
+            ss << "            seed = " << *params.seed << '\n';
         const std::string str = ss.str();
         if (!str.empty())
         {
@@ -31,6 +31,10 @@ int main(int argc, char *argv[])
     const XCSRParams params = tool::xcsr::ParseXCSRParams(parsedOptions);
     tool::xcsr::OutputXCSRParams(params);
 
+    // Seeds of the training and test environments (derived from the seed of XCSR, so that a seeded run is reproducible)
+    const auto trainEnvSeed = tool::DeriveEnvironmentSeed(params.seed, 1);
+    const auto testEnvSeed = tool::DeriveEnvironmentSeed(params.seed, 2);
+
     // Initialize experiment helper
     const ExperimentSettings settings = tool::ParseExperimentSettings(parsedOptions);
     RealExperimentHelper experimentHelper(settings);
@@ -38,8 +42,8 @@ int main(int argc, char *argv[])
     if (parsedOptions.count("rmux"))
     {
         // Real multiplexer problem
-        const auto & env = experimentHelper.constructTrainEnv<RealMultiplexerEnvironment>(parsedOptions["rmux"].as<int>(), parsedOptions["rmux-i"].as<unsigned int>());
-        experimentHelper.constructTestEnv<RealMultiplexerEnvironment>(parsedOptions["rmux"].as<int>());
+        const auto & env = experimentHelper.constructTrainEnv<RealMultiplexerEnvironment>(parsedOptions["rmux"].as<int>(), parsedOptions["rmux-i"].as<unsigned int>(), 0.5, trainEnvSeed);
+        experimentHelper.constructTestEnv<RealMultiplexerEnvironment>(parsedOptions["rmux"].as<int>(), 0, 0.5, testEnvSeed);
 
         experimentHelper.constructSystem<XCSR>(env.availableActions(), params);
 
@@ -51,8 +55,8 @@ int main(int argc, char *argv[])
         const std::string trainFilename = parsedOptions["csv"].as<std::string>();
         const std::string testFilename = parsedOptions.count("csv-test") ? parsedOptions["csv-test"].as<std::string>() : trainFilename;
 
-        const auto & env = experimentHelper.constructTrainEnv<RealDatasetEnvironment>(CSV::ReadDatasetFromFile<double>(trainFilename), parsedOptions["csv-random"].as<bool>());
-        experimentHelper.constructTestEnv<RealDatasetEnvironment>(CSV::ReadDatasetFromFile<double>(testFilename), parsedOptions["csv-random"].as<bool>());
+        const auto & env = experimentHelper.constructTrainEnv<RealDatasetEnvironment>(CSV::ReadDatasetFromFile<double>(trainFilename), parsedOptions["csv-random"].as<bool>(), trainEnvSeed);
+        experimentHelper.constructTestEnv<RealDatasetEnvironment>(CSV::ReadDatasetFromFile<double>(testFilename), parsedOptions["csv-random"].as<bool>(), testEnvSeed);
 
         experimentHelper.constructSystem<XCSR>(env.availableActions(), params);
 
@@ -26,6 +26,7 @@ namespace xcspp::tool::xcsr
         const XCSRParams defaultParams;
         options.add_options("XCSR parameter")
             ("repr", "The XCSR representation (Center-Spread: 'csr' / Lower-Upper [Ordered Bound]: 'obr' / Unordered Bound: 'ubr')", cxxopts::value<std::string>()->default_value("csr"), "csr/obr/ubr")
+            ("precision", "The precision of the symbol values of the conditions (\"float\" and \"uint16\" round the values in the covering and mutation operator, and \"uint16\" uses 65536 levels over [min-value, max-value])", cxxopts::value<std::string>()->default_value("double"), "double/float/uint16")
             ("N,max-population", "The maximum size of the population", cxxopts::value<std::uint64_t>()->default_value(std::to_string(defaultParams.n)), "SIZE")
             ("s-0", "The maximum value of a spread in the covering operator", cxxopts::value<double>()->default_value(std::to_string(defaultParams.s0)), "S_0")
             ("max-mutation", "The maximum change of a spread value or a center value in mutation", cxxopts::value<double>()->default_value(std::to_string(defaultParams.m)), "M")
@@ -54,7 +55,15 @@ namespace xcspp::tool::xcsr
             ("do-action-mutation", "Whether to apply mutation to the action", cxxopts::value<bool>()->default_value(defaultParams.doActionMutation ? "true" : "false"), "true/false")
             ("do-range-restriction", "Whether to restrict the range of the condition to the interval [min-value, max-value) in the covering and mutation operator (ignored when --repr=csr)", cxxopts::value<bool>()->default_value(defaultParams.doRangeRestriction ? "true" : "false"), "true/false")
             ("do-covering-random-range-truncation", "Whether to truncate the covering random range before generating random intervals if the interval [x-s_0, x+s_0) is not contained in [min-value, max-value).  \"false\" is common for this option, but the covering operator can generate too many maximum-range intervals if s_0 is larger than (max-value - min-value) / 2.  Choose \"true\" to avoid the random bias in this situation.  (ignored when --repr=csr)", cxxopts::value<bool>()->default_value(defaultParams.doCoveringRandomRangeTruncation ? "true" : "false"), "true/false")
-            ("mam", "Whether to use the moyenne adaptive modifee (MAM) for updating the prediction and the prediction error of classifiers", cxxopts::value<bool>()->default_value(defaultParams.useMAM ? "true" : "false"), "true/false");
+            ("mam", "Whether to use the moyenne adaptive modifee (MAM) for updating the prediction and the prediction error of classifiers", cxxopts::value<bool>()->default_value(defaultParams.useMAM ? "true" : "false"), "true/false")
+            ("matching", "The data structure to find the classifiers matching the situation (\"spatial-index\" is faster in low dimensions when most conditions are specific, and \"auto\" uses it only below the crossover with the scan)", cxxopts::value<std::string>()->default_value("scan"), "scan/spatial-index/auto")
+            ("match-set-cache", "The memory limit in bytes of the cache of the classifiers matching each situation (set \"0\" to disable the cache)", cxxopts::value<std::uint64_t>()->default_value(std::to_string(defaultParams.matchSetCacheSize)), "BYTES")
+            ("population-chunk", "The number of slots of the population allocated at once (set \"0\" to grow the capacity geometrically)", cxxopts::value<std::uint64_t>()->default_value(std::to_string(defaultParams.populationChunkSize)), "SLOTS")
+            ("huge-pages", "Whether to back the population arrays with transparent huge pages (Linux only)", cxxopts::value<bool>()->default_value(defaultParams.useHugePages ? "true" : "false"), "true/false")
+            ("preallocate", "Whether to allocate the population and the working buffers for N + max(2, the number of actions) classifiers in advance", cxxopts::value<bool>()->default_value(defaultParams.preallocate ? "true" : "false"), "true/false")
+            ("partition-by-action", "Whether to group the match set by action to make the action set and the prediction array", cxxopts::value<bool>()->default_value(defaultParams.partitionByAction ? "true" : "false"), "true/false")
+            ("rng", "The pseudo-random number engine", cxxopts::value<std::string>()->default_value("mt19937"), "mt19937/xoshiro256pp/pcg64")
+            ("seed", "The seed of the pseudo-random number engines of the system and the environments (nondeterministic seeds are used if not specified)", cxxopts::value<std::uint64_t>(), "SEED");
     }
 
     void AddOptions(cxxopts::Options & options)
@@ -97,6 +106,15 @@ namespace xcspp::tool::xcsr
         params.doRangeRestriction = parsedOptions["do-range-restriction"].as<bool>();
         params.doCoveringRandomRangeTruncation = parsedOptions["do-covering-random-range-truncation"].as<bool>();
         params.useMAM = parsedOptions["mam"].as<bool>();
+        params.matchSetCacheSize = static_cast<std::size_t>(parsedOptions["match-set-cache"].as<std::uint64_t>());
+        params.populationChunkSize = static_cast<std::size_t>(parsedOptions["population-chunk"].as<std::uint64_t>());
+        params.useHugePages = parsedOptions["huge-pages"].as<bool>();
+        params.preallocate = parsedOptions["preallocate"].as<bool>();
+        params.partitionByAction = parsedOptions["partition-by-action"].as<bool>();
+        if (parsedOptions.count("seed"))
+        {
+            params.seed = parsedOptions["seed"].as<std::uint64_t>();
+        }
 
         const std::string reprStr = parsedOptions["repr"].as<std::string>();
         if (reprStr == "csr")
@@ -117,6 +135,25 @@ namespace xcspp::tool::xcsr
             std::exit(1);
         }
 
+        const std::string precisionStr = parsedOptions["precision"].as<std::string>();
+        if (precisionStr == "double")
+        {
+            params.precision = XCSRPrecision::kDouble;
+        }
+        else if (precisionStr == "float")
+        {
+            params.precision = XCSRPrecision::kFloat;
+        }
+        else if (precisionStr == "uint16")
+        {
+            params.precision = XCSRPrecision::kUInt16;
+        }
+        else
+        {
+            std::cerr << "Error: Unknown value for --precision (" << precisionStr << ")" << std::endl;
+            std::exit(1);
+        }
+
         // Determine crossover method
         if (parsedOptions["x-method"].as<std::string>() == "uniform")
         {
@@ -136,6 +173,44 @@ namespace xcspp::tool::xcsr
             std::exit(1);
         }
 
+        // Determine matching method
+        if (parsedOptions["matching"].as<std::string>() == "scan")
+        {
+            params.matchingMethod = XCSRParams::MatchingMethod::kScan;
+        }
+        else if (parsedOptions["matching"].as<std::string>() == "spatial-index")
+        {
+            params.matchingMethod = XCSRParams::MatchingMethod::kSpatialIndex;
+        }
+        else if (parsedOptions["matching"].as<std::string>() == "auto")
+        {
+            params.matchingMethod = XCSRParams::MatchingMethod::kAuto;
+        }
+        else
+        {
+            std::cerr << "Error: Unknown value for --matching (" << parsedOptions["matching"].as<std::string>() << ")" << std::endl;
+            std::exit(1);
+        }
+
+        // Determine pseudo-random number engine
+        if (parsedOptions["rng"].as<std::string>() == "mt19937")
+        {
+            params.randomEngine = RandomEngineType::kMT19937;
+        }
+        else if (parsedOptions["rng"].as<std::string>() == "xoshiro256pp")
+        {
+            params.randomEngine = RandomEngineType::kXoshiro256PlusPlus;
+        }
+        else if (parsedOptions["rng"].as<std::string>() == "pcg64")
+        {
+            params.randomEngine = RandomEngineType::kPCG64;
+        }
+        else
+        {
+            std::cerr << "Error: Unknown value for --rng (" << parsedOptions["rng"].as<std::string>() << ")" << std::endl;
+            std::exit(1);
+        }
+
         return params;
     }
 
@@ -205,6 +280,30 @@ namespace xcspp::tool::xcsr
             ss << "doActionMutation = false\n";
         if (!params.useMAM)
             ss << "             MAM = false\n";
+        if (params.precision == XCSRPrecision::kFloat)
+            ss << "       precision = float\n";
+        else if (params.precision == XCSRPrecision::kUInt16)
+            ss << "       precision = uint16\n";
+        if (params.matchingMethod == XCSRParams::MatchingMethod::kSpatialIndex)
+            ss << "        matching = spatial-index\n";
+        else if (params.matchingMethod == XCSRParams::MatchingMethod::kAuto)
+            ss << "        matching = auto\n";
+        if (params.matchSetCacheSize > 0)
+            ss << "   matchSetCache = " << params.matchSetCacheSize << " bytes\n";
+        if (params.populationChunkSize > 0)
+            ss << " populationChunk = " << params.populationChunkSize << " slots\n";
+        if (params.useHugePages)
+            ss << "       hugePages = true\n";
+        if (params.preallocate)
+            ss << "     preallocate = true\n";
+        if (params.partitionByAction)
+            ss << "partitionByAction = true\n";
+        if (params.randomEngine == RandomEngineType::kXoshiro256PlusPlus)
+            ss << "    randomEngine = xoshiro256pp\n";
+        else if (params.randomEngine == RandomEngineType::kPCG64)
+            ss << "    randomEngine = pcg64\n";
+        if (params.seed.has_value())
+            ss << "            seed = " << *params.seed << '\n';
         const std::string str = ss.str();
         if (!str.empty())
         {